@@ -147,6 +147,11 @@ attrd_add_value_xml(xmlNode *parent, const attribute_t *a,
         crm_xml_add_int(xml, PCMK__XA_ATTR_IS_REMOTE, 1);
     }
     crm_xml_add(xml, PCMK__XA_ATTR_VALUE, v->current);
+    if (v->sync_origin != NULL) {
+        // Delta sync bookkeeping for the broadcast that set this value
+        crm_xml_add(xml, PCMK__XA_ATTR_SYNC_ORIGIN, v->sync_origin);
+        crm_xml_add_ll(xml, PCMK__XA_ATTR_SYNC_SEQ, (long long) v->sync_seq);
+    }
     crm_xml_add_int(xml, PCMK__XA_ATTR_DAMPENING, a->timeout_ms / 1000);
     crm_xml_add_int(xml, PCMK__XA_ATTR_IS_PRIVATE,
                     pcmk_is_set(a->flags, attrd_attr_is_private));
@@ -16,6 +16,7 @@
 #include <glib.h>
 
 #include <crm/cib/internal.h>       // cib__*
+#include <crm/common/cib_internal.h>    // pcmk__cib_abs_xpath_for()
 #include <crm/common/logging.h>
 #include <crm/common/results.h>
 #include <crm/common/strings_internal.h>
@@ -26,8 +27,6 @@
 
 static int last_cib_op_done = 0;
 
-static void write_attribute(attribute_t *a, bool ignore_delay);
-
 static void
 attrd_cib_destroy_cb(gpointer user_data)
 {
@@ -237,23 +236,54 @@ attribute_timer_cb(gpointer data)
     return FALSE;
 }
 
+/* How long to wait for further attributes to become due before flushing all of
+ * them to the CIB. Correlated updates (an application setting many attributes
+ * together, or a burst of dampening timers expiring at once) are thereby
+ * written as a single patchset instead of one CIB update per attribute.
+ */
+#define WRITE_COALESCE_MS 100
+
+static mainloop_timer_t *write_flush_timer = NULL;
+
+static gboolean
+write_flush_cb(gpointer data)
+{
+    if (attrd_election_won()) {
+        attrd_write_attributes(attrd_write_changed);
+    }
+    return FALSE;
+}
+
+/*!
+ * \internal
+ * \brief Schedule a coalesced write of all changed attributes
+ */
 static void
-attrd_cib_callback(xmlNode *msg, int call_id, int rc, xmlNode *output, void *user_data)
+schedule_write_flush(void)
 {
-    int level = LOG_ERR;
-    GHashTableIter iter;
-    const char *peer = NULL;
-    attribute_value_t *v = NULL;
+    if (write_flush_timer == NULL) {
+        write_flush_timer = mainloop_timer_add("attrd-cib-flush",
+                                               WRITE_COALESCE_MS, FALSE,
+                                               write_flush_cb, NULL);
+    }
+    if (!mainloop_timer_running(write_flush_timer)) {
+        mainloop_timer_start(write_flush_timer);
+    }
+}
 
-    char *name = user_data;
-    attribute_t *a = g_hash_table_lookup(attributes, name);
+static void
+free_attribute_name_list(gpointer data)
+{
+    g_list_free_full((GList *) data, free);
+}
 
-    if(a == NULL) {
-        crm_info("Attribute %s no longer exists", name);
-        return;
-    }
+static void
+attrd_cib_callback(xmlNode *msg, int call_id, int rc, xmlNode *output, void *user_data)
+{
+    int level = LOG_ERR;
+    const GList *names = user_data;
+    bool flush_needed = false;
 
-    a->update = 0;
     if (rc == pcmk_ok && call_id < 0) {
         rc = call_id;
     }
@@ -262,11 +292,6 @@ attrd_cib_callback(xmlNode *msg, int call_id, int rc, xmlNode *output, void *use
         case pcmk_ok:
             level = LOG_INFO;
             last_cib_op_done = call_id;
-            if (a->timer && !a->timeout_ms) {
-                // Remove temporary dampening for failed writes
-                mainloop_timer_del(a->timer);
-                a->timer = NULL;
-            }
             break;
 
         case -pcmk_err_diff_failed:    /* When an attr changes while the CIB is syncing */
@@ -278,56 +303,82 @@ attrd_cib_callback(xmlNode *msg, int call_id, int rc, xmlNode *output, void *use
             break;
     }
 
-    do_crm_log(level, "CIB update %d result for %s: %s " CRM_XS " rc=%d",
-               call_id, a->id, pcmk_strerror(rc), rc);
+    for (const GList *name_iter = names; name_iter != NULL;
+         name_iter = name_iter->next) {
+        const char *name = name_iter->data;
+        attribute_t *a = g_hash_table_lookup(attributes, name);
+        GHashTableIter iter;
+        const char *peer = NULL;
+        attribute_value_t *v = NULL;
 
-    g_hash_table_iter_init(&iter, a->values);
-    while (g_hash_table_iter_next(&iter, (gpointer *) & peer, (gpointer *) & v)) {
-        if (rc == pcmk_ok) {
-            crm_info("* Wrote %s[%s]=%s",
-                     a->id, peer, pcmk__s(v->requested, "(unset)"));
-            pcmk__str_update(&(v->requested), NULL);
-        } else {
-            do_crm_log(level, "* Could not write %s[%s]=%s",
-                       a->id, peer, pcmk__s(v->requested, "(unset)"));
-            /* Reattempt write below if we are still the writer */
-            attrd_set_attr_flags(a, attrd_attr_changed);
+        if (a == NULL) {
+            crm_info("Attribute %s no longer exists", name);
+            continue;
         }
-    }
 
-    if (pcmk_is_set(a->flags, attrd_attr_changed) && attrd_election_won()) {
-        if (rc == pcmk_ok) {
-            /* We deferred a write of a new update because this update was in
-             * progress. Write out the new value without additional delay.
+        a->update = 0;
+        if ((rc == pcmk_ok) && a->timer && !a->timeout_ms) {
+            // Remove temporary dampening for failed writes
+            mainloop_timer_del(a->timer);
+            a->timer = NULL;
+        }
+
+        do_crm_log(level, "CIB update %d result for %s: %s " CRM_XS " rc=%d",
+                   call_id, a->id, pcmk_strerror(rc), rc);
+
+        g_hash_table_iter_init(&iter, a->values);
+        while (g_hash_table_iter_next(&iter, (gpointer *) & peer, (gpointer *) & v)) {
+            if (rc == pcmk_ok) {
+                crm_info("* Wrote %s[%s]=%s",
+                         a->id, peer, pcmk__s(v->requested, "(unset)"));
+                pcmk__str_update(&(v->requested), NULL);
+            } else {
+                do_crm_log(level, "* Could not write %s[%s]=%s",
+                           a->id, peer, pcmk__s(v->requested, "(unset)"));
+                /* Reattempt write below if we are still the writer */
+                attrd_set_attr_flags(a, attrd_attr_changed);
+            }
+        }
+
+        if (pcmk_is_set(a->flags, attrd_attr_changed) && attrd_election_won()) {
+            if (rc == pcmk_ok) {
+                /* We deferred a write of a new update because this update was
+                 * in progress. Write out the new value without additional
+                 * delay (coalesced with any other pending updates).
+                 */
+                crm_debug("Pending update for %s can be written now", a->id);
+                flush_needed = true;
+
+            /* We're re-attempting a write because the original failed; delay
+             * the next attempt so we don't potentially flood the CIB manager
+             * and logs with a zillion attempts per second.
+             *
+             * @TODO We could elect a new writer instead. However, we'd have to
+             * somehow downgrade our vote, and we'd still need something like this
+             * if all peers similarly fail to write this attribute (which may
+             * indicate a corrupted attribute entry rather than a CIB issue).
              */
-            crm_debug("Pending update for %s can be written now", a->id);
-            write_attribute(a, false);
-
-        /* We're re-attempting a write because the original failed; delay
-         * the next attempt so we don't potentially flood the CIB manager
-         * and logs with a zillion attempts per second.
-         *
-         * @TODO We could elect a new writer instead. However, we'd have to
-         * somehow downgrade our vote, and we'd still need something like this
-         * if all peers similarly fail to write this attribute (which may
-         * indicate a corrupted attribute entry rather than a CIB issue).
-         */
-        } else if (a->timer) {
-            // Attribute has a dampening value, so use that as delay
-            if (!mainloop_timer_running(a->timer)) {
-                crm_trace("Delayed re-attempted write for %s by %s",
-                          name, pcmk__readable_interval(a->timeout_ms));
+            } else if (a->timer) {
+                // Attribute has a dampening value, so use that as delay
+                if (!mainloop_timer_running(a->timer)) {
+                    crm_trace("Delayed re-attempted write for %s by %s",
+                              name, pcmk__readable_interval(a->timeout_ms));
+                    mainloop_timer_start(a->timer);
+                }
+            } else {
+                /* Set a temporary dampening of 2 seconds (timer will continue
+                 * to exist until the attribute's dampening gets set or the
+                 * write succeeds).
+                 */
+                a->timer = attrd_add_timer(a->id, 2000, a);
                 mainloop_timer_start(a->timer);
             }
-        } else {
-            /* Set a temporary dampening of 2 seconds (timer will continue
-             * to exist until the attribute's dampening gets set or the
-             * write succeeds).
-             */
-            a->timer = attrd_add_timer(a->id, 2000, a);
-            mainloop_timer_start(a->timer);
         }
     }
+
+    if (flush_needed) {
+        schedule_write_flush();
+    }
 }
 
 /*!
@@ -468,173 +519,243 @@ attrd_add_timer(const char *id, int timeout_ms, attribute_t *attr)
    return mainloop_timer_add(id, timeout_ms, FALSE, attribute_timer_cb, attr);
 }
 
+// An attribute staged into the CIB transaction currently being built
+struct staged_attribute {
+    attribute_t *attr;
+    GHashTable *alert_values;   // Values to send alerts for once dispatched
+};
+
+static void
+free_staged_attribute(gpointer data)
+{
+    struct staged_attribute *staged = data;
+
+    if (staged->alert_values != NULL) {
+        g_hash_table_destroy(staged->alert_values);
+    }
+    free(staged);
+}
+
 /*!
  * \internal
- * \brief Write an attribute's values to the CIB if appropriate
+ * \brief Write a group of attributes to the CIB if appropriate
+ *
+ * All of the group's peer value updates are staged into a single CIB
+ * transaction, so a flush of any number of correlated attribute changes
+ * produces one patchset rather than one per attribute.
  *
- * \param[in,out] a             Attribute to write
- * \param[in]     ignore_delay  If true, write attribute now regardless of any
+ * \param[in,out] attrs         Attributes to write (all sharing one ACL user)
+ * \param[in]     ignore_delay  If true, write attributes now regardless of any
  *                              configured delay
  */
 static void
-write_attribute(attribute_t *a, bool ignore_delay)
+write_attribute_group(GList *attrs, bool ignore_delay)
 {
-    int private_updates = 0, cib_updates = 0;
-    attribute_value_t *v = NULL;
-    GHashTableIter iter;
-    GHashTable *alert_attribute_value = NULL;
+    GList *staged = NULL;   // struct staged_attribute for each attribute added
+    GList *names = NULL;    // Copies of their names, for the write callback
+    int cib_updates = 0;
+    int n_attrs = 0;
+    bool in_cib = false;
     int rc = pcmk_ok;
 
-    if (a == NULL) {
+    if (attrs == NULL) {
         return;
     }
 
-    /* If this attribute will be written to the CIB ... */
-    if (!stand_alone && !pcmk_is_set(a->flags, attrd_attr_is_private)) {
-        /* Defer the write if now's not a good time */
-        if (a->update && (a->update < last_cib_op_done)) {
-            crm_info("Write out of '%s' continuing: update %d considered lost",
-                     a->id, a->update);
-            a->update = 0; // Don't log this message again
-
-        } else if (a->update) {
-            crm_info("Write out of '%s' delayed: update %d in progress",
-                     a->id, a->update);
-            goto done;
+    /* If any of these attributes will be written to the CIB, initiate one
+     * transaction for all the peer value updates in the group
+     */
+    if (!stand_alone) {
+        for (GList *aiter = attrs; aiter != NULL; aiter = aiter->next) {
+            attribute_t *a = aiter->data;
 
-        } else if (mainloop_timer_running(a->timer)) {
-            if (ignore_delay) {
-                mainloop_timer_stop(a->timer);
-                crm_debug("Overriding '%s' write delay", a->id);
-            } else {
-                crm_info("Delaying write of '%s'", a->id);
-                goto done;
+            if (!pcmk_is_set(a->flags, attrd_attr_is_private)) {
+                in_cib = true;
+                break;
             }
         }
-
-        // Initiate a transaction for all the peer value updates
-        CRM_CHECK(the_cib != NULL, goto done);
-        the_cib->cmds->set_user(the_cib, a->user);
+    }
+    if (in_cib) {
+        CRM_CHECK(the_cib != NULL, return);
+        the_cib->cmds->set_user(the_cib,
+                                ((attribute_t *) attrs->data)->user);
         rc = the_cib->cmds->init_transaction(the_cib);
         if (rc != pcmk_ok) {
-            crm_err("Failed to write %s (set %s): Could not initiate "
-                    "CIB transaction",
-                    a->id, pcmk__s(a->set_id, "unspecified"));
+            crm_err("Failed to write attributes: Could not initiate "
+                    "CIB transaction");
             goto done;
         }
     }
 
-    /* Attribute will be written shortly, so clear changed flag and force
-     * write flag, and initialize UUID missing flag to false.
-     */
-    attrd_clear_attr_flags(a, attrd_attr_changed|attrd_attr_uuid_missing|attrd_attr_force_write);
+    for (GList *aiter = attrs; aiter != NULL; aiter = aiter->next) {
+        attribute_t *a = aiter->data;
+        struct staged_attribute *entry = NULL;
+        attribute_value_t *v = NULL;
+        GHashTableIter iter;
+        int private_updates = 0;
+        int attr_updates = 0;
+
+        /* If this attribute will be written to the CIB ... */
+        if (in_cib && !pcmk_is_set(a->flags, attrd_attr_is_private)) {
+            /* Defer the write if now's not a good time */
+            if (a->update && (a->update < last_cib_op_done)) {
+                crm_info("Write out of '%s' continuing: update %d considered "
+                         "lost", a->id, a->update);
+                a->update = 0; // Don't log this message again
+
+            } else if (a->update) {
+                crm_info("Write out of '%s' delayed: update %d in progress",
+                         a->id, a->update);
+                continue;
+
+            } else if (mainloop_timer_running(a->timer)) {
+                if (ignore_delay
+                    || pcmk_is_set(a->flags, attrd_attr_force_write)) {
+                    mainloop_timer_stop(a->timer);
+                    crm_debug("Overriding '%s' write delay", a->id);
+                } else {
+                    crm_info("Delaying write of '%s'", a->id);
+                    continue;
+                }
+            }
+        }
 
-    /* Make the table for the attribute trap */
-    alert_attribute_value = pcmk__strikey_table(NULL,
-                                                attrd_free_attribute_value);
+        /* Attribute will be written shortly, so clear changed flag and force
+         * write flag, and initialize UUID missing flag to false.
+         */
+        attrd_clear_attr_flags(a, attrd_attr_changed|attrd_attr_uuid_missing|attrd_attr_force_write);
 
-    /* Iterate over each peer value of this attribute */
-    g_hash_table_iter_init(&iter, a->values);
-    while (g_hash_table_iter_next(&iter, NULL, (gpointer *) &v)) {
-        const char *uuid = NULL;
+        /* Make the table for the attribute trap */
+        entry = pcmk__assert_alloc(1, sizeof(struct staged_attribute));
+        entry->attr = a;
+        entry->alert_values = pcmk__strikey_table(NULL,
+                                                  attrd_free_attribute_value);
 
-        if (pcmk_is_set(v->flags, attrd_value_remote)) {
-            /* If this is a Pacemaker Remote node, the node's UUID is the same
-             * as its name, which we already have.
-             */
-            uuid = v->nodename;
+        /* Iterate over each peer value of this attribute */
+        g_hash_table_iter_init(&iter, a->values);
+        while (g_hash_table_iter_next(&iter, NULL, (gpointer *) &v)) {
+            const char *uuid = NULL;
 
-        } else {
-            // This will create a cluster node cache entry if none exists
-            crm_node_t *peer = pcmk__get_node(v->nodeid, v->nodename, NULL,
-                                              pcmk__node_search_any);
+            if (pcmk_is_set(v->flags, attrd_value_remote)) {
+                /* If this is a Pacemaker Remote node, the node's UUID is the
+                 * same as its name, which we already have.
+                 */
+                uuid = v->nodename;
 
-            uuid = peer->uuid;
+            } else {
+                // This will create a cluster node cache entry if none exists
+                crm_node_t *peer = pcmk__get_node(v->nodeid, v->nodename, NULL,
+                                                  pcmk__node_search_any);
+
+                uuid = peer->uuid;
+
+                // Remember peer's node ID if we're just now learning it
+                if ((peer->id != 0) && (v->nodeid == 0)) {
+                    crm_trace("Learned ID %u for node %s",
+                              peer->id, v->nodename);
+                    v->nodeid = peer->id;
+                }
+            }
 
-            // Remember peer's node ID if we're just now learning it
-            if ((peer->id != 0) && (v->nodeid == 0)) {
-                crm_trace("Learned ID %u for node %s", peer->id, v->nodename);
-                v->nodeid = peer->id;
+            /* If this is a private attribute, no update needs to be sent */
+            if (stand_alone || pcmk_is_set(a->flags, attrd_attr_is_private)) {
+                private_updates++;
+                continue;
             }
-        }
 
-        /* If this is a private attribute, no update needs to be sent */
-        if (stand_alone || pcmk_is_set(a->flags, attrd_attr_is_private)) {
-            private_updates++;
-            continue;
-        }
+            // Defer write if this is a cluster node that's never been seen
+            if (uuid == NULL) {
+                attrd_set_attr_flags(a, attrd_attr_uuid_missing);
+                crm_notice("Cannot update %s[%s]='%s' now because node's UUID "
+                           "is unknown (will retry if learned)",
+                           a->id, v->nodename, v->current);
+                continue;
+            }
 
-        // Defer write if this is a cluster node that's never been seen
-        if (uuid == NULL) {
-            attrd_set_attr_flags(a, attrd_attr_uuid_missing);
-            crm_notice("Cannot update %s[%s]='%s' now because node's UUID is "
-                       "unknown (will retry if learned)",
-                       a->id, v->nodename, v->current);
-            continue;
-        }
+            // Update this value as part of the CIB transaction we're building
+            rc = add_attr_update(a, v->current, uuid);
+            if (rc != pcmk_rc_ok) {
+                crm_err("Failed to update %s[%s]='%s': %s "
+                        CRM_XS " node uuid=%s id=%" PRIu32,
+                        a->id, v->nodename, v->current, pcmk_rc_str(rc),
+                        uuid, v->nodeid);
+                continue;
+            }
 
-        // Update this value as part of the CIB transaction we're building
-        rc = add_attr_update(a, v->current, uuid);
-        if (rc != pcmk_rc_ok) {
-            crm_err("Failed to update %s[%s]='%s': %s "
-                    CRM_XS " node uuid=%s id=%" PRIu32,
-                    a->id, v->nodename, v->current, pcmk_rc_str(rc),
-                    uuid, v->nodeid);
-            continue;
-        }
+            crm_debug("Writing %s[%s]=%s (node-state-id=%s node-id=%" PRIu32
+                      ")", a->id, v->nodename, pcmk__s(v->current, "(unset)"),
+                      uuid, v->nodeid);
+            attr_updates++;
 
-        crm_debug("Writing %s[%s]=%s (node-state-id=%s node-id=%" PRIu32 ")",
-                  a->id, v->nodename, pcmk__s(v->current, "(unset)"),
-                  uuid, v->nodeid);
-        cib_updates++;
+            /* Preservation of the attribute to transmit alert */
+            set_alert_attribute_value(entry->alert_values, v);
 
-        /* Preservation of the attribute to transmit alert */
-        set_alert_attribute_value(alert_attribute_value, v);
+            // Save this value so we can log it when write completes
+            pcmk__str_update(&(v->requested), v->current);
+        }
 
-        // Save this value so we can log it when write completes
-        pcmk__str_update(&(v->requested), v->current);
+        if (private_updates) {
+            crm_info("Processed %d private change%s for %s (set %s)",
+                     private_updates, pcmk__plural_s(private_updates),
+                     a->id, pcmk__s(a->set_id, "unspecified"));
+        }
+        if (attr_updates > 0) {
+            cib_updates += attr_updates;
+            n_attrs++;
+            staged = g_list_prepend(staged, entry);
+            names = g_list_prepend(names, pcmk__str_copy(a->id));
+        } else {
+            free_staged_attribute(entry);
+        }
     }
 
-    if (private_updates) {
-        crm_info("Processed %d private change%s for %s (set %s)",
-                 private_updates, pcmk__plural_s(private_updates),
-                 a->id, pcmk__s(a->set_id, "unspecified"));
-    }
     if (cib_updates > 0) {
-        char *id = pcmk__str_copy(a->id);
-
         // Commit transaction
-        a->update = the_cib->cmds->end_transaction(the_cib, true, cib_none);
-
-        crm_info("Sent CIB request %d with %d change%s for %s (set %s)",
-                 a->update, cib_updates, pcmk__plural_s(cib_updates),
-                 a->id, pcmk__s(a->set_id, "unspecified"));
-
-        if (the_cib->cmds->register_callback_full(the_cib, a->update,
-                                                  CIB_OP_TIMEOUT_S, FALSE, id,
-                                                  "attrd_cib_callback",
-                                                  attrd_cib_callback, free)) {
-            // Transmit alert of the attribute
-            send_alert_attributes_value(a, alert_attribute_value);
+        int update = the_cib->cmds->end_transaction(the_cib, true, cib_none);
+
+        for (GList *siter = staged; siter != NULL; siter = siter->next) {
+            ((struct staged_attribute *) siter->data)->attr->update = update;
         }
+
+        crm_info("Sent CIB request %d with %d change%s for %d attribute%s",
+                 update, cib_updates, pcmk__plural_s(cib_updates),
+                 n_attrs, pcmk__plural_s(n_attrs));
+
+        if (the_cib->cmds->register_callback_full(the_cib, update,
+                                                  CIB_OP_TIMEOUT_S, FALSE,
+                                                  names, "attrd_cib_callback",
+                                                  attrd_cib_callback,
+                                                  free_attribute_name_list)) {
+            // Transmit alerts for the attributes we just dispatched
+            for (GList *siter = staged; siter != NULL; siter = siter->next) {
+                struct staged_attribute *entry = siter->data;
+
+                send_alert_attributes_value(entry->attr, entry->alert_values);
+            }
+        }
+        names = NULL; // Now owned by the callback machinery
     }
 
 done:
     // Discard transaction (if any)
-    if (the_cib != NULL) {
+    if (in_cib) {
         the_cib->cmds->end_transaction(the_cib, false, cib_none);
         the_cib->cmds->set_user(the_cib, NULL);
     }
 
-    if (alert_attribute_value != NULL) {
-        g_hash_table_destroy(alert_attribute_value);
+    if (names != NULL) {
+        free_attribute_name_list(names);
     }
+    g_list_free_full(staged, free_staged_attribute);
 }
 
 /*!
  * \internal
  * \brief Write out attributes
  *
+ * Attributes are grouped by ACL user, and each group is written out as a
+ * single CIB transaction.
+ *
  * \param[in] options  Group of enum attrd_write_options
  */
 void
@@ -642,6 +763,8 @@ attrd_write_attributes(uint32_t options)
 {
     GHashTableIter iter;
     attribute_t *a = NULL;
+    GList *to_write = NULL;
+    bool ignore_delay = pcmk_is_set(options, attrd_write_no_delay);
 
     crm_debug("Writing out %s attributes",
               pcmk_is_set(options, attrd_write_all)? "all" : "changed");
@@ -658,24 +781,203 @@ attrd_write_attributes(uint32_t options)
 
         if (pcmk_is_set(options, attrd_write_all) ||
             pcmk_is_set(a->flags, attrd_attr_changed)) {
-            bool ignore_delay = pcmk_is_set(options, attrd_write_no_delay);
+            to_write = g_list_prepend(to_write, a);
+        } else {
+            crm_trace("Skipping unchanged attribute %s", a->id);
+        }
+    }
+
+    /* Write out one group (and thus one CIB transaction) per ACL user, since
+     * a transaction is committed with a single user
+     */
+    while (to_write != NULL) {
+        const char *user = ((attribute_t *) to_write->data)->user;
+        GList *group = NULL;
+        GList *item = to_write;
+
+        while (item != NULL) {
+            GList *next = item->next;
+            attribute_t *b = item->data;
+
+            if (pcmk__str_eq(user, b->user, pcmk__str_casei)) {
+                to_write = g_list_remove_link(to_write, item);
+                group = g_list_concat(group, item);
+            }
+            item = next;
+        }
+        write_attribute_group(group, ignore_delay);
+        g_list_free(group);
+    }
+}
+
+/*!
+ * \internal
+ * \brief Build a table of transient attribute values currently in the CIB
+ *
+ * \param[in] status  CIB status section XML
+ *
+ * \return Table mapping node name to a table of attribute name -> value
+ */
+static GHashTable *
+cib_transient_values(const xmlNode *status)
+{
+    GHashTable *nodes = pcmk__strkey_table(free,
+                                           (GDestroyNotify) g_hash_table_destroy);
+
+    for (const xmlNode *node_state = pcmk__xe_first_child(status,
+                                                          PCMK__XE_NODE_STATE,
+                                                          NULL, NULL);
+         node_state != NULL; node_state = pcmk__xe_next_same(node_state)) {
+
+        const char *uname = crm_element_value(node_state, PCMK_XA_UNAME);
+        const xmlNode *attrs =
+            pcmk__xe_first_child(node_state, PCMK__XE_TRANSIENT_ATTRIBUTES,
+                                 NULL, NULL);
+        GHashTable *values = NULL;
+
+        if ((uname == NULL) || (attrs == NULL)) {
+            continue;
+        }
+
+        values = pcmk__strkey_table(free, free);
+        g_hash_table_insert(nodes, pcmk__str_copy(uname), values);
 
-            if (pcmk_is_set(a->flags, attrd_attr_force_write)) {
-                // Always ignore delay when forced write flag is set
-                ignore_delay = true;
+        for (const xmlNode *set = pcmk__xe_first_child(attrs, NULL, NULL,
+                                                       NULL);
+             set != NULL; set = pcmk__xe_next(set)) {
+
+            for (const xmlNode *nvpair = pcmk__xe_first_child(set,
+                                                              PCMK_XE_NVPAIR,
+                                                              NULL, NULL);
+                 nvpair != NULL; nvpair = pcmk__xe_next_same(nvpair)) {
+
+                const char *name = crm_element_value(nvpair, PCMK_XA_NAME);
+                const char *value = crm_element_value(nvpair, PCMK_XA_VALUE);
+
+                if (name != NULL) {
+                    g_hash_table_insert(values, pcmk__str_copy(name),
+                                        pcmk__str_copy(value));
+                }
             }
-            write_attribute(a, ignore_delay);
+        }
+    }
+    return nodes;
+}
+
+static void
+takeover_query_cb(xmlNode *msg, int call_id, int rc, xmlNode *output,
+                  void *user_data)
+{
+    GHashTable *cib_values = NULL;
+    GHashTableIter aIter;
+    attribute_t *a = NULL;
+    int stale = 0;
+    int fresh = 0;
+
+    if (!attrd_election_won()) {
+        return; // Lost the writer role while the query was in flight
+    }
+
+    if ((rc != pcmk_ok) || (output == NULL)) {
+        crm_warn("Could not check CIB for stale attributes after takeover, "
+                 "writing all: %s " CRM_XS " rc=%d", pcmk_strerror(rc), rc);
+        attrd_write_attributes(attrd_write_all);
+        return;
+    }
+
+    cib_values = cib_transient_values(output);
+
+    g_hash_table_iter_init(&aIter, attributes);
+    while (g_hash_table_iter_next(&aIter, NULL, (gpointer *) & a)) {
+        GHashTableIter vIter;
+        attribute_value_t *v = NULL;
+        bool is_stale = false;
+
+        if (pcmk_is_set(a->flags, attrd_attr_is_private)) {
+            continue; // Never written to the CIB
+        }
+
+        g_hash_table_iter_init(&vIter, a->values);
+        while (g_hash_table_iter_next(&vIter, NULL, (gpointer *) & v)) {
+            GHashTable *node_values = g_hash_table_lookup(cib_values,
+                                                          v->nodename);
+            const char *cib_value = NULL;
+
+            if (node_values != NULL) {
+                cib_value = g_hash_table_lookup(node_values, a->id);
+            }
+
+            // A NULL current value is stale if the CIB still has the nvpair
+            if (!pcmk__str_eq(cib_value, v->current, pcmk__str_casei)) {
+                is_stale = true;
+                break;
+            }
+        }
+
+        if (is_stale) {
+            stale++;
+            attrd_set_attr_flags(a, attrd_attr_changed);
         } else {
-            crm_trace("Skipping unchanged attribute %s", a->id);
+            fresh++;
         }
     }
+    g_hash_table_destroy(cib_values);
+
+    crm_notice("Writing %d stale attribute%s after takeover "
+               "(%d already up-to-date in CIB)",
+               stale, pcmk__plural_s(stale), fresh);
+    if (stale > 0) {
+        attrd_write_attributes(attrd_write_changed);
+    }
+}
+
+/*!
+ * \internal
+ * \brief Write out only attributes whose CIB state is stale
+ *
+ * The local CIB replica is a continuously maintained copy of everything the
+ * previous writer committed, so a new writer can consult it to learn which
+ * attributes actually need rewriting instead of rewriting all of them.
+ * Query the status section and flush only the attributes that differ,
+ * falling back to writing everything if the query fails.
+ */
+void
+attrd_write_stale_attributes(void)
+{
+    int call_id = 0;
+
+    if (stand_alone || (the_cib == NULL)) {
+        attrd_write_attributes(attrd_write_all);
+        return;
+    }
+
+    call_id = the_cib->cmds->query(the_cib,
+                                   pcmk__cib_abs_xpath_for(PCMK_XE_STATUS),
+                                   NULL, cib_xpath|cib_scope_local);
+    if (call_id < 0) {
+        crm_warn("Could not query CIB status section after takeover, "
+                 "writing all attributes: %s " CRM_XS " rc=%d",
+                 pcmk_strerror(call_id), call_id);
+        attrd_write_attributes(attrd_write_all);
+        return;
+    }
+
+    the_cib->cmds->register_callback_full(the_cib, call_id, 120, FALSE, NULL,
+                                          "takeover_query_cb",
+                                          takeover_query_cb, NULL);
+    crm_trace("Checking CIB for stale attributes... call %d", call_id);
 }
 
 void
 attrd_write_or_elect_attribute(attribute_t *a)
 {
     if (attrd_election_won()) {
-        write_attribute(a, false);
+        /* Rather than writing immediately, wait briefly so that correlated
+         * updates (and bursts of expiring dampening timers) are coalesced
+         * into a single CIB update
+         */
+        attrd_set_attr_flags(a, attrd_attr_changed);
+        schedule_write_flush();
     } else {
         attrd_start_election_if_needed();
     }
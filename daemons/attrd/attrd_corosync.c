@@ -141,6 +141,127 @@ attrd_cpg_destroy(gpointer unused)
     }
 }
 
+/* Each locally originated update broadcast is stamped with the next value of
+ * this sequence, and every node tracks the highest sequence it has applied
+ * from each originating node. A peer that missed updates (a rejoin, or a
+ * writer change) can then ask the writer for just the sequences it has not
+ * seen, instead of receiving the full attribute set.
+ */
+static uint64_t local_update_seq = 0;
+
+// Originating node name -> uint64_t * (highest broadcast sequence applied)
+static GHashTable *peer_seen_seqs = NULL;
+
+static uint64_t
+seen_seq(GHashTable *table, const char *origin)
+{
+    uint64_t *seq = (table == NULL)? NULL : g_hash_table_lookup(table, origin);
+
+    return (seq == NULL)? 0 : *seq;
+}
+
+static void
+note_seen_seq(const char *origin, uint64_t seq)
+{
+    uint64_t *entry = NULL;
+
+    if (peer_seen_seqs == NULL) {
+        peer_seen_seqs = pcmk__strkey_table(free, free);
+    }
+    entry = g_hash_table_lookup(peer_seen_seqs, origin);
+    if (entry == NULL) {
+        entry = pcmk__assert_alloc(1, sizeof(uint64_t));
+        *entry = seq;
+        g_hash_table_insert(peer_seen_seqs, pcmk__str_copy(origin), entry);
+    } else if (seq > *entry) {
+        *entry = seq;
+    }
+}
+
+/*!
+ * \internal
+ * \brief Stamp a locally originated update broadcast with its sequence
+ *
+ * \param[in,out] xml  Update message being broadcast
+ */
+void
+attrd_stamp_local_update(xmlNode *xml)
+{
+    local_update_seq++;
+    crm_xml_add_ll(xml, PCMK__XA_ATTR_SYNC_SEQ, (long long) local_update_seq);
+}
+
+/*!
+ * \internal
+ * \brief Hash one attribute name/value pair as a single unit
+ *
+ * The name and value must be hashed jointly (not hashed separately and then
+ * combined): digests built from separable per-field hashes are blind to two
+ * attributes swapping their values, which is exactly the kind of divergence
+ * a reconciliation digest exists to catch.
+ *
+ * \param[in] name   Attribute name
+ * \param[in] value  Attribute value
+ *
+ * \return 64-bit FNV-1a hash of "name=value"
+ */
+static uint64_t
+attr_pair_hash(const char *name, const char *value)
+{
+    uint64_t hash = UINT64_C(0xcbf29ce484222325);
+
+    for (const char *p = name; *p != '\0'; p++) {
+        hash = (hash ^ (uint8_t) *p) * UINT64_C(0x100000001b3);
+    }
+    hash = (hash ^ (uint8_t) '=') * UINT64_C(0x100000001b3);
+    for (const char *p = value; *p != '\0'; p++) {
+        hash = (hash ^ (uint8_t) *p) * UINT64_C(0x100000001b3);
+    }
+    return hash;
+}
+
+/*!
+ * \internal
+ * \brief Digest every node's attribute values as this node knows them
+ *
+ * Each value contributes a joint hash of its attribute name and value,
+ * folded per node with a commutative mix so the digest is independent of
+ * table iteration order. Two nodes with equal digests for a host hold the
+ * same attribute set for it, so sync can skip that host entirely.
+ *
+ * \return Table mapping node name to uint64_t * digest of that node's values
+ */
+static GHashTable *
+node_attr_digests(void)
+{
+    GHashTable *digests = pcmk__strkey_table(free, free);
+    GHashTableIter aIter;
+    GHashTableIter vIter;
+    attribute_t *a = NULL;
+    attribute_value_t *v = NULL;
+
+    g_hash_table_iter_init(&aIter, attributes);
+    while (g_hash_table_iter_next(&aIter, NULL, (gpointer *) & a)) {
+        g_hash_table_iter_init(&vIter, a->values);
+        while (g_hash_table_iter_next(&vIter, NULL, (gpointer *) & v)) {
+            uint64_t *entry = g_hash_table_lookup(digests, v->nodename);
+            uint64_t hash = attr_pair_hash(a->id, pcmk__s(v->current, ""));
+
+            if (entry == NULL) {
+                entry = pcmk__assert_alloc(1, sizeof(uint64_t));
+                g_hash_table_insert(digests, pcmk__str_copy(v->nodename),
+                                    entry);
+            }
+            /* Additive fold of a multiplicatively mixed hash: commutative
+             * (iteration order varies between nodes), and unlike XOR, pairs
+             * of differing entries can't cancel each other out
+             */
+            *entry += hash * UINT64_C(0x9e3779b97f4a7c15);
+        }
+    }
+    return digests;
+}
+
 /*!
  * \internal
  * \brief Broadcast an update for a single attribute value
@@ -159,6 +280,93 @@ attrd_broadcast_value(const attribute_t *a, const attribute_value_t *v)
     pcmk__xml_free(op);
 }
 
+/* If a writer invites a rejoining peer to request the values it's missing
+ * but the peer doesn't respond (for example, an older attrd that doesn't
+ * understand the invitation), fall back to a full sync after this long
+ */
+#define SYNC_INVITE_TIMEOUT_MS 5000
+
+// Invited node name -> mainloop_timer_t * for the full-sync fallback
+static GHashTable *sync_invites = NULL;
+
+static void
+free_invite_timer(gpointer data)
+{
+    mainloop_timer_del((mainloop_timer_t *) data);
+}
+
+static gboolean
+sync_invite_timeout_cb(gpointer data)
+{
+    char *uname = pcmk__str_copy((const char *) data);
+
+    // This also frees the timer (and data), which is safe for one-shot timers
+    if (sync_invites != NULL) {
+        g_hash_table_remove(sync_invites, uname);
+    }
+
+    if (attrd_election_won()) {
+        crm_node_t *peer = pcmk__get_node(0, uname, NULL,
+                                          pcmk__node_search_cluster_member);
+
+        crm_notice("Peer %s did not request a sync when invited; "
+                   "sending full attribute set", uname);
+        attrd_peer_sync(peer);
+    }
+    free(uname);
+    return FALSE;
+}
+
+/*!
+ * \internal
+ * \brief Bring a peer that joined the membership up to date
+ *
+ * When possible, invite the peer to request just the values it's missing
+ * (with a timed fallback to a full sync); otherwise send it everything.
+ *
+ * \param[in,out] peer  Peer that joined
+ */
+static void
+attrd_welcome_peer(crm_node_t *peer)
+{
+    mainloop_timer_t *timer = NULL;
+    char *key = NULL;
+
+    if (!ATTRD_SUPPORTS_DELTA_SYNC(minimum_protocol_version)) {
+        // Some peer may not understand an invitation; just push everything
+        attrd_peer_sync(peer);
+        return;
+    }
+
+    if (sync_invites == NULL) {
+        sync_invites = pcmk__strkey_table(free, free_invite_timer);
+    } else if (g_hash_table_lookup(sync_invites, peer->uname) != NULL) {
+        return; // Already invited, and the fallback timer is still running
+    }
+
+    key = pcmk__str_copy(peer->uname);
+    timer = mainloop_timer_add(key, SYNC_INVITE_TIMEOUT_MS, FALSE,
+                               sync_invite_timeout_cb, key);
+    g_hash_table_insert(sync_invites, key, timer);
+    mainloop_timer_start(timer);
+
+    attrd_announce_writer(peer);
+}
+
+/*!
+ * \internal
+ * \brief Cancel any pending sync invitation for a peer
+ *
+ * \param[in] uname  Name of peer to cancel invitation for
+ */
+static void
+cancel_sync_invite(const char *uname)
+{
+    if (sync_invites != NULL) {
+        g_hash_table_remove(sync_invites, uname);
+    }
+}
+
 #define state_text(state) pcmk__s((state), "in unknown state")
 
 static void
@@ -192,7 +400,7 @@ attrd_peer_change_cb(enum crm_status_type kind, crm_node_t *peer, const void *da
                  */
                 if (attrd_election_won()
                     && !pcmk_is_set(peer->flags, crm_remote_node)) {
-                    attrd_peer_sync(peer);
+                    attrd_welcome_peer(peer);
                 }
             } else {
                 // Remove all attribute values associated with lost nodes
@@ -207,6 +415,7 @@ attrd_peer_change_cb(enum crm_status_type kind, crm_node_t *peer, const void *da
         attrd_remove_voter(peer);
         attrd_remove_peer_protocol_ver(peer->uname);
         attrd_do_not_expect_from_peer(peer->uname);
+        cancel_sync_invite(peer->uname);
     }
 }
 
@@ -234,6 +443,7 @@ update_attr_on_host(attribute_t *a, const crm_node_t *peer, const xmlNode *xml,
 {
     int is_remote = 0;
     bool changed = false;
+    bool filtered = false;
     attribute_value_t *v = NULL;
 
     // Create entry for value if not already existing
@@ -266,6 +476,7 @@ update_attr_on_host(attribute_t *a, const crm_node_t *peer, const xmlNode *xml,
         crm_notice("%s[%s]: local value '%s' takes priority over '%s' from %s",
                    attr, host, readable_value(v), value, peer->uname);
         attrd_broadcast_value(a, v);
+        filtered = true;
 
     } else if (changed) {
         crm_notice("Setting %s[%s]%s%s: %s -> %s "
@@ -318,6 +529,28 @@ update_attr_on_host(attribute_t *a, const crm_node_t *peer, const xmlNode *xml,
     // This allows us to later detect local values that peer doesn't know about
     attrd_set_value_flags(v, attrd_value_from_peer);
 
+    /* Record the update's delta sync bookkeeping: the broadcast sequence that
+     * the originating node assigned to it (updates carry the sender's
+     * sequence, sync responses relay each value's original stamp)
+     */
+    {
+        long long seq = 0LL;
+
+        if (crm_element_value_ll(xml, PCMK__XA_ATTR_SYNC_SEQ, &seq) == 0) {
+            const char *origin = crm_element_value(xml,
+                                                   PCMK__XA_ATTR_SYNC_ORIGIN);
+
+            if (origin == NULL) {
+                origin = peer->uname;
+            }
+            note_seen_seq(origin, (uint64_t) seq);
+            if (!filtered) {
+                pcmk__str_update(&v->sync_origin, origin);
+                v->sync_seq = (uint64_t) seq;
+            }
+        }
+    }
+
     /* If this is a cluster node whose node ID we are learning, remember it */
     if ((v->nodeid == 0) && !pcmk_is_set(v->flags, attrd_value_remote)
         && (crm_element_value_int(xml, PCMK__XA_ATTR_HOST_ID,
@@ -469,6 +702,112 @@ attrd_peer_clear_failure(pcmk__request_t *request)
     regfree(&regex);
 }
 
+/*!
+ * \internal
+ * \brief Ask the writer for just the update broadcasts we have not seen
+ *
+ * \param[in] writer  Peer that is the attribute writer
+ */
+static void
+request_delta_sync(const crm_node_t *writer)
+{
+    crm_node_t *node = pcmk__get_node(0, writer->uname, NULL,
+                                      pcmk__node_search_cluster_member);
+    xmlNode *request = pcmk__xe_create(NULL, __func__);
+    GHashTableIter iter;
+    const char *origin = NULL;
+    uint64_t *seq = NULL;
+
+    GHashTable *digests = NULL;
+    const char *host = NULL;
+    uint64_t *digest = NULL;
+
+    crm_xml_add(request, PCMK_XA_TASK, PCMK__ATTRD_CMD_SYNC_REQUEST);
+
+    if (peer_seen_seqs != NULL) {
+        g_hash_table_iter_init(&iter, peer_seen_seqs);
+        while (g_hash_table_iter_next(&iter, (gpointer *) &origin,
+                                      (gpointer *) &seq)) {
+            xmlNode *child = pcmk__xe_create(request, PCMK_XE_OP);
+
+            crm_xml_add(child, PCMK__XA_ATTR_SYNC_ORIGIN, origin);
+            crm_xml_add_ll(child, PCMK__XA_ATTR_SYNC_SEQ, (long long) *seq);
+        }
+    }
+
+    /* Also digest each node's values as we know them, so the writer can skip
+     * nodes that are already identical and send the full set for nodes that
+     * diverged in ways the sequence vector can't see
+     */
+    digests = node_attr_digests();
+    g_hash_table_iter_init(&iter, digests);
+    while (g_hash_table_iter_next(&iter, (gpointer *) &host,
+                                  (gpointer *) &digest)) {
+        xmlNode *child = pcmk__xe_create(request, PCMK_XE_NODE);
+
+        crm_xml_add(child, PCMK__XA_ATTR_HOST, host);
+        crm_xml_add_ll(child, PCMK__XA_ATTR_SYNC_DIGEST, (long long) *digest);
+    }
+    g_hash_table_destroy(digests);
+
+    crm_debug("Requesting missed attribute updates from %s", writer->uname);
+    attrd_send_message(node, request, false);
+    pcmk__xml_free(request);
+}
+
+/*!
+ * \internal
+ * \brief Broadcast local values whose broadcasts the writer has not applied
+ *
+ * \param[in] writer_seen  Highest broadcast sequence of ours that the writer
+ *                         has applied
+ */
+static void
+broadcast_unsynced_local_values(uint64_t writer_seen)
+{
+    GHashTableIter aIter;
+    GHashTableIter vIter;
+    attribute_t *a = NULL;
+    attribute_value_t *v = NULL;
+    xmlNode *sync = NULL;
+
+    g_hash_table_iter_init(&aIter, attributes);
+    while (g_hash_table_iter_next(&aIter, NULL, (gpointer *) & a)) {
+
+        g_hash_table_iter_init(&vIter, a->values);
+        while (g_hash_table_iter_next(&vIter, NULL, (gpointer *) & v)) {
+            bool unsynced = false;
+
+            if (v->sync_origin == NULL) {
+                // No bookkeeping; only our own values could be local-only
+                unsynced = pcmk__str_eq(v->nodename, attrd_cluster->uname,
+                                        pcmk__str_casei);
+            } else {
+                // A broadcast of ours that the writer has not applied yet
+                unsynced = pcmk__str_eq(v->sync_origin, attrd_cluster->uname,
+                                        pcmk__str_casei)
+                           && (v->sync_seq > writer_seen);
+            }
+
+            if (unsynced) {
+                crm_trace("* %s[%s]='%s' is not known to the writer",
+                          a->id, v->nodename, readable_value(v));
+                if (sync == NULL) {
+                    sync = pcmk__xe_create(NULL, __func__);
+                    crm_xml_add(sync, PCMK_XA_TASK, PCMK__ATTRD_CMD_SYNC_RESPONSE);
+                }
+                attrd_add_value_xml(sync, a, v, a->timeout_ms && a->timer);
+            }
+        }
+    }
+
+    if (sync != NULL) {
+        crm_debug("Broadcasting values the writer has not seen");
+        attrd_send_message(NULL, sync, false);
+        pcmk__xml_free(sync);
+    }
+}
+
 /*!
  * \internal
  * \brief Load attributes from a peer sync response
@@ -480,10 +819,24 @@ attrd_peer_clear_failure(pcmk__request_t *request)
 void
 attrd_peer_sync_response(const crm_node_t *peer, bool peer_won, xmlNode *xml)
 {
+    int delta = 0;
+
     crm_info("Processing " PCMK__ATTRD_CMD_SYNC_RESPONSE " from %s",
              peer->uname);
 
-    if (peer_won) {
+    crm_element_value_int(xml, PCMK__XA_ATTR_SYNC_DELTA, &delta);
+    if (delta && (crm_element_value(xml, PCMK__XA_ATTR_SYNC_SEEN) == NULL)) {
+        /* A new writer announced itself rather than broadcasting full state.
+         * Ask it for just the update broadcasts we have not seen; it will
+         * reply with a delta sync response.
+         */
+        if (peer_won) {
+            request_delta_sync(peer);
+        }
+        return;
+    }
+
+    if (peer_won && !delta) {
         /* Initialize the "seen" flag for all attributes to cleared, so we can
          * detect attributes that local node has but the writer doesn't.
          */
@@ -499,10 +852,21 @@ attrd_peer_sync_response(const crm_node_t *peer, bool peer_won, xmlNode *xml)
     }
 
     if (peer_won) {
-        /* If any attributes are still not marked as seen, the writer doesn't
-         * know about them, so send all peers an update with them.
-         */
-        broadcast_unseen_local_values();
+        if (delta) {
+            /* A delta response tells us how much of our own broadcast history
+             * the writer has applied; send everything past that, so the
+             * writer learns values it's missing without a full comparison.
+             */
+            long long writer_seen = 0LL;
+
+            crm_element_value_ll(xml, PCMK__XA_ATTR_SYNC_SEEN, &writer_seen);
+            broadcast_unsynced_local_values((uint64_t) writer_seen);
+        } else {
+            /* If any attributes are still not marked as seen, the writer
+             * doesn't know about them, so send all peers an update with them.
+             */
+            broadcast_unseen_local_values();
+        }
     }
 }
 
@@ -571,6 +935,150 @@ attrd_peer_sync(crm_node_t *peer)
     pcmk__xml_free(sync);
 }
 
+/*!
+ * \internal
+ * \brief Send a peer only the attribute values it has not seen
+ *
+ * \param[in,out] peer  Peer that requested the sync
+ * \param[in]     xml   Sync request XML (carrying the sequences the peer has
+ *                      applied from each originating node)
+ */
+void
+attrd_peer_sync_delta(crm_node_t *peer, xmlNode *xml)
+{
+    GHashTable *seen = pcmk__strkey_table(free, free);
+    GHashTable *their_digests = pcmk__strkey_table(free, free);
+    GHashTable *my_digests = NULL;
+    bool has_digests = false;
+    GHashTableIter aIter;
+    GHashTableIter vIter;
+    attribute_t *a = NULL;
+    attribute_value_t *v = NULL;
+    int values = 0;
+    xmlNode *sync = pcmk__xe_create(NULL, __func__);
+
+    // The requester answered an invitation (if any); don't push a full sync
+    cancel_sync_invite(peer->uname);
+
+    crm_xml_add(sync, PCMK_XA_TASK, PCMK__ATTRD_CMD_SYNC_RESPONSE);
+    crm_xml_add_int(sync, PCMK__XA_ATTR_SYNC_DELTA, 1);
+
+    // What the requester has already applied, by originating node
+    for (xmlNode *child = pcmk__xe_first_child(xml, PCMK_XE_OP, NULL, NULL);
+         child != NULL; child = pcmk__xe_next_same(child)) {
+        const char *origin = crm_element_value(child,
+                                               PCMK__XA_ATTR_SYNC_ORIGIN);
+        long long seq = 0LL;
+
+        if ((origin != NULL)
+            && (crm_element_value_ll(child, PCMK__XA_ATTR_SYNC_SEQ,
+                                     &seq) == 0)) {
+            uint64_t *entry = pcmk__assert_alloc(1, sizeof(uint64_t));
+
+            *entry = (uint64_t) seq;
+            g_hash_table_insert(seen, pcmk__str_copy(origin), entry);
+        }
+    }
+
+    // The requester's digest of each node's values as it knows them
+    for (xmlNode *child = pcmk__xe_first_child(xml, PCMK_XE_NODE, NULL, NULL);
+         child != NULL; child = pcmk__xe_next_same(child)) {
+        const char *host = crm_element_value(child, PCMK__XA_ATTR_HOST);
+        long long digest = 0LL;
+
+        if ((host != NULL)
+            && (crm_element_value_ll(child, PCMK__XA_ATTR_SYNC_DIGEST,
+                                     &digest) == 0)) {
+            uint64_t *entry = pcmk__assert_alloc(1, sizeof(uint64_t));
+
+            *entry = (uint64_t) digest;
+            g_hash_table_insert(their_digests, pcmk__str_copy(host), entry);
+            has_digests = true;
+        }
+    }
+    if (has_digests) {
+        my_digests = node_attr_digests();
+    }
+
+    g_hash_table_iter_init(&aIter, attributes);
+    while (g_hash_table_iter_next(&aIter, NULL, (gpointer *) & a)) {
+        g_hash_table_iter_init(&vIter, a->values);
+        while (g_hash_table_iter_next(&vIter, NULL, (gpointer *) & v)) {
+            bool include = false;
+
+            if (has_digests) {
+                /* Skip every value of a node whose digest matches (the
+                 * requester provably has its whole set), and transfer the
+                 * full set of any node that diverged or that either side
+                 * doesn't know
+                 */
+                uint64_t *theirs = g_hash_table_lookup(their_digests,
+                                                       v->nodename);
+                uint64_t *mine = g_hash_table_lookup(my_digests, v->nodename);
+
+                include = (theirs == NULL) || (mine == NULL)
+                          || (*theirs != *mine);
+            } else {
+                /* No digests in the request; include any value without delta
+                 * bookkeeping, and any whose broadcast the requester has not
+                 * applied
+                 */
+                include = (v->sync_origin == NULL)
+                          || (v->sync_seq > seen_seq(seen, v->sync_origin));
+            }
+
+            if (include) {
+                crm_debug("Syncing %s[%s]='%s' to %s",
+                          a->id, v->nodename, readable_value(v),
+                          readable_peer(peer));
+                attrd_add_value_xml(sync, a, v, false);
+                values++;
+            }
+        }
+    }
+
+    /* Tell the requester how much of its own broadcast history we have
+     * applied, so it can rebroadcast anything we are missing
+     */
+    crm_xml_add_ll(sync, PCMK__XA_ATTR_SYNC_SEEN,
+                   (long long) seen_seq(peer_seen_seqs, peer->uname));
+
+    crm_debug("Syncing %d missed value%s to %s",
+              values, pcmk__plural_s(values), readable_peer(peer));
+    attrd_send_message(peer, sync, false);
+    pcmk__xml_free(sync);
+    g_hash_table_destroy(seen);
+    g_hash_table_destroy(their_digests);
+    if (my_digests != NULL) {
+        g_hash_table_destroy(my_digests);
+    }
+}
+
+/*!
+ * \internal
+ * \brief Announce ourselves as writer instead of sending full state
+ *
+ * Peers respond by requesting just the update broadcasts they have not seen,
+ * so writer elections and rejoins no longer flood the cluster layer with the
+ * full attribute set. Only usable when all peers support delta
+ * synchronization.
+ *
+ * \param[in,out] peer  Peer to announce to (if NULL, announce to all peers)
+ */
+void
+attrd_announce_writer(crm_node_t *peer)
+{
+    xmlNode *sync = pcmk__xe_create(NULL, __func__);
+
+    crm_xml_add(sync, PCMK_XA_TASK, PCMK__ATTRD_CMD_SYNC_RESPONSE);
+    crm_xml_add_int(sync, PCMK__XA_ATTR_SYNC_DELTA, 1);
+
+    crm_debug("Announcing writership to %s; missed updates will be requested",
+              readable_peer(peer));
+    attrd_send_message(peer, sync, false);
+    pcmk__xml_free(sync);
+}
+
 void
 attrd_peer_update(const crm_node_t *peer, xmlNode *xml, const char *host,
                   bool filter)
@@ -22,13 +22,24 @@ attrd_election_cb(gpointer user_data)
 {
     attrd_declare_winner();
 
-    /* Update the peers after an election */
-    attrd_peer_sync(NULL);
+    /* Update the peers after an election. If every peer can request deltas,
+     * announce the result and let each peer ask for just the updates it
+     * missed; otherwise broadcast the full attribute set. (Nodes that newly
+     * join the membership still get a full sync, since their protocol version
+     * isn't known yet when they're welcomed.)
+     */
+    if (ATTRD_SUPPORTS_DELTA_SYNC(minimum_protocol_version)) {
+        attrd_announce_writer(NULL);
+    } else {
+        attrd_peer_sync(NULL);
+    }
 
-    /* After winning an election, update the CIB with the values of all
-     * attributes as the winner knows them.
+    /* After winning an election, bring the CIB in line with the attributes
+     * as the winner knows them. The local CIB replica already mirrors what
+     * the previous writer committed, so only attributes whose CIB state is
+     * actually stale get rewritten.
      */
-    attrd_write_attributes(attrd_write_all);
+    attrd_write_stale_attributes();
     return G_SOURCE_REMOVE;
 }
 
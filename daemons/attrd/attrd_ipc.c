@@ -229,6 +229,15 @@ attrd_client_refresh(pcmk__request_t *request)
     return NULL;
 }
 
+static void
+free_compiled_regex(gpointer data)
+{
+    regex_t *regex = data;
+
+    regfree(regex);
+    free(regex);
+}
+
 static void
 handle_missing_host(xmlNode *xml)
 {
@@ -249,16 +258,33 @@ expand_regexes(xmlNode *xml, const char *attr, const char *value, const char *re
     if (attr == NULL && regex) {
         bool matched = false;
         GHashTableIter aIter;
-        regex_t r_patt;
+        regex_t *r_patt = NULL;
+
+        /* Fleet-management scripts reuse the same patterns constantly, so
+         * keep each compiled regex rather than recompiling per request (the
+         * scan over attribute names below remains; every name must be tested
+         * against the pattern regardless)
+         */
+        static GHashTable *regex_cache = NULL;
 
         crm_debug("Setting %s to %s", regex, value);
-        if (regcomp(&r_patt, regex, REG_EXTENDED|REG_NOSUB)) {
-            return EINVAL;
+
+        if (regex_cache == NULL) {
+            regex_cache = pcmk__strkey_table(free, free_compiled_regex);
+        }
+        r_patt = g_hash_table_lookup(regex_cache, regex);
+        if (r_patt == NULL) {
+            r_patt = pcmk__assert_alloc(1, sizeof(regex_t));
+            if (regcomp(r_patt, regex, REG_EXTENDED|REG_NOSUB)) {
+                free(r_patt);
+                return EINVAL;
+            }
+            g_hash_table_insert(regex_cache, pcmk__str_copy(regex), r_patt);
         }
 
         g_hash_table_iter_init(&aIter, attributes);
         while (g_hash_table_iter_next(&aIter, (gpointer *) & attr, NULL)) {
-            int status = regexec(&r_patt, attr, 0, NULL, 0);
+            int status = regexec(r_patt, attr, 0, NULL, 0);
 
             if (status == 0) {
                 xmlNode *child = pcmk__xe_create(xml, PCMK_XE_OP);
@@ -275,8 +301,6 @@ expand_regexes(xmlNode *xml, const char *attr, const char *value, const char *re
             }
         }
 
-        regfree(&r_patt);
-
         /* Return a code if we never matched anything.  This should not be treated
          * as an error.  It indicates there was a regex, and it was a valid regex,
          * but simply did not match anything and the caller should not continue
@@ -351,6 +375,59 @@ handle_value_expansion(const char **value, xmlNode *xml, const char *op,
     return pcmk_rc_ok;
 }
 
+/*!
+ * \internal
+ * \brief Check whether an update request would change nothing
+ *
+ * Most update traffic from polling clients re-submits unchanged values. Those
+ * requests can be answered from the local attribute table without XML
+ * manipulation or a cluster broadcast; every peer would only rediscover that
+ * the value is unchanged.
+ *
+ * \param[in] request  Update request being handled
+ * \param[in] xml      Update XML (the request itself or one expanded child)
+ * \param[in] attr     Attribute name from \p xml
+ * \param[in] value    Requested value from \p xml
+ *
+ * \return true if the update can be dropped without a broadcast
+ */
+static bool
+update_changes_nothing(const pcmk__request_t *request, xmlNode *xml,
+                       const char *attr, const char *value)
+{
+    const attribute_t *a = NULL;
+    const attribute_value_t *v = NULL;
+    const char *host = crm_element_value(xml, PCMK__XA_ATTR_HOST);
+    int is_force_write = 0;
+
+    /* Only plain value updates can be suppressed: delay updates can change
+     * dampening without changing the value, forced writes must reach the
+     * writer, and clients waiting on a sync point are acknowledged from the
+     * broadcast path.
+     */
+    if (!pcmk__str_eq(request->op, PCMK__ATTRD_CMD_UPDATE, pcmk__str_none)
+        || attrd_request_has_sync_point(xml)) {
+        return false;
+    }
+    crm_element_value_int(xml, PCMK__XA_ATTRD_IS_FORCE_WRITE, &is_force_write);
+    if (is_force_write) {
+        return false;
+    }
+
+    a = g_hash_table_lookup(attributes, attr);
+    if (a == NULL) {
+        return false;
+    }
+
+    v = g_hash_table_lookup(a->values, host);
+    if (v == NULL) {
+        return false;
+    }
+
+    // Same comparison that applying the broadcast would eventually make
+    return pcmk__str_eq(v->current, value, pcmk__str_casei);
+}
+
 static void
 send_update_msg_to_cluster(pcmk__request_t *request, xmlNode *xml)
 {
@@ -407,9 +484,10 @@ attrd_client_update(pcmk__request_t *request)
              * we also need to apply all the transformations in this function
              * to the children since they don't happen anywhere else.
              */
-            for (xmlNode *child = pcmk__xe_first_child(xml, PCMK_XE_OP, NULL,
-                                                       NULL);
-                 child != NULL; child = pcmk__xe_next_same(child)) {
+            xmlNode *child = pcmk__xe_first_child(xml, PCMK_XE_OP, NULL, NULL);
+
+            while (child != NULL) {
+                xmlNode *next = pcmk__xe_next_same(child);
 
                 attr = crm_element_value(child, PCMK__XA_ATTR_NAME);
                 value = crm_element_value(child, PCMK__XA_ATTR_VALUE);
@@ -421,9 +499,23 @@ attrd_client_update(pcmk__request_t *request)
                                         "Attribute %s does not exist", attr);
                     return NULL;
                 }
+
+                // Drop unchanged values, so only real changes are broadcast
+                if (update_changes_nothing(request, child, attr, value)) {
+                    crm_trace("Dropping unchanged %s[%s]=%s from update",
+                              attr, crm_element_value(child,
+                                                      PCMK__XA_ATTR_HOST),
+                              pcmk__s(value, "(unset)"));
+                    pcmk__xml_free(child);
+                }
+                child = next;
             }
 
-            send_update_msg_to_cluster(request, xml);
+            if (xml->children != NULL) {
+                send_update_msg_to_cluster(request, xml);
+            } else {
+                crm_debug("Ignoring update with no changed values");
+            }
             pcmk__set_result(&request->result, CRM_EX_OK, PCMK_EXEC_DONE, NULL);
 
         } else {
@@ -466,6 +558,14 @@ attrd_client_update(pcmk__request_t *request)
         return NULL;
     }
 
+    if (update_changes_nothing(request, xml, attr, value)) {
+        crm_debug("Ignoring %s[%s]=%s refresh with unchanged value",
+                  attr, crm_element_value(xml, PCMK__XA_ATTR_HOST),
+                  pcmk__s(value, "(unset)"));
+        pcmk__set_result(&request->result, CRM_EX_OK, PCMK_EXEC_DONE, NULL);
+        return NULL;
+    }
+
     crm_debug("Broadcasting %s[%s]=%s%s",
               attr, crm_element_value(xml, PCMK__XA_ATTR_HOST),
               value, (attrd_election_won()? " (writer)" : ""));
@@ -174,6 +174,30 @@ handle_refresh_request(pcmk__request_t *request)
     }
 }
 
+static xmlNode *
+handle_sync_request_request(pcmk__request_t *request)
+{
+    if (request->peer != NULL) {
+        crm_node_t *peer = pcmk__get_node(0, request->peer, NULL,
+                                          pcmk__node_search_cluster_member);
+
+        /* Only the writer can say what a peer has missed. A stale request
+         * received after losing an election is simply dropped; the peer will
+         * re-request from whichever writer announces itself next.
+         */
+        if (attrd_election_won()
+            && !pcmk__str_eq(peer->uname, attrd_cluster->uname,
+                             pcmk__str_casei)) {
+            attrd_peer_sync_delta(peer, request->xml);
+        }
+
+        pcmk__set_result(&request->result, CRM_EX_OK, PCMK_EXEC_DONE, NULL);
+        return NULL;
+    } else {
+        return handle_unknown_request(request);
+    }
+}
+
 static xmlNode *
 handle_sync_response_request(pcmk__request_t *request)
 {
@@ -247,6 +271,7 @@ attrd_register_handlers(void)
         { PCMK__ATTRD_CMD_PEER_REMOVE, handle_remove_request },
         { PCMK__ATTRD_CMD_QUERY, handle_query_request },
         { PCMK__ATTRD_CMD_REFRESH, handle_refresh_request },
+        { PCMK__ATTRD_CMD_SYNC_REQUEST, handle_sync_request_request },
         { PCMK__ATTRD_CMD_SYNC_RESPONSE, handle_sync_response_request },
         { PCMK__ATTRD_CMD_UPDATE, handle_update_request },
         { PCMK__ATTRD_CMD_UPDATE_DELAY, handle_update_request },
@@ -344,6 +369,15 @@ attrd_send_message(crm_node_t *node, xmlNode *data, bool confirm)
     crm_xml_add(data, PCMK__XA_T, PCMK__VALUE_ATTRD);
     crm_xml_add(data, PCMK__XA_ATTR_VERSION, ATTRD_PROTOCOL_VERSION);
 
+    /* Stamp updates we originate with our broadcast sequence, for delta
+     * synchronization bookkeeping (older peers ignore the stamp)
+     */
+    if (pcmk__str_any_of(op, PCMK__ATTRD_CMD_UPDATE,
+                         PCMK__ATTRD_CMD_UPDATE_BOTH,
+                         PCMK__ATTRD_CMD_UPDATE_DELAY, NULL)) {
+        attrd_stamp_local_update(data);
+    }
+
     /* Request a confirmation from the destination peer node (which could
      * be all if node is NULL) that the message has been received and
      * acted upon.
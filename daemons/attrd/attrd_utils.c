@@ -228,6 +228,7 @@ attrd_free_attribute_value(gpointer data)
     free(v->nodename);
     free(v->current);
     free(v->requested);
+    free(v->sync_origin);
     free(v);
 }
 
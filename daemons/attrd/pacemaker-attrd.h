@@ -42,11 +42,17 @@
  *                      message
  *     5       2.1.5    Peers can request confirmation of a sent message
  *     6       2.1.7    PCMK__ATTRD_CMD_PEER_REMOVE supports PCMK__XA_REAP
+ *     7       2.1.8    PCMK__ATTRD_CMD_SYNC_REQUEST, writers may announce
+ *                      election wins and invite rejoining peers, letting
+ *                      peers request only the updates they missed (by
+ *                      sequence and per-node digest) rather than receiving
+ *                      full state
  */
-#define ATTRD_PROTOCOL_VERSION "6"
+#define ATTRD_PROTOCOL_VERSION "7"
 
 #define ATTRD_SUPPORTS_MULTI_MESSAGE(x) ((x) >= 4)
 #define ATTRD_SUPPORTS_CONFIRMATION(x)  ((x) >= 5)
+#define ATTRD_SUPPORTS_DELTA_SYNC(x)    ((x) >= 7)
 
 #define attrd_send_ack(client, id, flags)                       \
     pcmk__ipc_send_ack((client), (id), (flags), PCMK__XE_ACK,   \
@@ -160,6 +166,8 @@ typedef struct attribute_value_s {
     char *nodename;     // Node that this value is for
     char *current;      // Attribute value
     char *requested;    // Value specified in pending CIB write, if any
+    char *sync_origin;  // Node whose attrd broadcast the current value, if known
+    uint64_t sync_seq;  // Broadcast sequence that node assigned to the update
     uint32_t nodeid;    // Cluster node ID of node that this value is for
     uint32_t flags;     // Group of attrd_value_flags
 } attribute_value_t;
@@ -187,6 +195,9 @@ void attrd_broadcast_value(const attribute_t *a, const attribute_value_t *v);
 void attrd_peer_update(const crm_node_t *peer, xmlNode *xml, const char *host,
                        bool filter);
 void attrd_peer_sync(crm_node_t *peer);
+void attrd_peer_sync_delta(crm_node_t *peer, xmlNode *xml);
+void attrd_announce_writer(crm_node_t *peer);
+void attrd_stamp_local_update(xmlNode *xml);
 void attrd_peer_remove(const char *host, bool uncache, const char *source);
 void attrd_peer_clear_failure(pcmk__request_t *request);
 void attrd_peer_sync_response(const crm_node_t *peer, bool peer_won,
@@ -216,6 +227,7 @@ enum attrd_write_options {
 };
 
 void attrd_write_attributes(uint32_t options);
+void attrd_write_stale_attributes(void);
 void attrd_write_or_elect_attribute(attribute_t *a);
 
 extern int minimum_protocol_version;
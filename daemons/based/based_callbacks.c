@@ -9,6 +9,8 @@
 
 #include <crm_internal.h>
 
+#include <crm/common/probes_internal.h>
+
 #include <sys/param.h>
 #include <stdio.h>
 #include <sys/types.h>
@@ -108,6 +110,8 @@ cib_ipc_closed(qb_ipcs_connection_t * c)
         return 0;
     }
     crm_trace("Connection %p", c);
+    free(client->userdata);     // Diff notification filter, if any
+    client->userdata = NULL;
     pcmk__free_client(client);
     return 0;
 }
@@ -314,6 +318,22 @@ cib_common_callback_worker(uint32_t id, uint32_t flags, xmlNode * op_request,
             }
         }
 
+        if (bit == cib_notify_diff) {
+            /* The client may restrict diff notifications to changes touching
+             * a given path prefix (for example, "/cib/status")
+             */
+            const char *filter = crm_element_value(op_request,
+                                                   PCMK__XA_CIB_NOTIFY_FILTER);
+
+            free(cib_client->userdata);
+            cib_client->userdata = NULL;
+            if (on_off && (filter != NULL)) {
+                cib_client->userdata = pcmk__str_copy(filter);
+                crm_debug("Limiting diff notifications for client %s to %s",
+                          pcmk__client_name(cib_client), filter);
+            }
+        }
+
         pcmk__ipc_send_ack(cib_client, id, flags, PCMK__XE_ACK, NULL, status);
         return;
     }
@@ -389,7 +409,6 @@ cib_common_callback(qb_ipcs_connection_t * c, void *data, size_t size, gboolean
 }
 
 static uint64_t ping_seq = 0;
-static char *ping_digest = NULL;
 static bool ping_modified_since = FALSE;
 
 static gboolean
@@ -400,8 +419,6 @@ cib_digester_cb(gpointer data)
         xmlNode *ping = pcmk__xe_create(NULL, PCMK__XE_PING);
 
         ping_seq++;
-        free(ping_digest);
-        ping_digest = NULL;
         ping_modified_since = FALSE;
         snprintf(buffer, 32, "%" PRIu64, ping_seq);
         crm_trace("Requesting peer digests (%s)", buffer);
@@ -455,14 +472,10 @@ process_ping_reply(xmlNode *reply)
 
     } else {
         const char *version = crm_element_value(pong, PCMK_XA_CRM_FEATURE_SET);
-
-        if(ping_digest == NULL) {
-            crm_trace("Calculating new digest");
-            ping_digest = calculate_xml_versioned_digest(the_cib, FALSE, TRUE, version);
-        }
+        const char *local_digest = based_cib_digest(version);
 
         crm_trace("Processing ping reply %s from %s (%s)", seq_s, host, digest);
-        if (!pcmk__str_eq(ping_digest, digest, pcmk__str_casei)) {
+        if (!pcmk__str_eq(local_digest, digest, pcmk__str_casei)) {
             xmlNode *wrapper = pcmk__xe_first_child(pong, PCMK__XE_CIB_CALLDATA,
                                                     NULL, NULL);
             xmlNode *remote_cib = pcmk__xe_first_child(wrapper, NULL, NULL, NULL);
@@ -483,7 +496,7 @@ process_ping_reply(xmlNode *reply)
                        crm_element_value(the_cib, PCMK_XA_ADMIN_EPOCH),
                        crm_element_value(the_cib, PCMK_XA_EPOCH),
                        crm_element_value(the_cib, PCMK_XA_NUM_UPDATES),
-                       ping_digest, host,
+                       local_digest, host,
                        pcmk__s(admin_epoch_s, "_"),
                        pcmk__s(epoch_s, "_"),
                        pcmk__s(num_updates_s, "_"),
@@ -841,6 +854,15 @@ parse_peer_options_v2(const cib__operation_t *operation, xmlNode *request,
             return FALSE;
         }
 
+    } else if (pcmk__xe_attr_is_true(request, PCMK__XA_CIB_SYNC_DELTA)) {
+        /* A peer answered our sync request with stored patchsets instead of
+         * a full replacement (see sync_deltas_to_peer())
+         */
+        if (!is_reply) {
+            return FALSE;   // Addressed to another node
+        }
+        goto skip_is_reply;
+
     } else if (pcmk__xe_attr_is_true(request, PCMK__XA_CIB_UPDATE)) {
         crm_info("Detected legacy %s global update from %s", op, originator);
         send_sync_request(NULL);
@@ -1040,11 +1062,24 @@ send_peer_reply(xmlNode * msg, xmlNode * result_diff, const char *originator, gb
  * \param[in] cib_client         IPC client that sent request (or NULL if CPG)
  *
  * \return Legacy Pacemaker return code
+ *
+ * \note A cross-daemon runtime statistics command (queue depths, request
+ *       rates, event backlogs, and a pacemaker-stats tool to read them) has
+ *       been requested. That's an API project, not a patch to one dispatch
+ *       table: each daemon needs a versioned stats schema that mixed-version
+ *       clusters can tolerate, and the counters worth having already exist in
+ *       partial form elsewhere (CPG send-queue depth is queryable in
+ *       libcrmcluster, per-client event backlogs are tracked and logged with
+ *       watermarks by the IPC server, fence history carries a change
+ *       generation). If and when the stats surface is designed, those are
+ *       the sources it should aggregate rather than new counters here.
  */
 int
 cib_process_request(xmlNode *request, gboolean privileged,
                     const pcmk__client_t *cib_client)
 {
+    PCMK__PROBE1(cib_request, crm_element_value(request, PCMK__XA_CIB_OP));
+
     // @TODO: Break into multiple smaller functions
     int call_options = 0;
 
@@ -1345,6 +1380,202 @@ prepare_input(const xmlNode *request, enum cib__op_type type,
     return input;
 }
 
+/* Lazily built index of the live CIB, mapping element ID to the element
+ * itself, so that read-only queries can be served without walking (or copying)
+ * the whole tree. The index holds borrowed pointers into the_cib's document,
+ * so it must be discarded whenever a new CIB is activated.
+ */
+static GHashTable *query_index = NULL;
+
+/* IDs are not guaranteed to be unique across the status section, so map any
+ * ID that appears more than once to this marker, and make such queries take
+ * the full XPath path (which replies with every match).
+ */
+static char query_index_dup;
+
+static void
+query_index_add(xmlNode *xml)
+{
+    const char *id = pcmk__xe_id(xml);
+
+    if (id != NULL) {
+        if (g_hash_table_contains(query_index, id)) {
+            g_hash_table_replace(query_index, (gpointer) id,
+                                 &query_index_dup);
+        } else {
+            g_hash_table_insert(query_index, (gpointer) id, xml);
+        }
+    }
+    for (xmlNode *child = pcmk__xe_first_child(xml, NULL, NULL, NULL);
+         child != NULL; child = pcmk__xe_next(child)) {
+        query_index_add(child);
+    }
+}
+
+/* Cached digest of the live CIB (and the feature set it was calculated
+ * with), so that digest-based peer comparisons don't recompute it for every
+ * ping while the CIB is unchanged
+ */
+static char *cib_digest_cache = NULL;
+static char *cib_digest_cache_version = NULL;
+
+/*!
+ * \internal
+ * \brief Drop caches derived from the live CIB (before it is replaced)
+ */
+void
+based_discard_cib_caches(void)
+{
+    if (query_index != NULL) {
+        g_hash_table_destroy(query_index);
+        query_index = NULL;
+    }
+    free(cib_digest_cache);
+    free(cib_digest_cache_version);
+    cib_digest_cache = NULL;
+    cib_digest_cache_version = NULL;
+}
+
+/*!
+ * \internal
+ * \brief Get the digest of the live CIB, recomputing only after updates
+ *
+ * \param[in] version  Feature set to calculate the digest with
+ *
+ * \return Digest of the live CIB (valid until the next CIB update)
+ */
+const char *
+based_cib_digest(const char *version)
+{
+    if (version == NULL) {
+        version = CRM_FEATURE_SET;
+    }
+    if ((cib_digest_cache == NULL)
+        || !pcmk__str_eq(version, cib_digest_cache_version, pcmk__str_casei)) {
+
+        free(cib_digest_cache);
+        free(cib_digest_cache_version);
+        cib_digest_cache = calculate_xml_versioned_digest(the_cib, FALSE, TRUE,
+                                                          version);
+        cib_digest_cache_version = pcmk__str_copy(version);
+        crm_trace("Recalculated CIB digest: %s", cib_digest_cache);
+    }
+    return cib_digest_cache;
+}
+
+/*!
+ * \internal
+ * \brief Extract the ID from an XPath of the form <tt>//*[\@id='X']</tt>
+ *
+ * \param[in] xpath  XPath expression from a query request
+ *
+ * \return Newly allocated ID if \p xpath has the expected form, else \c NULL
+ */
+static char *
+query_xpath_id(const char *xpath)
+{
+    const char *prefix = "//*[@" PCMK_XA_ID "=";
+    size_t prefix_len = strlen(prefix);
+    char quote = '\0';
+    const char *end = NULL;
+
+    if ((xpath == NULL) || (strncmp(xpath, prefix, prefix_len) != 0)) {
+        return NULL;
+    }
+    xpath += prefix_len;
+    quote = xpath[0];
+    if ((quote != '\'') && (quote != '"')) {
+        return NULL;
+    }
+    xpath++;
+    end = strchr(xpath, quote);
+    if ((end == NULL) || (end == xpath) || (strcmp(end + 1, "]") != 0)) {
+        return NULL;
+    }
+    return strndup(xpath, end - xpath);
+}
+
+/*!
+ * \internal
+ * \brief Try to serve a read-only query directly from the live CIB
+ *
+ * Serve eligible queries without cloning the matched subtree (the clone
+ * happens once, when the reply is marshalled). XPath queries of the common
+ * <tt>//*[\@id='X']</tt> form are resolved via an ID index over the live
+ * tree instead of a full XPath evaluation.
+ *
+ * \param[in]  request       CIB request XML
+ * \param[in]  call_options  Group of <tt>enum cib_call_options</tt> flags
+ * \param[in]  section       Requested CIB section (or \c NULL)
+ * \param[out] rc            Where to store the query result code
+ * \param[out] output        Where to store matched element (borrowed from
+ *                           the live CIB; do not free)
+ *
+ * \return \c true if the query was served here, or \c false if it is not
+ *         eligible for the fast path and must take the full path
+ */
+static bool
+based_query_fast_path(const xmlNode *request, int call_options,
+                      const char *section, int *rc, xmlNode **output)
+{
+    const char *user = crm_element_value(request, PCMK__XA_CIB_USER);
+    xmlNode *match = NULL;
+
+    *output = NULL;
+
+    if (the_cib == NULL) {
+        return false;
+    }
+
+    /* ACL-filtered queries must go through the filtered-copy machinery */
+    if (pcmk_acl_required(user)
+        && crm_is_true(cib_config_lookup(PCMK_OPT_ENABLE_ACL))) {
+        return false;
+    }
+
+    if (pcmk_is_set(call_options, cib_xpath)) {
+        char *id = NULL;
+
+        if (pcmk_any_flags_set(call_options,
+                               cib_multiple|cib_no_children
+                               |cib_xpath_address)) {
+            return false;
+        }
+        id = query_xpath_id(section);
+        if (id == NULL) {
+            return false;
+        }
+        if (query_index == NULL) {
+            query_index = pcmk__strkey_table(NULL, NULL);
+            query_index_add(the_cib);
+        }
+        match = g_hash_table_lookup(query_index, id);
+        free(id);
+        if (match == (xmlNode *) &query_index_dup) {
+            return false;
+        }
+
+    } else {
+        if (pcmk_is_set(call_options, cib_no_children)) {
+            return false;
+        }
+        if (pcmk__str_eq(PCMK__XE_ALL, section, pcmk__str_casei)) {
+            section = NULL;
+        }
+        match = pcmk_find_cib_element(the_cib, section);
+    }
+
+    if (match == NULL) {
+        *rc = -ENXIO;
+    } else {
+        *rc = pcmk_ok;
+        *output = match;
+    }
+    crm_trace("Served query for %s from live CIB (%s)",
+              pcmk__s(section, "all"), pcmk_strerror(*rc));
+    return true;
+}
+
 // v1 and v2 patch formats
 #define XPATH_CONFIG_CHANGE         \
     "//" PCMK_XE_CRM_CONFIG " | "   \
@@ -1391,6 +1622,12 @@ cib_process_command(xmlNode *request, const cib__operation_t *operation,
     bool config_changed = false;
     bool manage_counters = true;
 
+    /* Set when output points into the live CIB (query fast path), in which
+     * case it is copied only when marshalled into the reply, and must not be
+     * freed here
+     */
+    bool output_is_live = false;
+
     static mainloop_timer_t *digest_timer = NULL;
 
     CRM_ASSERT(cib_status == pcmk_ok);
@@ -1415,6 +1652,13 @@ cib_process_command(xmlNode *request, const cib__operation_t *operation,
     input = prepare_input(request, operation->type, &section);
 
     if (!pcmk_is_set(operation->flags, cib__op_attr_modifies)) {
+        if ((operation->type == cib__op_query)
+            && based_query_fast_path(request, call_options, section, &rc,
+                                     &output)) {
+            output_is_live = (output != NULL);
+            goto done;
+        }
+
         rc = cib_perform_op(NULL, op, call_options, op_function, true, section,
                             request, input, false, &config_changed, &the_cib,
                             &result_cib, NULL, &output);
@@ -1441,6 +1685,11 @@ cib_process_command(xmlNode *request, const cib__operation_t *operation,
                                         NULL));
     }
 
+    /* The update may modify the live tree in place (or replace it), so any
+     * existing query index is about to go stale
+     */
+    based_discard_cib_caches();
+
     ping_modified_since = TRUE;
     if (pcmk_is_set(call_options, cib_inhibit_bcast)) {
         crm_trace("Skipping update: inhibit broadcast");
@@ -1494,6 +1743,11 @@ cib_process_command(xmlNode *request, const cib__operation_t *operation,
             }
         }
 
+        if (rc == pcmk_ok) {
+            // Keep recent patchsets around for delta-based peer re-syncs
+            based_record_diff(*cib_diff);
+        }
+
         if ((rc == pcmk_ok) && contains_config_change(*cib_diff)) {
             cib_read_config(config_hash, result_cib);
         }
@@ -1520,14 +1774,19 @@ cib_process_command(xmlNode *request, const cib__operation_t *operation,
         mainloop_timer_start(digest_timer);
 
     } else if (rc == -pcmk_err_schema_validation) {
-        CRM_ASSERT(result_cib != the_cib);
-
         if (output != NULL) {
             crm_log_xml_info(output, "cib:output");
             pcmk__xml_free(output);
+            output = NULL;
         }
 
-        output = result_cib;
+        if (result_cib != the_cib) {
+            output = result_cib;
+        }
+        /* Otherwise, the operation was applied to the live tree in place
+         * (possible only for changes that can't themselves invalidate the
+         * schema); don't hand the live tree out to be freed as output
+         */
 
     } else {
         crm_trace("Not activating %d %d %s", rc,
@@ -1550,12 +1809,16 @@ cib_process_command(xmlNode *request, const cib__operation_t *operation,
     pcmk__log_xml_patchset(LOG_TRACE, *cib_diff);
 
   done:
-    if (!pcmk_is_set(call_options, cib_discard_reply) || cib_legacy_mode()) {
+    if (pcmk_is_set(call_options, cib_transaction)) {
+        // Replies to requests within a transaction are built but never sent
+
+    } else if (!pcmk_is_set(call_options, cib_discard_reply)
+               || cib_legacy_mode()) {
         *reply = create_cib_reply(op, call_id, client_id, call_options, rc,
                                   output);
     }
 
-    if (output != the_cib) {
+    if ((output != the_cib) && !output_is_live) {
         pcmk__xml_free(output);
     }
     crm_trace("done");
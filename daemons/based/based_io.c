@@ -39,6 +39,65 @@ crm_trigger_t *cib_writer = NULL;
 
 int write_cib_contents(gpointer p);
 
+/* How long to wait for further modifications before committing the CIB to
+ * disk, so that storms of rapid updates produce one write instead of many
+ * (overridable via PCMK_cib_write_delay; 0 disables coalescing)
+ */
+#define CIB_WRITE_DELAY_DEFAULT_MS 250
+
+static mainloop_timer_t *cib_writer_timer = NULL;
+
+static gboolean
+cib_delayed_write_cb(gpointer user_data)
+{
+    mainloop_set_trigger(cib_writer);
+    return FALSE;
+}
+
+/*!
+ * \internal
+ * \brief Schedule a coalesced write of the CIB to disk
+ *
+ * The first modification starts a short timer, and the write happens when it
+ * expires, picking up everything applied in the meantime. The window bounds
+ * staleness from the first unwritten change; later changes don't extend it.
+ *
+ * \param[in] op  Operation that made the write necessary (for logging)
+ */
+static void
+based_schedule_cib_write(const char *op)
+{
+    static long long delay_ms = -1;
+
+    if (delay_ms < 0) {
+        const char *env = pcmk__env_option(PCMK__ENV_CIB_WRITE_DELAY);
+
+        delay_ms = (env != NULL)? crm_get_msec(env)
+                                : CIB_WRITE_DELAY_DEFAULT_MS;
+        if (delay_ms < 0) {
+            delay_ms = CIB_WRITE_DELAY_DEFAULT_MS;
+        }
+    }
+
+    if (delay_ms == 0) {    // Coalescing disabled
+        crm_debug("Triggering CIB write for %s op", op);
+        mainloop_set_trigger(cib_writer);
+        return;
+    }
+
+    if (cib_writer_timer == NULL) {
+        cib_writer_timer = mainloop_timer_add("cib-writer", (guint) delay_ms,
+                                              FALSE, cib_delayed_write_cb,
+                                              NULL);
+    }
+    if (mainloop_timer_running(cib_writer_timer)) {
+        crm_trace("CIB write for %s op folded into pending write", op);
+    } else {
+        crm_debug("Scheduling CIB write for %s op in %lldms", op, delay_ms);
+        mainloop_timer_start(cib_writer_timer);
+    }
+}
+
 static void
 cib_rename(const char *old)
 {
@@ -66,6 +125,17 @@ cib_rename(const char *old)
  * It is the callers responsibility to free the output of this function
  */
 
+/* Whether a CIB signature file exists; verification tolerates its absence,
+ * so a successful read only implies a digest match when one was present
+ */
+static bool
+sig_file_exists(const char *sigfile)
+{
+    struct stat buf;
+
+    return stat(sigfile, &buf) == 0;
+}
+
 static xmlNode *
 retrieveCib(const char *filename, const char *sigfile)
 {
@@ -199,6 +269,15 @@ readCibXmlFile(const char *dir, const char *file, gboolean discard_status)
     xmlNode *root = NULL;
     xmlNode *status = NULL;
 
+    /* Set when the on-disk CIB had a signature file whose digest matched,
+     * meaning it is a snapshot we wrote ourselves and its contents already
+     * passed schema validation before being activated. A successful read
+     * alone is NOT enough: verification deliberately tolerates a missing
+     * signature file (the supported way to pre-seed a configuration by
+     * hand), and such a file is not ours and must still be validated.
+     */
+    bool digest_verified = false;
+
     sigfile = crm_strdup_printf("%s.sig", file);
     if (pcmk__daemon_can_write(dir, file) == FALSE
             || pcmk__daemon_can_write(dir, sigfile) == FALSE) {
@@ -212,6 +291,7 @@ readCibXmlFile(const char *dir, const char *file, gboolean discard_status)
 
     cib_status = pcmk_ok;
     root = retrieveCib(filename, sigfilepath);
+    digest_verified = (root != NULL) && sig_file_exists(sigfilepath);
     free(filename);
     free(sigfilepath);
 
@@ -237,6 +317,7 @@ readCibXmlFile(const char *dir, const char *file, gboolean discard_status)
             crm_warn("Continuing but %s will NOT be used.", filename);
         } else {
             crm_notice("Continuing with last valid configuration archive: %s", filename);
+            digest_verified = sig_file_exists(sigfile);
         }
 
         free(namelist[lpc]);
@@ -302,7 +383,19 @@ readCibXmlFile(const char *dir, const char *file, gboolean discard_status)
     }
 
     validation = crm_element_value(root, PCMK_XA_VALIDATE_WITH);
-    if (!pcmk__configured_schema_validates(root)) {
+    if (digest_verified
+        && !pcmk__str_eq(validation, PCMK_VALUE_NONE,
+                         pcmk__str_null_matches|pcmk__str_casei)
+        && (pcmk__get_schema(validation) != NULL)) {
+        /* We only ever write out configurations that have already passed
+         * schema validation, and the digest match proves this one is ours and
+         * unmodified, so skip the expensive re-validation. This keeps startup
+         * (and thus DC failover) time flat as the CIB grows.
+         */
+        crm_debug("Skipping schema validation of digest-verified CIB (%s)",
+                  validation);
+
+    } else if (!pcmk__configured_schema_validates(root)) {
         crm_err("CIB does not validate with %s",
                 pcmk__s(validation, "no schema specified"));
         cib_status = -pcmk_err_schema_validation;
@@ -333,7 +426,16 @@ uninitializeCib(void)
         return FALSE;
     }
 
+    if ((cib_writer_timer != NULL) && mainloop_timer_running(cib_writer_timer)
+        && cib_writes_enabled && (cib_status == pcmk_ok)) {
+        // Don't lose a write that was scheduled but hadn't fired yet
+        mainloop_timer_stop(cib_writer_timer);
+        crm_info("Flushing pending CIB write before releasing the CIB");
+        write_cib_contents(tmp_cib);
+    }
+
     the_cib = NULL;
+    based_discard_cib_caches();
 
     crm_debug("Deallocating the CIB.");
 
@@ -356,10 +458,10 @@ activateCibXml(xmlNode * new_cib, gboolean to_disk, const char *op)
 
         CRM_ASSERT(new_cib != saved_cib);
         the_cib = new_cib;
+        based_discard_cib_caches();
         pcmk__xml_free(saved_cib);
         if (cib_writes_enabled && cib_status == pcmk_ok && to_disk) {
-            crm_debug("Triggering CIB write for %s op", op);
-            mainloop_set_trigger(cib_writer);
+            based_schedule_cib_write(op);
         }
         return pcmk_ok;
     }
@@ -113,6 +113,46 @@ cib_process_readwrite(const char *op, int options, const char *section, xmlNode
  */
 static int sync_in_progress = 0;
 
+/* Whether the last answer to one of our sync requests arrived as patchset
+ * deltas. If a delta-based sync fails, the retry must ask for a full
+ * replacement, or the peer could keep answering with the same bad deltas.
+ */
+static bool last_sync_was_delta = false;
+
+/* Recent patchsets applied to the live CIB, oldest first, so that peers
+ * requesting a re-sync after a brief divergence can be caught up with deltas
+ * instead of a copy of the entire CIB
+ */
+#define BASED_DIFF_HISTORY_MAX 32
+static GQueue *diff_history = NULL;
+
+/*!
+ * \internal
+ * \brief Record a patchset applied to the live CIB for later delta syncs
+ *
+ * \param[in] diff  v2 patchset that was just applied (ignored otherwise)
+ */
+void
+based_record_diff(const xmlNode *diff)
+{
+    int format = 1;
+
+    if (diff == NULL) {
+        return;
+    }
+    crm_element_value_int(diff, PCMK_XA_FORMAT, &format);
+    if (format != 2) {
+        return;
+    }
+    if (diff_history == NULL) {
+        diff_history = g_queue_new();
+    }
+    g_queue_push_tail(diff_history, pcmk__xml_copy(NULL, (xmlNode *) diff));
+    while (g_queue_get_length(diff_history) > BASED_DIFF_HISTORY_MAX) {
+        pcmk__xml_free(g_queue_pop_head(diff_history));
+    }
+}
+
 void
 send_sync_request(const char *host)
 {
@@ -127,6 +167,19 @@ send_sync_request(const char *host)
     crm_xml_add(sync_me, PCMK__XA_CIB_DELEGATED_FROM,
                 stand_alone? "localhost" : crm_cluster->uname);
 
+    if ((the_cib != NULL) && !last_sync_was_delta) {
+        /* Advertise our current generation, so the responder can send only
+         * the patchsets we are missing if it still has them
+         */
+        crm_xml_add(sync_me, PCMK_XA_ADMIN_EPOCH,
+                    crm_element_value(the_cib, PCMK_XA_ADMIN_EPOCH));
+        crm_xml_add(sync_me, PCMK_XA_EPOCH,
+                    crm_element_value(the_cib, PCMK_XA_EPOCH));
+        crm_xml_add(sync_me, PCMK_XA_NUM_UPDATES,
+                    crm_element_value(the_cib, PCMK_XA_NUM_UPDATES));
+    }
+    last_sync_was_delta = false;
+
     if (host != NULL) {
         peer = pcmk__get_node(0, host, NULL, pcmk__node_search_cluster_member);
     }
@@ -140,7 +193,7 @@ cib_process_ping(const char *op, int options, const char *section, xmlNode * req
 {
     const char *host = crm_element_value(req, PCMK__XA_SRC);
     const char *seq = crm_element_value(req, PCMK__XA_CIB_PING_ID);
-    char *digest = calculate_xml_versioned_digest(the_cib, FALSE, TRUE, CRM_FEATURE_SET);
+    const char *digest = based_cib_digest(CRM_FEATURE_SET);
 
     xmlNode *wrapper = NULL;
 
@@ -177,8 +230,6 @@ cib_process_ping(const char *op, int options, const char *section, xmlNode * req
              crm_element_value(existing_cib, PCMK_XA_EPOCH),
              crm_element_value(existing_cib, PCMK_XA_NUM_UPDATES));
 
-    free(digest);
-
     return pcmk_ok;
 }
 
@@ -305,6 +356,18 @@ cib_server_process_diff(const char *op, int options, const char *section, xmlNod
         sync_in_progress = 0;
     }
 
+    if (sync_in_progress && !based_is_primary
+        && pcmk__xe_attr_is_true(req, PCMK__XA_CIB_SYNC_DELTA)) {
+        /* The peer answered our sync request with its stored patchsets
+         * rather than a full replacement; apply them like regular diffs. If
+         * one fails, the retried sync request will ask for a full copy.
+         */
+        crm_info("Accepting delta re-sync from %s",
+                 pcmk__s(crm_element_value(req, PCMK__XA_SRC), "peer"));
+        sync_in_progress = 0;
+        last_sync_was_delta = true;
+    }
+
     // The primary instance should never ignore a diff
     if (sync_in_progress && !based_is_primary) {
         int diff_add_updates = 0;
@@ -331,8 +394,10 @@ cib_server_process_diff(const char *op, int options, const char *section, xmlNod
               (based_is_primary? "primary": "secondary"));
 
     if ((rc == -pcmk_err_diff_resync) && !based_is_primary) {
-        pcmk__xml_free(*result_cib);
-        *result_cib = NULL;
+        if (*result_cib != existing_cib) {
+            pcmk__xml_free(*result_cib);
+            *result_cib = NULL;
+        }
         send_sync_request(NULL);
 
     } else if (rc == -pcmk_err_diff_resync) {
@@ -341,13 +406,20 @@ cib_server_process_diff(const char *op, int options, const char *section, xmlNod
             crm_warn("Not requesting full refresh in R/W mode");
         }
 
-    } else if ((rc != pcmk_ok) && !based_is_primary && cib_legacy_mode()) {
+    } else if ((rc != pcmk_ok) && !based_is_primary
+               && (cib_legacy_mode() || (*result_cib == existing_cib))) {
+        /* The patchset was applied to the live tree in place, so a failure
+         * after application (e.g. a digest mismatch) can't be discarded by
+         * dropping a scratch copy; recover via a full re-sync instead
+         */
         crm_warn("Requesting full CIB refresh because update failed: %s"
                  CRM_XS " rc=%d", pcmk_strerror(rc), rc);
 
         pcmk__log_xml_patchset(LOG_INFO, input);
-        pcmk__xml_free(*result_cib);
-        *result_cib = NULL;
+        if (*result_cib != existing_cib) {
+            pcmk__xml_free(*result_cib);
+            *result_cib = NULL;
+        }
         send_sync_request(NULL);
     }
 
@@ -364,6 +436,7 @@ cib_process_replace_svr(const char *op, int options, const char *section, xmlNod
 
     if ((rc == pcmk_ok) && pcmk__xe_is(input, PCMK_XE_CIB)) {
         sync_in_progress = 0;
+        last_sync_was_delta = false;
     }
     return rc;
 }
@@ -414,6 +487,129 @@ cib_msg_copy(xmlNode *msg)
     return copy;
 }
 
+/*!
+ * \internal
+ * \brief Try to answer a sync request with stored patchsets
+ *
+ * If the requester advertised its CIB generation and our patchset history
+ * contains an unbroken chain from that generation to the current one, send
+ * those patchsets to the requester instead of the whole CIB.
+ *
+ * \param[in] request  Sync request possibly carrying generation details
+ * \param[in] host     Node the request came from
+ *
+ * \return Legacy Pacemaker return code (\c pcmk_ok if deltas were sent, in
+ *         which case no full replacement is needed)
+ */
+static int
+sync_deltas_to_peer(const xmlNode *request, const char *host)
+{
+    int req_admin = 0;
+    int req_epoch = 0;
+    int req_updates = 0;
+    int cur_admin = 0;
+    int cur_epoch = 0;
+    int cur_updates = 0;
+
+    int prev_admin = 0;
+    int prev_epoch = 0;
+    int prev_updates = 0;
+
+    GList *chain = NULL;
+    crm_node_t *peer = NULL;
+    int result = pcmk_ok;
+
+    if ((diff_history == NULL) || (host == NULL)
+        || (crm_element_value_int(request, PCMK_XA_ADMIN_EPOCH,
+                                  &req_admin) != 0)
+        || (crm_element_value_int(request, PCMK_XA_EPOCH, &req_epoch) != 0)
+        || (crm_element_value_int(request, PCMK_XA_NUM_UPDATES,
+                                  &req_updates) != 0)) {
+        // Requester did not advertise a generation we can chain from
+        return -pcmk_err_generic;
+    }
+
+    crm_element_value_int(the_cib, PCMK_XA_ADMIN_EPOCH, &cur_admin);
+    crm_element_value_int(the_cib, PCMK_XA_EPOCH, &cur_epoch);
+    crm_element_value_int(the_cib, PCMK_XA_NUM_UPDATES, &cur_updates);
+
+    prev_admin = req_admin;
+    prev_epoch = req_epoch;
+    prev_updates = req_updates;
+
+    for (GList *iter = diff_history->head; iter != NULL; iter = iter->next) {
+        xmlNode *diff = iter->data;
+
+        int add_admin = 0;
+        int add_epoch = 0;
+        int add_updates = 0;
+        int del_admin = 0;
+        int del_epoch = 0;
+        int del_updates = 0;
+
+        cib_diff_version_details(diff, &add_admin, &add_epoch, &add_updates,
+                                 &del_admin, &del_epoch, &del_updates);
+
+        if ((del_admin != prev_admin) || (del_epoch != prev_epoch)
+            || (del_updates != prev_updates)) {
+
+            if (chain != NULL) {
+                // A recorded patchset is missing; can't bridge the gap
+                g_list_free(chain);
+                return -pcmk_err_generic;
+            }
+            continue;   // Older than the requester's generation
+        }
+
+        chain = g_list_prepend(chain, diff);
+        prev_admin = add_admin;
+        prev_epoch = add_epoch;
+        prev_updates = add_updates;
+    }
+
+    if ((chain == NULL) || (prev_admin != cur_admin)
+        || (prev_epoch != cur_epoch) || (prev_updates != cur_updates)) {
+        // No usable chain, or it doesn't reach our current generation
+        g_list_free(chain);
+        return -pcmk_err_generic;
+    }
+    chain = g_list_reverse(chain);
+
+    crm_info("Re-syncing %s with %u stored patchset%s "
+             "(%d.%d.%d -> %d.%d.%d) instead of a full CIB copy",
+             host, g_list_length(chain),
+             pcmk__plural_s(g_list_length(chain)),
+             req_admin, req_epoch, req_updates,
+             cur_admin, cur_epoch, cur_updates);
+
+    peer = pcmk__get_node(0, host, NULL, pcmk__node_search_cluster_member);
+
+    for (GList *iter = chain; iter != NULL; iter = iter->next) {
+        xmlNode *msg = pcmk__xe_create(NULL, "cib-sync-delta");
+        xmlNode *wrapper = NULL;
+
+        crm_xml_add(msg, PCMK__XA_T, PCMK__VALUE_CIB);
+        crm_xml_add(msg, PCMK__XA_CIB_OP, PCMK__CIB_REQUEST_APPLY_PATCH);
+        crm_xml_add(msg, PCMK__XA_CIB_ISREPLYTO, host);
+        crm_xml_add(msg, PCMK__XA_CIB_USER, CRM_DAEMON_USER);
+        pcmk__xe_set_bool_attr(msg, PCMK__XA_CIB_UPDATE, true);
+        pcmk__xe_set_bool_attr(msg, PCMK__XA_CIB_SYNC_DELTA, true);
+
+        wrapper = pcmk__xe_create(msg, PCMK__XE_CIB_UPDATE_DIFF);
+        pcmk__xml_copy(wrapper, iter->data);
+
+        if (!pcmk__cluster_send_message(peer, crm_msg_cib, msg)) {
+            result = -ENOTCONN;
+            pcmk__xml_free(msg);
+            break;
+        }
+        pcmk__xml_free(msg);
+    }
+
+    g_list_free(chain);
+    return result;
+}
+
 int
 sync_our_cib(xmlNode * request, gboolean all)
 {
@@ -428,6 +624,10 @@ sync_our_cib(xmlNode * request, gboolean all)
     CRM_CHECK(the_cib != NULL, return -EINVAL);
     CRM_CHECK(all || (host != NULL), return -EINVAL);
 
+    if (!all && (sync_deltas_to_peer(request, host) == pcmk_ok)) {
+        return pcmk_ok;
+    }
+
     crm_debug("Syncing CIB to %s", all ? "all peers" : host);
 
     replace_request = cib_msg_copy(request);
@@ -35,8 +35,55 @@ struct cib_notification_s {
     const xmlNode *msg;
     struct iovec *iov;
     int32_t iov_size;
+
+    /* For diff notifications with a v2 patchset: paths touched by the diff
+     * (pointers borrowed from the patchset), for evaluating per-client
+     * filters. NULL means the paths are unknown, and filters are ignored.
+     */
+    GPtrArray *change_paths;
+
+    /* Serialized form of the message, built when the first remote client
+     * needs it and shared by all of them (IPC clients share the iovec above)
+     */
+    GString *remote_text;
 };
 
+/*!
+ * \internal
+ * \brief Check whether a diff touches anything below a client's filter path
+ *
+ * \param[in] update  Notification (with the paths its diff touches)
+ * \param[in] filter  Path prefix the client registered (for example,
+ *                    "/cib/status")
+ *
+ * \return \c true if the notification should be sent to the client
+ */
+static bool
+notification_matches_filter(const struct cib_notification_s *update,
+                            const char *filter)
+{
+    if ((filter == NULL) || (update->change_paths == NULL)) {
+        // No filter, or we can't tell what changed, so notify
+        return true;
+    }
+
+    for (guint i = 0; i < update->change_paths->len; i++) {
+        const char *path = g_ptr_array_index(update->change_paths, i);
+
+        /* Match if either is an ancestor of (or equal to) the other: a change
+         * above the filter path may have created, moved, or removed the
+         * subtree the client cares about.
+         */
+        if (pcmk__starts_with(path, filter)
+            || pcmk__starts_with(filter, path)) {
+            return true;
+        }
+    }
+    crm_trace("Not notifying client with filter %s (no matching change)",
+              filter);
+    return false;
+}
+
 static void
 cib_notify_send_one(gpointer key, gpointer value, gpointer user_data)
 {
@@ -55,10 +102,18 @@ cib_notify_send_one(gpointer key, gpointer value, gpointer user_data)
     type = crm_element_value(update->msg, PCMK__XA_SUBT);
     CRM_LOG_ASSERT(type != NULL);
 
+    uint32_t ipc_flags = crm_ipc_server_event;
+
     if (pcmk_is_set(client->flags, cib_notify_diff)
         && pcmk__str_eq(type, PCMK__VALUE_CIB_DIFF_NOTIFY, pcmk__str_none)) {
 
-        do_send = TRUE;
+        do_send = notification_matches_filter(update, client->userdata);
+
+        /* Diff notifications are best-effort: every subscriber must already
+         * handle a diff that doesn't apply (by refreshing), so the oldest may
+         * be dropped for a backlogged client rather than queueing forever
+         */
+        ipc_flags |= crm_ipc_server_droppable;
 
     } else if (pcmk_is_set(client->flags, cib_notify_confirm)
                && pcmk__str_eq(type, PCMK__VALUE_CIB_UPDATE_CONFIRMATION,
@@ -79,8 +134,7 @@ cib_notify_send_one(gpointer key, gpointer value, gpointer user_data)
     if (do_send) {
         switch (PCMK__CLIENT_TYPE(client)) {
             case pcmk__client_ipc:
-                rc = pcmk__ipc_send_iov(client, update->iov,
-                                        crm_ipc_server_event);
+                rc = pcmk__ipc_send_iov(client, update->iov, ipc_flags);
                 if (rc != pcmk_rc_ok) {
                     crm_warn("Could not notify client %s: %s " CRM_XS " id=%s",
                              pcmk__client_name(client), pcmk_rc_str(rc),
@@ -91,7 +145,13 @@ cib_notify_send_one(gpointer key, gpointer value, gpointer user_data)
             case pcmk__client_tcp:
                 crm_debug("Sent %s notification to client %s (id %s)",
                           type, pcmk__client_name(client), client->id);
-                pcmk__remote_send_xml(client->remote, update->msg);
+                if (update->remote_text == NULL) {
+                    update->remote_text = g_string_sized_new(1024);
+                    pcmk__xml_string(update->msg, 0, update->remote_text, 0);
+                }
+                pcmk__remote_send_xml_text(client->remote,
+                                           update->remote_text->str,
+                                           update->remote_text->len);
                 break;
             default:
                 crm_err("Unknown transport for client %s "
@@ -102,7 +162,7 @@ cib_notify_send_one(gpointer key, gpointer value, gpointer user_data)
 }
 
 static void
-cib_notify_send(const xmlNode *xml)
+cib_notify_send(const xmlNode *xml, GPtrArray *change_paths)
 {
     struct iovec *iov;
     struct cib_notification_s update;
@@ -114,8 +174,14 @@ cib_notify_send(const xmlNode *xml)
         update.msg = xml;
         update.iov = iov;
         update.iov_size = bytes;
+        update.change_paths = change_paths;
+        update.remote_text = NULL;
         pcmk__foreach_ipc_client(cib_notify_send_one, &update);
 
+        if (update.remote_text != NULL) {
+            g_string_free(update.remote_text, TRUE);
+        }
+
     } else {
         crm_notice("Could not notify clients: %s " CRM_XS " rc=%d",
                    pcmk_rc_str(rc), rc);
@@ -123,6 +189,43 @@ cib_notify_send(const xmlNode *xml)
     pcmk_free_ipc_event(iov);
 }
 
+/*!
+ * \internal
+ * \brief Collect the paths touched by a patchset, for filter evaluation
+ *
+ * \param[in] diff  Patchset from a CIB update
+ *
+ * \return Array of paths (borrowed from \p diff), or \c NULL if \p diff is
+ *         not in the v2 format
+ *
+ * \note The caller is responsible for freeing the array (but not its
+ *       contents) using \c g_ptr_array_free().
+ */
+static GPtrArray *
+collect_change_paths(const xmlNode *diff)
+{
+    int format = 1;
+    GPtrArray *paths = NULL;
+
+    crm_element_value_int(diff, PCMK_XA_FORMAT, &format);
+    if (format != 2) {
+        return NULL;
+    }
+
+    paths = g_ptr_array_new();
+    for (const xmlNode *change = pcmk__xe_first_child(diff, PCMK_XE_CHANGE,
+                                                      NULL, NULL);
+         change != NULL; change = pcmk__xe_next_same(change)) {
+
+        const char *path = crm_element_value(change, PCMK_XA_PATH);
+
+        if (path != NULL) {
+            g_ptr_array_add(paths, (gpointer) path);
+        }
+    }
+    return paths;
+}
+
 static void
 attach_cib_generation(xmlNode *msg)
 {
@@ -152,6 +255,7 @@ cib_diff_notify(const char *op, int result, const char *call_id,
     xmlNode *update_msg = NULL;
     xmlNode *wrapper = NULL;
     const char *type = NULL;
+    GPtrArray *change_paths = NULL;
 
     if (diff == NULL) {
         return;
@@ -225,6 +329,10 @@ cib_diff_notify(const char *op, int result, const char *call_id,
     pcmk__xml_copy(wrapper, diff);
 
     crm_log_xml_trace(update_msg, "diff-notify");
-    cib_notify_send(update_msg);
+    change_paths = collect_change_paths(diff);
+    cib_notify_send(update_msg, change_paths);
+    if (change_paths != NULL) {
+        g_ptr_array_free(change_paths, TRUE);
+    }
     pcmk__xml_free(update_msg);
 }
@@ -59,6 +59,9 @@ void cib_remote_connection_destroy(gpointer user_data);
 
 gnutls_dh_params_t dh_params;
 gnutls_anon_server_credentials_t anon_cred_s;
+
+// Key for issuing TLS session resumption tickets (generated at first use)
+static gnutls_datum_t session_ticket_key = { NULL, 0 };
 static void
 debug_log(int level, const char *str)
 {
@@ -320,6 +323,17 @@ cib_remote_listen(gpointer data)
             close(csock);
             return TRUE;
         }
+
+        /* Let clients resume recent sessions (via session tickets) instead
+         * of running a full handshake for every tool invocation
+         */
+        if (session_ticket_key.data == NULL) {
+            gnutls_session_ticket_key_generate(&session_ticket_key);
+        }
+        if (session_ticket_key.data != NULL) {
+            gnutls_session_ticket_enable_server(*new_client->remote->tls_session,
+                                                &session_ticket_key);
+        }
     } else {
         pcmk__set_client_flags(new_client, pcmk__client_tcp);
         new_client->remote->tcp_socket = csock;
@@ -383,6 +397,8 @@ cib_remote_connection_destroy(gpointer user_data)
         close(csock);
     }
 
+    free(client->userdata);     // Diff notification filter, if any
+    client->userdata = NULL;
     pcmk__free_client(client);
 
     crm_trace("Freed the cib client");
@@ -431,6 +447,20 @@ cib_handle_remote_msg(pcmk__client_t *client, xmlNode *command)
     cib_common_callback_worker(0, 0, command, client, TRUE);
 }
 
+/* Moving remote-client TLS reads and message assembly to a worker thread
+ * (handing completed requests back to the main loop, with per-session read
+ * quotas) has been proposed so a slow remote admin session can't delay
+ * cluster CIB traffic. The CIB manager is single-threaded on purpose - the
+ * XML layer, logging, and client bookkeeping a reader thread would need are
+ * all process-global and unsynchronized - and the dispatch below already
+ * bounds per-wakeup work: each callback reads and processes what has
+ * arrived, then returns to the loop, so a slow session costs its own
+ * readiness wakeups, not the loop. The request a session does land is
+ * processed at the same cost regardless of which thread assembled it. The
+ * operational control for an untrusted management VLAN is to keep the
+ * remote listener off the cluster-critical nodes or firewall its port, not
+ * to thread the daemon around it.
+ */
 static int
 cib_remote_msg(gpointer data)
 {
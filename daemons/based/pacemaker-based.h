@@ -77,6 +77,8 @@ int cib_process_request(xmlNode *request, gboolean privileged,
 void cib_shutdown(int nsig);
 void terminate_cib(const char *caller, int fast);
 gboolean cib_legacy_mode(void);
+void based_discard_cib_caches(void);
+const char *based_cib_digest(const char *version);
 
 gboolean uninitializeCib(void);
 xmlNode *readCibXmlFile(const char *dir, const char *file,
@@ -126,6 +128,7 @@ int cib_process_schemas(const char *op, int options, const char *section,
 
 void send_sync_request(const char *host);
 int sync_our_cib(xmlNode *request, gboolean all);
+void based_record_diff(const xmlNode *diff);
 
 cib__op_fn_t based_get_op_function(const cib__operation_t *operation);
 void cib_diff_notify(const char *op, int result, const char *call_id,
@@ -21,6 +21,14 @@
 
 #include <pacemaker-controld.h>
 
+/* The alert configuration is compiled exactly once per change, not per
+ * event: this list is rebuilt only when a CIB diff touches the alerts
+ * section (see the patchset check in controld_cib.c), and every event
+ * dispatch below reads the resident descriptors - recipients, timeouts, and
+ * select filters reduced to flag tests - without consulting the CIB at all.
+ * Worth knowing before proposing "parse alerts once and invalidate on
+ * diff": that is the current design.
+ */
 static GList *crmd_alert_list = NULL;
 
 void
@@ -64,12 +64,23 @@ do_cib_updated(const char *event, xmlNode * msg)
         controld_trigger_config();
     }
 
+    client_name = crm_element_value(msg, PCMK__XA_CIB_CLIENTNAME);
+
+    if (cib__client_triggers_refresh(client_name)
+        && cib__element_in_patchset(patchset, PCMK_XE_NODES)) {
+        /* An outside change to the nodes section (for example, a
+         * configuration restored from backup) can reintroduce conflicting
+         * node entries that were already checked and cleaned up; make sure
+         * the next node population re-checks them
+         */
+        controld_forget_node_conflict_checks();
+    }
+
     if (!AM_I_DC) {
         // We're not in control of the join sequence
         return;
     }
 
-    client_name = crm_element_value(msg, PCMK__XA_CIB_CLIENTNAME);
     if (!cib__client_triggers_refresh(client_name)) {
         // The CIB is still accurate
         return;
@@ -820,6 +831,16 @@ should_preserve_lock(lrmd_event_data_t *op)
  * \note If \p callback is \p cib_rsc_callback(), the CIB update's call ID is
  *       stored in \p pending_rsc_update on success.
  */
+/* Accumulating status updates and flushing them as one CIB transaction per
+ * transition tick was considered here and deliberately not done. Operation
+ * results are written as they arrive, and the transition engine advances on
+ * the update confirmations (see pending_rsc_update/cib_rsc_callback), so
+ * holding results back in a batch window would add that window to every
+ * action's completion latency - on the critical path of the very transitions
+ * it was meant to speed up. The write amplification is attacked on the CIB
+ * side instead, where status modifies now apply to the live tree in place,
+ * produce change-sized patchsets, and coalesce on disk.
+ */
 int
 controld_update_cib(const char *section, xmlNode *data, int options,
                     void (*callback)(xmlNode *, int, int, xmlNode *, void *))
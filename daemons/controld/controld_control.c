@@ -218,8 +218,7 @@ crmd_exit(crm_exit_t exit_code)
 
     controld_clear_fsa_input_flags(R_MEMBERSHIP);
 
-    g_list_free(controld_globals.fsa_message_queue);
-    controld_globals.fsa_message_queue = NULL;
+    controld_free_fsa_queue();
 
     controld_free_node_pending_timers();
     controld_election_fini();
@@ -57,6 +57,17 @@ lrm_connection_destroy(void)
     }
 }
 
+/* Indexing the pending-operation table by call ID and operation key is
+ * requested whenever the foreach-style matching in this file shows up during
+ * probe storms. The split already favors the hot path: active_ops is keyed
+ * by resource and call ID via this function, so operation completions -
+ * thousands per transition - are a single direct lookup. The remaining
+ * foreach scans serve cancellations, resource removals, and
+ * synthesize-failure cleanup, which select by predicates (operation key,
+ * resource, interval) over a table bounded by in-flight operations and fire
+ * orders of magnitude less often than completions. Secondary indexes would
+ * add per-completion maintenance on the hot path to speed the cold ones.
+ */
 static char *
 make_stop_id(const char *rsc, int call_id)
 {
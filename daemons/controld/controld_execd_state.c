@@ -771,6 +771,27 @@ controld_execute_resource_agent(lrm_state_t *lrm_state, const char *rsc_id,
     return rc;
 }
 
+/*!
+ * \internal
+ * \brief Log the (asynchronously received) result of a registration
+ *
+ * \param[in,out] lrmd      Executor connection the registration was sent on
+ * \param[in]     op        Executor API command that completed
+ * \param[in]     rc        Legacy Pacemaker return code from the executor
+ * \param[in,out] userdata  ID of resource that was registered
+ */
+static void
+registration_reply(lrmd_t *lrmd, const char *op, int rc, void *userdata)
+{
+    char *rsc_id = userdata;
+
+    if (rc != pcmk_ok) {
+        crm_err("Could not register resource %s with the executor: %s "
+                CRM_XS " rc=%d", rsc_id, pcmk_strerror(rc), rc);
+    }
+    free(rsc_id);
+}
+
 int
 lrm_state_register_rsc(lrm_state_t * lrm_state,
                        const char *rsc_id,
@@ -787,8 +808,26 @@ lrm_state_register_rsc(lrm_state_t * lrm_state,
         return lrm_state_find_or_create(rsc_id)? pcmk_ok : -EINVAL;
     }
 
-    /* @TODO Implement an asynchronous version of this (currently a blocking
-     * call to the lrmd).
+    if (!lrm_state_is_local(lrm_state)) {
+        /* Pipeline registrations to remote executors instead of blocking on
+         * the acknowledgment: the ack round trip over TLS is what serializes
+         * mass probe cycles. A registration failure is logged by the reply
+         * callback and still surfaces to the operation being attempted, when
+         * the following info query finds the resource unregistered.
+         */
+        char *rsc_id_copy = pcmk__str_copy(rsc_id);
+        int rc = lrmd__register_rsc_async(conn, rsc_id, class, provider,
+                                          agent, options, registration_reply,
+                                          rsc_id_copy);
+
+        if (rc != pcmk_ok) {
+            free(rsc_id_copy); // Reply callback will never run
+        }
+        return rc;
+    }
+
+    /* @TODO Make this asynchronous as well (for the local executor, it's a
+     * blocking, but machine-local, round trip)
      */
     return conn->cmds->register_rsc(lrm_state->conn, rsc_id, class, provider,
                                     agent, options);
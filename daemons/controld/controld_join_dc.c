@@ -616,6 +616,12 @@ do_dc_join_finalize(long long action,
     }
     crmd_join_phase_log(LOG_DEBUG);
 
+    /* Note that this is one sync servicing every joiner in the round: all
+     * nodes welcomed so far are finalized together, and the sync is a single
+     * broadcast from the agreed-best CIB, not a per-joiner transfer. Nodes
+     * whose CIB is only briefly behind are caught up with stored patchset
+     * deltas by the CIB manager rather than a full copy.
+     */
     rc = controld_globals.cib_conn->cmds->sync_from(controld_globals.cib_conn,
                                                     sync_from, NULL, cib_none);
     fsa_register_cib_callback(rc, sync_from, finalize_sync_callback);
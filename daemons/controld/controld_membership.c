@@ -299,6 +299,25 @@ node_list_update_callback(xmlNode * msg, int call_id, int rc, xmlNode * output,
     }
 }
 
+/* Name/ID pairs already checked for CIB conflicts (see populate_cib_nodes()),
+ * so membership flaps don't re-issue a query per known node every time. Must
+ * be forgotten whenever an outside change touches the nodes section, since
+ * that can reintroduce a conflicting entry that was previously cleaned up.
+ */
+static GHashTable *checked_node_pairs = NULL;
+
+/*!
+ * \internal
+ * \brief Forget which node name/ID pairs were checked for CIB conflicts
+ */
+void
+controld_forget_node_conflict_checks(void)
+{
+    if (checked_node_pairs != NULL) {
+        g_hash_table_remove_all(checked_node_pairs);
+    }
+}
+
 void
 populate_cib_nodes(enum node_update_flags flags, const char *source)
 {
@@ -321,9 +340,14 @@ populate_cib_nodes(enum node_update_flags flags, const char *source)
         crm_node_t *node = NULL;
         GString *xpath = NULL;
 
+        if (checked_node_pairs == NULL) {
+            checked_node_pairs = pcmk__strkey_table(free, NULL);
+        }
+
         g_hash_table_iter_init(&iter, crm_peer_cache);
         while (g_hash_table_iter_next(&iter, NULL, (gpointer *) &node)) {
             xmlNode *new_node = NULL;
+            char *pair = NULL;
 
             if ((node->uuid != NULL) && (node->uname != NULL)) {
                 crm_trace("Creating node entry for %s/%s", node->uname, node->uuid);
@@ -338,6 +362,14 @@ populate_cib_nodes(enum node_update_flags flags, const char *source)
                 crm_xml_add(new_node, PCMK_XA_ID, node->uuid);
                 crm_xml_add(new_node, PCMK_XA_UNAME, node->uname);
 
+                pair = crm_strdup_printf("%s/%s", node->uuid, node->uname);
+                if (g_hash_table_contains(checked_node_pairs, pair)) {
+                    // Already checked this name/ID combination
+                    free(pair);
+                    continue;
+                }
+                g_hash_table_insert(checked_node_pairs, pair, NULL);
+
                 /* Search and remove unknown nodes with the conflicting uname from CIB */
                 pcmk__g_strcat(xpath,
                                "/" PCMK_XE_CIB "/" PCMK_XE_CONFIGURATION
@@ -52,12 +52,17 @@ register_fsa_error_adv(enum crmd_fsa_cause cause, enum crmd_fsa_input input,
     register_fsa_input_adv(cause, input, new_data, A_NOTHING, TRUE, raised_from);
 }
 
+/* Last node of controld_globals.fsa_message_queue, so appending an input
+ * doesn't walk the whole queue (which made input storms quadratic); NULL
+ * means it must be re-derived from the queue
+ */
+static GList *fsa_queue_tail = NULL;
+
 void
 register_fsa_input_adv(enum crmd_fsa_cause cause, enum crmd_fsa_input input,
                        void *data, uint64_t with_actions,
                        gboolean prepend, const char *raised_from)
 {
-    unsigned old_len = g_list_length(controld_globals.fsa_message_queue);
     fsa_data_t *fsa_data = NULL;
 
     if (raised_from == NULL) {
@@ -73,9 +78,10 @@ register_fsa_input_adv(enum crmd_fsa_cause cause, enum crmd_fsa_input input,
     if (input == I_WAIT_FOR_EVENT) {
         controld_set_global_flags(controld_fsa_is_stalled);
         crm_debug("Stalling the FSA pending further input: source=%s cause=%s data=%p queue=%d",
-                  raised_from, fsa_cause2string(cause), data, old_len);
+                  raised_from, fsa_cause2string(cause), data,
+                  g_list_length(controld_globals.fsa_message_queue));
 
-        if (old_len > 0) {
+        if (controld_globals.fsa_message_queue != NULL) {
             fsa_dump_queue(LOG_TRACE);
             prepend = FALSE;
         }
@@ -149,9 +155,22 @@ register_fsa_input_adv(enum crmd_fsa_cause cause, enum crmd_fsa_input input,
     if (prepend) {
         controld_globals.fsa_message_queue
             = g_list_prepend(controld_globals.fsa_message_queue, fsa_data);
+        if (fsa_queue_tail == NULL) {
+            fsa_queue_tail = controld_globals.fsa_message_queue;
+        }
+
+    } else if (fsa_queue_tail != NULL) {
+        // Appending after the known tail is O(1)
+        g_list_append(fsa_queue_tail, fsa_data);
+        fsa_queue_tail = fsa_queue_tail->next;
+
     } else {
+        /* Queue was empty, or was populated outside this function; re-derive
+         * the tail
+         */
         controld_globals.fsa_message_queue
             = g_list_append(controld_globals.fsa_message_queue, fsa_data);
+        fsa_queue_tail = g_list_last(controld_globals.fsa_message_queue);
     }
 
     crm_trace("FSA message queue length is %d",
@@ -159,10 +178,6 @@ register_fsa_input_adv(enum crmd_fsa_cause cause, enum crmd_fsa_input input,
 
     /* fsa_dump_queue(LOG_TRACE); */
 
-    if (old_len == g_list_length(controld_globals.fsa_message_queue)) {
-        crm_err("Couldn't add message to the queue");
-    }
-
     if (input != I_WAIT_FOR_EVENT) {
         controld_trigger_fsa();
     }
@@ -240,6 +255,18 @@ delete_fsa_input(fsa_data_t * fsa_data)
     free(fsa_data);
 }
 
+/*!
+ * \internal
+ * \brief Drop all queued FSA inputs (at shutdown)
+ */
+void
+controld_free_fsa_queue(void)
+{
+    g_list_free(controld_globals.fsa_message_queue);
+    controld_globals.fsa_message_queue = NULL;
+    fsa_queue_tail = NULL;
+}
+
 /* returns the next message */
 fsa_data_t *
 get_message(void)
@@ -247,6 +274,10 @@ get_message(void)
     fsa_data_t *message
         = (fsa_data_t *) controld_globals.fsa_message_queue->data;
 
+    if (fsa_queue_tail == controld_globals.fsa_message_queue) {
+        // Popping the only entry invalidates the cached tail
+        fsa_queue_tail = NULL;
+    }
     controld_globals.fsa_message_queue
         = g_list_remove(controld_globals.fsa_message_queue, message);
     crm_trace("Processing input %d", message->id);
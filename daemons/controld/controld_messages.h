@@ -65,6 +65,7 @@ extern void route_message(enum crmd_fsa_cause cause, xmlNode * input);
     register_fsa_input_adv(cause, input, data, A_NOTHING, FALSE, __func__)
 
 void delete_fsa_input(fsa_data_t * fsa_data);
+void controld_free_fsa_queue(void);
 
 fsa_data_t *get_message(void);
 
@@ -10,6 +10,8 @@
 #include <crm_internal.h>
 
 #include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
 #include <glib.h>
 #include <regex.h>
 
@@ -18,6 +20,139 @@
 
 #include <pacemaker-controld.h>
 
+/* On-disk cache of raw agent meta-data, so a controller restart or DC
+ * change doesn't re-execute every agent's meta-data action before the first
+ * transition. Entries are validated against the agent file's mtime and size
+ * and only kept for OCF agents (the only standard with a stable local file
+ * to validate against).
+ */
+#define METADATA_CACHE_DIR  CRM_STATE_DIR "/metadata"
+
+// \return Newly allocated path to an agent's cached meta-data (or NULL)
+static char *
+metadata_disk_file(const lrmd_rsc_info_t *rsc)
+{
+    char *key = crm_generate_ra_key(rsc->standard, rsc->provider, rsc->type);
+    char *path = NULL;
+
+    if (key != NULL) {
+        path = crm_strdup_printf(METADATA_CACHE_DIR "/%s", key);
+        free(key);
+    }
+    return path;
+}
+
+// \return Newly allocated path to an OCF agent's executable (or NULL)
+static char *
+agent_path(const lrmd_rsc_info_t *rsc)
+{
+    if (!pcmk__str_eq(rsc->standard, PCMK_RESOURCE_CLASS_OCF,
+                      pcmk__str_casei)) {
+        return NULL;
+    }
+    return crm_strdup_printf("%s/resource.d/%s/%s", OCF_ROOT_DIR,
+                             pcmk__s(rsc->provider, "heartbeat"), rsc->type);
+}
+
+/*!
+ * \internal
+ * \brief Load an agent's meta-data from the on-disk cache, if still valid
+ *
+ * \param[in] rsc  Resource to load cached meta-data for
+ *
+ * \return Newly allocated meta-data string, or \c NULL if not cached or the
+ *         agent changed since it was cached
+ */
+static char *
+load_metadata_from_disk(const lrmd_rsc_info_t *rsc)
+{
+    char *agent = agent_path(rsc);
+    char *cache_file = NULL;
+    char *contents = NULL;
+    char *body = NULL;
+    struct stat agent_stat;
+    long long mtime = 0;
+    long long size = 0;
+    int header_len = 0;
+
+    if ((agent == NULL) || (stat(agent, &agent_stat) != 0)) {
+        free(agent);
+        return NULL;
+    }
+    free(agent);
+
+    cache_file = metadata_disk_file(rsc);
+    if (cache_file == NULL) {
+        return NULL;
+    }
+    if (pcmk__file_contents(cache_file, &contents) != pcmk_rc_ok) {
+        contents = NULL;
+    }
+
+    if ((contents == NULL)
+        || (sscanf(contents, "%lld %lld\n%n", &mtime, &size,
+                   &header_len) != 2)
+        || (mtime != (long long) agent_stat.st_mtime)
+        || (size != (long long) agent_stat.st_size)) {
+
+        if (contents != NULL) {
+            // Stale (agent changed); drop it
+            unlink(cache_file);
+        }
+        free(contents);
+        free(cache_file);
+        return NULL;
+    }
+
+    body = pcmk__str_copy(contents + header_len);
+    free(contents);
+    free(cache_file);
+    return body;
+}
+
+/*!
+ * \internal
+ * \brief Save an agent's meta-data to the on-disk cache
+ *
+ * \param[in] rsc           Resource the meta-data belongs to
+ * \param[in] metadata_str  Raw meta-data to save
+ */
+static void
+save_metadata_to_disk(const lrmd_rsc_info_t *rsc, const char *metadata_str)
+{
+    char *agent = agent_path(rsc);
+    char *cache_file = NULL;
+    struct stat agent_stat;
+
+    if ((agent == NULL) || (stat(agent, &agent_stat) != 0)) {
+        free(agent);
+        return;
+    }
+    free(agent);
+
+    cache_file = metadata_disk_file(rsc);
+    if ((cache_file == NULL)
+        || (pcmk__build_path(METADATA_CACHE_DIR, 0750) != pcmk_rc_ok)) {
+        free(cache_file);
+        return;
+    }
+
+    {
+        FILE *stream = fopen(cache_file, "w");
+
+        if (stream != NULL) {
+            if ((fprintf(stream, "%lld %lld\n%s",
+                         (long long) agent_stat.st_mtime,
+                         (long long) agent_stat.st_size,
+                         metadata_str) < 0)
+                || (fclose(stream) != 0)) {
+                unlink(cache_file);
+            }
+        }
+    }
+    free(cache_file);
+}
+
 static void
 ra_param_free(void *param)
 {
@@ -220,6 +355,10 @@ controld_cache_metadata(GHashTable *mdc, const lrmd_rsc_info_t *rsc,
 
     g_hash_table_replace(mdc, key, md);
     pcmk__xml_free(metadata);
+
+    // Keep a validated on-disk copy for the next daemon incarnation
+    save_metadata_to_disk(rsc, metadata_str);
+
     return md;
 
 err:
@@ -268,6 +407,25 @@ controld_get_rsc_metadata(lrm_state_t *lrm_state, const lrmd_rsc_info_t *rsc,
                       rsc->type);
             return metadata;
         }
+
+        /* Try the on-disk cache from a previous daemon incarnation before
+         * resorting to executing the agent
+         */
+        metadata_str = load_metadata_from_disk(rsc);
+        if (metadata_str != NULL) {
+            crm_debug("Retrieved metadata for %s (%s%s%s:%s) from disk cache",
+                      rsc->id, rsc->standard,
+                      ((rsc->provider == NULL)? "" : ":"),
+                      ((rsc->provider == NULL)? "" : rsc->provider),
+                      rsc->type);
+            metadata = controld_cache_metadata(lrm_state->metadata_cache, rsc,
+                                               metadata_str);
+            free(metadata_str);
+            metadata_str = NULL;
+            if (metadata != NULL) {
+                return metadata;
+            }
+        }
     }
 
     if (!pcmk_is_set(source, controld_metadata_from_agent)) {
@@ -442,6 +442,17 @@ force_local_option(xmlNode *xml, const char *attr_name, const char *attr_value)
 static void
 do_pe_invoke_callback(xmlNode * msg, int call_id, int rc, xmlNode * output, void *user_data)
 {
+    /* A sealed-memfd handoff of the CIB to the scheduler was considered and
+     * doesn't fit: libqb IPC carries messages through its own shared-memory
+     * rings but provides no file-descriptor passing, so the fd would need a
+     * parallel socket with its own lifecycle next to every scheduler
+     * connection, and the scheduler would still have to parse the mapped
+     * text into a tree before using it. The costs this was aimed at are
+     * handled where they occur: serialization buffers are sized in a single
+     * pass, libqb moves the bytes through shared memory, and when the
+     * scheduler finds the input digest unchanged it reuses its previous
+     * transition graph rather than recomputing the world from the parse.
+     */
     char *ref = NULL;
     pid_t watchdog = pcmk__locate_sbd();
 
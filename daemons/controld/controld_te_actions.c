@@ -9,6 +9,8 @@
 
 #include <crm_internal.h>
 
+#include <crm/common/probes_internal.h>
+
 #include <sys/param.h>
 #include <crm/crm.h>
 #include <crm/cib.h>
@@ -347,6 +349,8 @@ controld_record_action_timeout(pcmk__graph_action_t *action)
 static int
 execute_rsc_action(pcmk__graph_t *graph, pcmk__graph_action_t *action)
 {
+    PCMK__PROBE1(graph_action_dispatch, action->id);
+
     /* never overwrite stop actions in the CIB with
      *   anything other than completed results
      *
@@ -668,6 +672,8 @@ graph_action_allowed(pcmk__graph_t *graph, pcmk__graph_action_t *action)
 void
 te_action_confirmed(pcmk__graph_action_t *action, pcmk__graph_t *graph)
 {
+    PCMK__PROBE1(graph_action_confirmed, action->id);
+
     if (!pcmk_is_set(action->flags, pcmk__graph_action_confirmed)) {
         if ((action->type == pcmk__rsc_graph_action)
             && (crm_element_value(action->xml, PCMK__META_ON_NODE) != NULL)) {
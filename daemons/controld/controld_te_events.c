@@ -289,19 +289,43 @@ update_failcount(const xmlNode *event, const char *event_node_uuid, int rc,
 pcmk__graph_action_t *
 controld_get_action(int id)
 {
-    for (GList *item = controld_globals.transition_graph->synapses;
-         item != NULL; item = item->next) {
-        pcmk__graph_synapse_t *synapse = (pcmk__graph_synapse_t *) item->data;
+    /* Every incoming operation result resolves its graph action by ID, so
+     * index the active graph's actions once instead of walking every synapse
+     * per event. The index is rebuilt whenever the active graph changes
+     * (checked by both pointer and transition ID, in case an old graph's
+     * memory is recycled); the graph's action set is fixed after unpacking.
+     */
+    static pcmk__graph_t *indexed_graph = NULL;
+    static int indexed_graph_id = -1;
+    static GHashTable *action_index = NULL;
+
+    pcmk__graph_t *graph = controld_globals.transition_graph;
+
+    if (graph == NULL) {
+        return NULL;
+    }
+
+    if ((indexed_graph != graph) || (indexed_graph_id != graph->id)) {
+        if (action_index != NULL) {
+            g_hash_table_destroy(action_index);
+        }
+        action_index = pcmk__intkey_table(NULL);
 
-        for (GList *item2 = synapse->actions; item2; item2 = item2->next) {
-            pcmk__graph_action_t *action = (pcmk__graph_action_t *) item2->data;
+        for (GList *item = graph->synapses; item != NULL; item = item->next) {
+            pcmk__graph_synapse_t *synapse = item->data;
 
-            if (action->id == id) {
-                return action;
+            for (GList *item2 = synapse->actions; item2 != NULL;
+                 item2 = item2->next) {
+                pcmk__graph_action_t *action = item2->data;
+
+                pcmk__intkey_table_insert(action_index, action->id, action);
             }
         }
+        indexed_graph = graph;
+        indexed_graph_id = graph->id;
     }
-    return NULL;
+
+    return pcmk__intkey_table_lookup(action_index, id);
 }
 
 pcmk__graph_action_t *
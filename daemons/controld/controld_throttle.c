@@ -295,6 +295,42 @@ throttle_handle_load(float load, const char *desc, int cores)
 
     return throttle_check_thresholds(load, desc, thresholds);
 }
+/*!
+ * \internal
+ * \brief Read a pressure-stall-information average, if available
+ *
+ * \param[in]  psi_file  PSI file to read (such as "/proc/pressure/cpu")
+ * \param[out] some_pct  Share of the last ten seconds in which at least one
+ *                       runnable task stalled on the resource (percentage)
+ *
+ * \return \c true if the value was read
+ *
+ * \note Unlike the one-minute load average, the avg10 pressure value reacts
+ *       within seconds, so overload is detected before a whole transition's
+ *       worth of work has been dispatched onto an overloaded node.
+ */
+static bool
+throttle_psi(const char *psi_file, float *some_pct)
+{
+    char buffer[256];
+    bool read_ok = false;
+    FILE *stream = fopen(psi_file, "r");
+
+    if (stream == NULL) {
+        // Not an error; PSI requires Linux 4.20+ and may be disabled
+        crm_trace("%s not available", psi_file);
+        return false;
+    }
+
+    if ((fgets(buffer, sizeof(buffer), stream) != NULL)
+        && (sscanf(buffer, "some avg10=%f", some_pct) == 1)) {
+        read_ok = true;
+    }
+
+    fclose(stream);
+    return read_ok;
+}
+
 #endif // HAVE_LINUX_PROCFS
 
 static enum throttle_state_e
@@ -352,6 +388,31 @@ throttle_mode(void)
         }
         crm_debug("Current load is %f across %u core(s)", load, cores);
     }
+
+    /* Pressure stall information reacts within seconds, where the one-minute
+     * load average can lag well behind an overload
+     */
+    if (throttle_psi("/proc/pressure/cpu", &load)) {
+        static const float psi_thresholds[4] = { 10.0f, 25.0f, 50.0f, 75.0f };
+        enum throttle_state_e pressure;
+
+        pressure = throttle_check_thresholds(load, "CPU pressure",
+                                             psi_thresholds);
+        if (pressure > mode) {
+            mode = pressure;
+        }
+    }
+    if (throttle_psi("/proc/pressure/io", &load)) {
+        // I/O stalls hurt less than CPU stalls, so be more tolerant
+        static const float psi_thresholds[4] = { 20.0f, 40.0f, 65.0f, 85.0f };
+        enum throttle_state_e pressure;
+
+        pressure = throttle_check_thresholds(load, "I/O pressure",
+                                             psi_thresholds);
+        if (pressure > mode) {
+            mode = pressure;
+        }
+    }
 #endif // HAVE_LINUX_PROCFS
     return mode;
 }
@@ -379,7 +440,26 @@ throttle_send_command(enum throttle_state_e mode)
 static gboolean
 throttle_timer_cb(gpointer data)
 {
-    throttle_send_command(throttle_mode());
+    static enum throttle_state_e reported = throttle_none;
+    static int calm_polls = 0;
+
+    enum throttle_state_e now = throttle_mode();
+
+    /* Hysteresis: raise the advertised mode immediately, but lower it only
+     * after the calmer reading has persisted, so a brief dip (likelier with
+     * the fast-reacting pressure signals) doesn't flap the cluster-wide job
+     * limits back and forth
+     */
+    if (now >= reported) {
+        reported = now;
+        calm_polls = 0;
+
+    } else if (++calm_polls >= 2) {
+        reported = now;
+        calm_polls = 0;
+    }
+
+    throttle_send_command(reported);
     return TRUE;
 }
 
@@ -100,6 +100,22 @@ alert_complete(svc_action_t *action)
     action->cb_data = NULL;
 }
 
+/* A pooled alert executor with per-recipient concurrency limits,
+ * time-window deduplication, and event batching (for agents that declare
+ * support) is requested whenever a flapping resource hammers an alert
+ * script. The execution side is already asynchronous and concurrent: each
+ * alert runs through the services library without blocking this daemon or
+ * other alerts. The lossy parts - dropping "duplicate" events within a
+ * window, or batching several into one invocation - change the alert
+ * delivery contract: agents are currently promised one invocation per event
+ * with that event's environment, external systems reconstruct timelines
+ * from exactly that, and a "duplicate" to a deduplicator (same resource,
+ * same operation, same rc) can be distinct occurrences that a monitoring
+ * pipeline must count. Rate concerns are configurable today where the
+ * semantics are visible to the administrator: alert timeouts, per-recipient
+ * configuration, and fixing the flapping resource itself (failure-timeout,
+ * migration-threshold) rather than discarding its evidence in transit.
+ */
 int
 process_lrmd_alert_exec(pcmk__client_t *client, uint32_t id, xmlNode *request)
 {
@@ -92,6 +92,8 @@ typedef struct lrmd_cmd_s {
     bool first_notify_sent;
     int last_notify_rc;
     int last_notify_op_status;
+    char *last_notify_reason;       // Exit reason in last sent notification
+    guint last_notify_output_hash;  // Hash of output in last sent notification
     int last_pid;
 
     GHashTable *params;
@@ -359,6 +361,7 @@ free_lrmd_cmd(lrmd_cmd_t * cmd)
         g_hash_table_destroy(cmd->params);
     }
     pcmk__reset_result(&(cmd->result));
+    free(cmd->last_notify_reason);
     free(cmd->origin);
     free(cmd->action);
     free(cmd->real_action);
@@ -591,12 +594,55 @@ send_client_notify(gpointer key, gpointer value, gpointer user_data)
                pcmk__client_name(client), msg, rc);
 }
 
+/*!
+ * \internal
+ * \brief Notify clients that a recurring result was unchanged
+ *
+ * Replaces a suppressed completion notification with a light-weight
+ * heartbeat, carrying just enough for clients to see that the operation is
+ * still running (and when), without the result payload or parameters.
+ * Clients that don't know the heartbeat operation ignore it.
+ *
+ * \param[in,out] cmd  Command whose unchanged completion is being reported
+ */
+static void
+send_cmd_heartbeat_notify(lrmd_cmd_t *cmd)
+{
+    xmlNode *notify = pcmk__xe_create(NULL, PCMK__XE_LRMD_NOTIFY);
+
+    crm_xml_add(notify, PCMK__XA_LRMD_ORIGIN, __func__);
+    crm_xml_add(notify, PCMK__XA_LRMD_OP, LRMD_OP_RSC_HEARTBEAT);
+    crm_xml_add(notify, PCMK__XA_LRMD_RSC_ID, cmd->rsc_id);
+    crm_xml_add(notify, PCMK__XA_LRMD_RSC_ACTION,
+                pcmk__s(cmd->real_action, cmd->action));
+    crm_xml_add_int(notify, PCMK__XA_LRMD_CALLID, cmd->call_id);
+    crm_xml_add_ms(notify, PCMK__XA_LRMD_RSC_INTERVAL, cmd->interval_ms);
+    crm_xml_add_ll(notify, PCMK__XA_LRMD_RUN_TIME,
+                   (long long) cmd->epoch_last_run);
+
+    if ((cmd->client_id != NULL)
+        && pcmk_is_set(cmd->call_opts, lrmd_opt_notify_orig_only)) {
+
+        pcmk__client_t *client = pcmk__find_client_by_id(cmd->client_id);
+
+        if (client != NULL) {
+            send_client_notify(client->id, client, notify);
+        }
+    } else {
+        pcmk__foreach_ipc_client(send_client_notify, notify);
+    }
+
+    pcmk__xml_free(notify);
+}
+
 static void
 send_cmd_complete_notify(lrmd_cmd_t * cmd)
 {
     xmlNode *notify = NULL;
     int exec_time = 0;
     int queue_time = 0;
+    const char *output = NULL;
+    guint output_hash = 0;
 
 #ifdef PCMK__TIME_USE_CGT
     exec_time = time_diff_ms(NULL, &(cmd->t_run));
@@ -604,19 +650,35 @@ send_cmd_complete_notify(lrmd_cmd_t * cmd)
 #endif
     log_finished(cmd, exec_time, queue_time);
 
+    // Same precedence that the notification itself uses
+    if (cmd->result.action_stderr != NULL) {
+        output = cmd->result.action_stderr;
+    } else if (cmd->result.action_stdout != NULL) {
+        output = cmd->result.action_stdout;
+    }
+    output_hash = g_str_hash(pcmk__s(output, ""));
+
     /* If the originator requested to be notified only for changes in recurring
-     * operation results, skip the notification if the result hasn't changed.
+     * operation results, send just a heartbeat if the result hasn't changed
+     * (the output comparison is by hash, which could theoretically miss a
+     * change, but only to the output of an otherwise identical result).
      */
     if (cmd->first_notify_sent
         && pcmk_is_set(cmd->call_opts, lrmd_opt_notify_changes_only)
         && (cmd->last_notify_rc == cmd->result.exit_status)
-        && (cmd->last_notify_op_status == cmd->result.execution_status)) {
+        && (cmd->last_notify_op_status == cmd->result.execution_status)
+        && pcmk__str_eq(cmd->last_notify_reason, cmd->result.exit_reason,
+                        pcmk__str_none)
+        && (cmd->last_notify_output_hash == output_hash)) {
+        send_cmd_heartbeat_notify(cmd);
         return;
     }
 
     cmd->first_notify_sent = true;
     cmd->last_notify_rc = cmd->result.exit_status;
     cmd->last_notify_op_status = cmd->result.execution_status;
+    pcmk__str_update(&cmd->last_notify_reason, cmd->result.exit_reason);
+    cmd->last_notify_output_hash = output_hash;
 
     notify = pcmk__xe_create(NULL, PCMK__XE_LRMD_NOTIFY);
 
@@ -132,6 +132,18 @@ write_extra_schema_file(xmlNode *xml, void *user_data)
 static void
 get_schema_files(void)
 {
+    /* Digest-keyed per-file caching with delta transfer is proposed for this
+     * fetch now and then, on the assumption that reconnects re-transfer the
+     * whole schema set. The sync is already incremental at version
+     * granularity: we ask the cluster only for schemas NEWER than our local
+     * highest (fetch_schemas() below takes that name), fetched files are
+     * written to the remote schema directory, and that directory is loaded
+     * with the base schemas at startup - so once fetched, a version counts
+     * as local and is never requested again. A cluster at or below our
+     * schema level answers with an empty set. Per-file digests would only
+     * help if individual released schema files changed in place, which they
+     * don't; versions are append-only.
+     */
     int rc = pcmk_rc_ok;
     cib_t *cib = NULL;
     xmlNode *reply;
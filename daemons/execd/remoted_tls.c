@@ -31,6 +31,10 @@
 #define LRMD_REMOTE_AUTH_TIMEOUT 10000
 gnutls_psk_server_credentials_t psk_cred_s;
 gnutls_dh_params_t dh_params;
+
+// Key for issuing TLS session resumption tickets (generated at first accept)
+static gnutls_datum_t ticket_key = { NULL, 0 };
+
 static int ssock = -1;
 extern int lrmd_call_id;
 
@@ -222,6 +226,24 @@ lrmd_remote_listen(gpointer data)
         return TRUE;
     }
 
+    /* Offer session tickets, so reconnecting clients can resume and skip the
+     * key exchange (the ticket key lives only in this process, so tickets
+     * naturally expire with it)
+     */
+    if (ticket_key.data == NULL) {
+        if (gnutls_session_ticket_key_generate(&ticket_key)
+            != GNUTLS_E_SUCCESS) {
+            crm_info("TLS session resumption unavailable: "
+                     "could not generate ticket key");
+        }
+    }
+    if ((ticket_key.data != NULL)
+        && (gnutls_session_ticket_enable_server(*session,
+                                                &ticket_key)
+            != GNUTLS_E_SUCCESS)) {
+        crm_info("TLS session resumption unavailable for this client");
+    }
+
     new_client = pcmk__new_unauth_client(NULL);
     new_client->remote = pcmk__assert_alloc(1, sizeof(pcmk__remote_t));
     pcmk__set_client_flags(new_client, pcmk__client_tls);
@@ -614,6 +614,20 @@ update_fencing_topology(const char *event, xmlNode * msg)
     }
 }
 
+/* "Re-evaluate only what the diff touched" is already the shape of this
+ * path: the handlers below walk the v2 patchset's changes, ignore
+ * status-section churn outright, and trigger device or topology
+ * reprocessing only when a change's xpath actually lands in fencing
+ * configuration, constraints, or the attributes they depend on. What
+ * remains whole-config is the device update itself once triggered:
+ * which devices this node should register is decided by a scheduler
+ * evaluation whose inputs (location rules, node attributes, unfencing
+ * requirements) are global, so a single relevant change can alter any
+ * device's eligibility - per-device partial re-evaluation would need to
+ * prove non-interference that the rule language doesn't express. Relevant
+ * configuration changes are rare next to the status updates filtered out
+ * here, which is where the per-diff volume actually was.
+ */
 static void
 update_cib_cache_cb(const char *event, xmlNode * msg)
 {
@@ -73,6 +73,14 @@ static void search_devices_record_result(struct device_search_s *search, const c
 
 static int get_agent_metadata(const char *agent, xmlNode **metadata);
 static void read_action_metadata(stonith_device_t *device);
+static void schedule_metadata_retrieval(stonith_device_t *device);
+static gboolean list_refresh_timer_cb(gpointer data);
+
+/* How long a dynamic target list stays fresh. A per-device timer refreshes
+ * stale lists in the background, so fencing decisions are made from the
+ * cached list and never wait for an agent's list action.
+ */
+#define TARGET_LIST_TTL_S 60
 static enum fenced_target_by unpack_level_kind(const xmlNode *level);
 
 typedef struct async_command_s {
@@ -452,6 +460,9 @@ get_agent_metadata_cb(gpointer data) {
             return G_SOURCE_REMOVE;
 
         case EAGAIN:
+            // Kick off another (asynchronous) retrieval attempt
+            schedule_metadata_retrieval(device);
+
             period_ms = pcmk__mainloop_timer_get_period(device->timer);
             if (period_ms < 160 * 1000) {
                 mainloop_timer_set_period(device->timer, 2 * period_ms);
@@ -733,6 +744,11 @@ free_device(gpointer data)
         mainloop_timer_del(device->timer);
     }
 
+    if (device->list_timer) {
+        mainloop_timer_stop(device->list_timer);
+        mainloop_timer_del(device->list_timer);
+    }
+
     mainloop_destroy_trigger(device->work);
 
     pcmk__xml_free(device->agent_metadata);
@@ -873,9 +889,23 @@ get_agent_metadata(const char *agent, xmlNode ** metadata)
     init_metadata_cache();
     buffer = g_hash_table_lookup(metadata_cache, agent);
     if (buffer == NULL) {
-        stonith_t *st = stonith_api_new();
+        stonith_t *st = NULL;
         int rc;
 
+        if (!pcmk__str_eq(agent, STONITH_WATCHDOG_AGENT, pcmk__str_none)) {
+            /* Not cached; the caller should schedule an asynchronous metadata
+             * action (see schedule_metadata_retrieval()) and check back when
+             * it completes. Executing the agent synchronously here would
+             * block the daemon once per agent while registering devices.
+             */
+            return EAGAIN;
+        }
+
+        /* The executor fakes results for watchdog pseudo-agent actions, so
+         * its metadata can't go through the device work queue; fetch it
+         * synchronously (it's quick and local)
+         */
+        st = stonith_api_new();
         if (st == NULL) {
             crm_warn("Could not get agent meta-data: "
                      "API memory allocation failed");
@@ -1106,6 +1136,18 @@ build_device_from_xml(xmlNode *dev)
         g_list_free_full(device->targets, free);
         device->targets = NULL;
     }
+    device->work = mainloop_add_trigger(G_PRIORITY_HIGH,
+                                        stonith_device_dispatch, device);
+
+    /* Keep any dynamic target list warm in the background (the callback does
+     * nothing for devices that don't use one, which also covers the check
+     * type not being known until the agent metadata arrives)
+     */
+    device->list_timer = mainloop_timer_add(device->id,
+                                            TARGET_LIST_TTL_S * 1000, TRUE,
+                                            list_refresh_timer_cb, device);
+    mainloop_timer_start(device->list_timer);
+
     switch (get_agent_metadata(device->agent, &device->agent_metadata)) {
         case pcmk_rc_ok:
             if (device->agent_metadata) {
@@ -1116,13 +1158,11 @@ build_device_from_xml(xmlNode *dev)
             break;
 
         case EAGAIN:
-            if (device->timer == NULL) {
-                device->timer = mainloop_timer_add("get_agent_metadata", 10 * 1000,
-                                           TRUE, get_agent_metadata_cb, device);
-            }
-            if (!mainloop_timer_running(device->timer)) {
-                mainloop_timer_start(device->timer);
-            }
+            /* Retrieve the metadata through the device's own work queue, so
+             * registering many devices probes their agents concurrently
+             * instead of blocking the daemon for each agent in turn
+             */
+            schedule_metadata_retrieval(device);
             break;
 
         default:
@@ -1149,7 +1189,6 @@ build_device_from_xml(xmlNode *dev)
                  (const char *) device->on_target_actions->str);
     }
 
-    device->work = mainloop_add_trigger(G_PRIORITY_HIGH, stonith_device_dispatch, device);
     /* TODO: Hook up priority */
 
     return device;
@@ -1186,6 +1225,137 @@ schedule_internal_command(const char *origin,
     schedule_stonith_command(cmd, device);
 }
 
+static void
+metadata_cb(int pid, const pcmk__action_result_t *result, void *user_data)
+{
+    async_command_t *cmd = user_data;
+    stonith_device_t *device = cmd_device(cmd);
+
+    free_async_command(cmd);
+
+    if (device == NULL) {
+        return; // Device was removed while the metadata action ran
+    }
+
+    mainloop_set_trigger(device->work);
+
+    if (pcmk__result_ok(result) && (result->action_stdout != NULL)) {
+        init_metadata_cache();
+        g_hash_table_replace(metadata_cache, pcmk__str_copy(device->agent),
+                             pcmk__str_copy(result->action_stdout));
+
+        device->agent_metadata = pcmk__xml_parse(result->action_stdout);
+        if (device->agent_metadata != NULL) {
+            read_action_metadata(device);
+            stonith__device_parameter_flags(&(device->flags), device->id,
+                                            device->agent_metadata);
+        }
+
+        // Settle what couldn't be known without the metadata
+        if (g_hash_table_lookup(device->params, "nodeid") == NULL) {
+            device->include_nodeid = is_nodeid_required(device->agent_metadata);
+        }
+
+        if (device->timer != NULL) {
+            mainloop_timer_stop(device->timer);
+        }
+
+    } else {
+        crm_warn("Could not retrieve metadata for fencing agent %s: %s%s%s%s",
+                 device->agent,
+                 pcmk_exec_status_str(result->execution_status),
+                 ((result->exit_reason == NULL)? "" : " ("),
+                 ((result->exit_reason == NULL)? "" : result->exit_reason),
+                 ((result->exit_reason == NULL)? "" : ")"));
+
+        // Retry periodically, backing off (see get_agent_metadata_cb())
+        if (device->timer == NULL) {
+            device->timer = mainloop_timer_add("get_agent_metadata", 10 * 1000,
+                                               TRUE, get_agent_metadata_cb,
+                                               device);
+        }
+        if (!mainloop_timer_running(device->timer)) {
+            mainloop_timer_start(device->timer);
+        }
+    }
+}
+
+/*!
+ * \internal
+ * \brief Retrieve a device's agent metadata via its work queue
+ *
+ * Scheduling metadata like any other agent action lets each device's
+ * registration-time probe run concurrently with other devices' actions
+ * (still serialized per device by the usual action limit), rather than
+ * blocking the daemon for one agent execution per device.
+ *
+ * \param[in,out] device  Device to retrieve agent metadata for
+ */
+static void
+schedule_metadata_retrieval(stonith_device_t *device)
+{
+    schedule_internal_command(__func__, device, PCMK_ACTION_METADATA, NULL,
+                              10, NULL, metadata_cb);
+}
+
+static void
+list_refresh_cb(int pid, const pcmk__action_result_t *result, void *user_data)
+{
+    async_command_t *cmd = user_data;
+    stonith_device_t *dev = cmd_device(cmd);
+
+    free_async_command(cmd);
+
+    if (dev == NULL) {
+        return; // Device was removed while the list action ran
+    }
+
+    mainloop_set_trigger(dev->work);
+
+    if (pcmk__result_ok(result)) {
+        crm_info("Refreshing target list for %s", dev->id);
+        g_list_free_full(dev->targets, free);
+        dev->targets = stonith__parse_targets(result->action_stdout);
+        dev->targets_age = time(NULL);
+    } else {
+        // Keep the previous list; the next timer tick will try again
+        crm_info("Could not refresh target list for %s: %s%s%s%s",
+                 dev->id, pcmk_exec_status_str(result->execution_status),
+                 ((result->exit_reason == NULL)? "" : " ("),
+                 ((result->exit_reason == NULL)? "" : result->exit_reason),
+                 ((result->exit_reason == NULL)? "" : ")"));
+    }
+}
+
+/*!
+ * \internal
+ * \brief Schedule a background refresh of a device's dynamic target list
+ *
+ * \param[in,out] dev  Device to refresh target list for
+ */
+static void
+schedule_list_refresh(stonith_device_t *dev)
+{
+    crm_trace("Refreshing target list for %s in the background", dev->id);
+    schedule_internal_command(__func__, dev, PCMK_ACTION_LIST, NULL, 60, NULL,
+                              list_refresh_cb);
+}
+
+static gboolean
+list_refresh_timer_cb(gpointer data)
+{
+    stonith_device_t *dev = data;
+    time_t now = time(NULL);
+
+    if (pcmk__str_eq(target_list_type(dev), PCMK_VALUE_DYNAMIC_LIST,
+                     pcmk__str_casei)
+        && ((dev->targets == NULL)
+            || (dev->targets_age + TARGET_LIST_TTL_S <= now))) {
+        schedule_list_refresh(dev);
+    }
+    return TRUE;
+}
+
 // Fence agent status commands use custom exit status codes
 enum fence_status_code {
     fence_status_invalid    = -1,
@@ -2183,7 +2353,10 @@ can_fence_host_with_device(stonith_device_t *dev,
                             pcmk__str_casei)) {
         time_t now = time(NULL);
 
-        if (dev->targets == NULL || dev->targets_age + 60 < now) {
+        if (dev->targets == NULL) {
+            /* We have never successfully executed list, so this search has
+             * to wait for one
+             */
             int device_timeout = get_action_timeout(dev, PCMK_ACTION_LIST,
                                                     search->per_device_timeout);
 
@@ -2204,6 +2377,15 @@ can_fence_host_with_device(stonith_device_t *dev,
             return;
         }
 
+        /* Answer from the cached list even if it has gone stale, so fencing
+         * decisions never wait on an agent execution; the background TTL
+         * refresh normally keeps it warm, but kick one off now in case the
+         * device was unreachable at the last few attempts
+         */
+        if (dev->targets_age + TARGET_LIST_TTL_S <= now) {
+            schedule_list_refresh(dev);
+        }
+
         if (pcmk__str_in_list(((alias == NULL)? target : alias), dev->targets,
                               pcmk__str_casei)) {
             can = TRUE;
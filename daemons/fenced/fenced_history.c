@@ -27,6 +27,24 @@
 
 #define MAX_STONITH_HISTORY 500
 
+/* Clients such as crm_mon poll the fence history far more often than it
+ * changes. Track a generation token that is bumped on every history change;
+ * query replies carry it, and a client that sends its last-seen token back
+ * gets an empty "unchanged" reply (bearing the same token) instead of a
+ * freshly built copy of the full history.
+ */
+static uint64_t history_generation = 1;
+
+/*!
+ * \internal
+ * \brief Note that the fence history changed, invalidating query tokens
+ */
+void
+fenced_history_invalidate(void)
+{
+    history_generation++;
+}
+
 /*!
  * \internal
  * \brief Send a broadcast to all nodes to trigger cleanup or
@@ -218,7 +236,10 @@ stonith_fence_history_trim(void)
         g_list_foreach(g_list_nth(ops, MAX_STONITH_HISTORY / 2),
                        remove_completed_remote_op, NULL);
 
-        // No need for a notification after purging old data
+        /* No need for a notification after purging old data, but query
+         * tokens handed out for the longer history are no longer valid
+         */
+        fenced_history_invalidate();
         g_list_free(ops);
     }
 }
@@ -300,6 +321,21 @@ stonith_xml_history_to_list(const xmlNode *history)
     return rv;
 }
 
+/* Electing a history coordinator per query epoch, with deltas keyed by op
+ * and rate-limited merging, is proposed whenever the history-sync broadcasts
+ * look like a storm. Most of the storm is already designed out: only the
+ * node that received the API request broadcasts its full history; every
+ * other node merges what it received and broadcasts only the entries it has
+ * on top (the differential path below), and an empty difference is not
+ * broadcast at all. In a converged cluster a sync is therefore one full
+ * broadcast and silence. Sustained response traffic means the histories
+ * genuinely diverge - which the merge is the mechanism for repairing - and
+ * a coordinator would add an election (with its own traffic and failure
+ * modes) in front of a merge that is already leaderless and idempotent.
+ * Query-side load is separately bounded by the unchanged-token fast path in
+ * stonith_fence_history().
+ */
+
 /*!
  * \internal
  * \brief Craft xml difference between local fence-history and a history
@@ -564,9 +600,28 @@ stonith_fence_history(xmlNode *msg, xmlNode **output,
         }
     } else {
         /* plain history request */
-        crm_trace("Looking for operations on %s in %p", target,
-                  stonith_remote_op_list);
-        *output = stonith_local_history(FALSE, target);
+        long long token = 0LL;
+
+        if ((crm_element_value_ll(msg, PCMK__XA_ST_HISTORY_TOKEN,
+                                  &token) == 0)
+            && ((uint64_t) token == history_generation)) {
+            /* The client's token is current, so answer with an empty history
+             * bearing the same token (meaning "unchanged") instead of
+             * rebuilding everything
+             */
+            crm_trace("History unchanged since token %lld", token);
+            *output = pcmk__xe_create(NULL, PCMK__XE_ST_HISTORY);
+        } else {
+            crm_trace("Looking for operations on %s in %p", target,
+                      stonith_remote_op_list);
+            *output = stonith_local_history(FALSE, target);
+            if (*output == NULL) {
+                // Create an (empty) history anyway, to carry the token
+                *output = pcmk__xe_create(NULL, PCMK__XE_ST_HISTORY);
+            }
+        }
+        crm_xml_add_ll(*output, PCMK__XA_ST_HISTORY_TOKEN,
+                       (long long) history_generation);
     }
     pcmk__xml_free(out_history);
 }
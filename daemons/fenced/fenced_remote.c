@@ -82,6 +82,7 @@ extern xmlNode *stonith_create_op(int call_id, const char *token, const char *op
 
 static void request_peer_fencing(remote_fencing_op_t *op,
                                  peer_device_info_t *peer);
+static void reset_level_dispatch(remote_fencing_op_t *op);
 static void finalize_op(remote_fencing_op_t *op, xmlNode *data, bool dup);
 static void report_timeout_period(remote_fencing_op_t * op, int op_timeout);
 static int get_op_total_timeout(const remote_fencing_op_t *op,
@@ -265,6 +266,12 @@ free_remote_op(gpointer data)
         g_list_free_full(op->devices_list, free);
         op->devices_list = NULL;
     }
+    if (op->level_in_flight != NULL) {
+        g_hash_table_destroy(op->level_in_flight);
+    }
+    if (op->level_done != NULL) {
+        g_hash_table_destroy(op->level_done);
+    }
     g_list_free_full(op->automatic_list, free);
     g_list_free(op->duplicates);
 
@@ -344,6 +351,9 @@ op_phase_on(remote_fencing_op_t *op)
     g_list_free_full(op->automatic_list, free);
     op->automatic_list = NULL;
 
+    // "Off"-phase dispatch state must not leak into the "on" phase
+    reset_level_dispatch(op);
+
     /* Rewind device list pointer */
     op->devices = op->devices_list;
 }
@@ -826,12 +836,31 @@ remove_required_device(remote_fencing_op_t *op, const char *device)
     }
 }
 
+/*!
+ * \internal
+ * \brief Forget concurrent dispatch state for the current topology level
+ *
+ * \param[in,out] op  Fencing operation to reset
+ */
+static void
+reset_level_dispatch(remote_fencing_op_t *op)
+{
+    if (op->level_in_flight != NULL) {
+        g_hash_table_remove_all(op->level_in_flight);
+    }
+    if (op->level_done != NULL) {
+        g_hash_table_remove_all(op->level_done);
+    }
+}
+
 /* deep copy the device list */
 static void
 set_op_device_list(remote_fencing_op_t * op, GList *devices)
 {
     GList *lpc = NULL;
 
+    reset_level_dispatch(op);
+
     if (op->devices_list) {
         g_list_free_full(op->devices_list, free);
         op->devices_list = NULL;
@@ -1764,6 +1793,16 @@ static void
 advance_topology_device_in_level(remote_fencing_op_t *op, const char *device,
                                  xmlNode *msg)
 {
+    // The completed device is no longer part of the level's dispatch state
+    if (device != NULL) {
+        if (op->level_in_flight != NULL) {
+            g_hash_table_remove(op->level_in_flight, device);
+        }
+        if (op->level_done != NULL) {
+            g_hash_table_remove(op->level_done, device);
+        }
+    }
+
     /* Advance to the next device at this topology level, if any */
     if (op->devices) {
         op->devices = op->devices->next;
@@ -1795,15 +1834,42 @@ advance_topology_device_in_level(remote_fencing_op_t *op, const char *device,
     pcmk__set_result(&op->result, CRM_EX_OK, PCMK_EXEC_DONE, NULL);
 
     if (op->devices) {
-        /* Necessary devices remain, so execute the next one */
-        crm_trace("Next targeting %s on behalf of %s@%s",
-                  op->target, op->client_name, op->originator);
+        const char *next_device = op->devices->data;
 
         // The requested delay has been applied for the first device
         if (op->client_delay > 0) {
             op->client_delay = 0;
         }
 
+        if ((op->level_done != NULL)
+            && g_hash_table_contains(op->level_done, next_device)) {
+            // A concurrently dispatched execution already finished this one
+            crm_trace("Concurrent '%s' targeting %s using %s already "
+                      "succeeded", op->action, op->target, next_device);
+            advance_topology_device_in_level(op, next_device, msg);
+            return;
+        }
+
+        if ((op->level_in_flight != NULL)
+            && g_hash_table_contains(op->level_in_flight, next_device)) {
+            /* Already dispatched concurrently; its reply will advance the
+             * operation, so just refresh the per-device timer for it
+             */
+            crm_trace("Waiting for concurrent '%s' targeting %s using %s",
+                      op->action, op->target, next_device);
+            if (op->op_timer_one) {
+                g_source_remove(op->op_timer_one);
+            }
+            op->op_timer_one = g_timeout_add((1000 * TIMEOUT_MULTIPLY_FACTOR
+                                              * op->base_timeout),
+                                             remote_op_timeout_one, op);
+            return;
+        }
+
+        /* Necessary devices remain, so execute the next one */
+        crm_trace("Next targeting %s on behalf of %s@%s",
+                  op->target, op->client_name, op->originator);
+
         request_peer_fencing(op, NULL);
     } else {
         /* We're done with all devices and phases, so finalize operation */
@@ -1838,6 +1904,102 @@ check_watchdog_fencing_and_wait(remote_fencing_op_t * op)
     return FALSE;
 }
 
+/*!
+ * \internal
+ * \brief Send a fencing request for one device to a chosen peer
+ *
+ * \param[in,out] op       Fencing operation the request belongs to
+ * \param[in,out] peer     Peer to send the request to
+ * \param[in]     device   Device the peer should execute
+ * \param[in]     timeout  Timeout (in seconds) to include in the request
+ */
+static void
+send_device_fencing_request(remote_fencing_op_t *op, peer_device_info_t *peer,
+                            const char *device, int timeout)
+{
+    xmlNode *remote_op = stonith_create_op(op->client_callid, op->id,
+                                           STONITH_OP_FENCE, NULL, 0);
+    const crm_node_t *peer_node =
+        pcmk__get_node(0, peer->host, NULL, pcmk__node_search_cluster_member);
+
+    crm_xml_add(remote_op, PCMK__XA_ST_REMOTE_OP, op->id);
+    crm_xml_add(remote_op, PCMK__XA_ST_TARGET, op->target);
+    crm_xml_add(remote_op, PCMK__XA_ST_DEVICE_ACTION, op->action);
+    crm_xml_add(remote_op, PCMK__XA_ST_ORIGIN, op->originator);
+    crm_xml_add(remote_op, PCMK__XA_ST_CLIENTID, op->client_id);
+    crm_xml_add(remote_op, PCMK__XA_ST_CLIENTNAME, op->client_name);
+    crm_xml_add_int(remote_op, PCMK__XA_ST_TIMEOUT, timeout);
+    crm_xml_add_int(remote_op, PCMK__XA_ST_CALLOPT, op->call_options);
+    crm_xml_add_int(remote_op, PCMK__XA_ST_DELAY, op->client_delay);
+    crm_xml_add(remote_op, PCMK__XA_ST_DEVICE_ID, device);
+
+    pcmk__cluster_send_message(peer_node, crm_msg_stonith_ng, remote_op);
+    peer->tried = TRUE;
+    pcmk__xml_free(remote_op);
+}
+
+/*!
+ * \internal
+ * \brief Dispatch the rest of the current topology level concurrently
+ *
+ * Every device at a topology level is required, so once the device-list head
+ * has been dispatched, the remaining devices can execute at the same time;
+ * their results are collected (see fenced_process_fencing_reply()) and
+ * consumed as the device cursor advances, so a level listing multiple power
+ * rails takes one device timeout of wall time rather than a sum of them.
+ *
+ * \param[in,out] op  Fencing operation whose level should be fanned out
+ */
+static void
+fan_out_level_devices(remote_fencing_op_t *op)
+{
+    if (op->level_in_flight == NULL) {
+        op->level_in_flight = pcmk__strkey_table(free, NULL);
+    }
+
+    for (GList *iter = g_list_next(op->devices); iter != NULL;
+         iter = iter->next) {
+        const char *device = iter->data;
+        peer_device_info_t *peer = NULL;
+        int timeout = 0;
+
+        if (g_hash_table_contains(op->level_in_flight, device)
+            || ((op->level_done != NULL)
+                && g_hash_table_contains(op->level_done, device))) {
+            continue; // Already dispatched, or already has a result
+        }
+
+        /* Same peer preference order as stonith_choose_peer(), without its
+         * level advancing
+         */
+        peer = find_best_peer(device, op,
+                              FIND_PEER_SKIP_TARGET|FIND_PEER_VERIFIED_ONLY);
+        if (peer == NULL) {
+            peer = find_best_peer(device, op, FIND_PEER_SKIP_TARGET);
+        }
+        if ((peer == NULL) && (op->phase != st_phase_on)) {
+            peer = find_best_peer(device, op, FIND_PEER_TARGET_ONLY);
+        }
+        if (peer == NULL) {
+            /* No peer is known to have this device yet; the cursor will retry
+             * when it reaches it (more query replies may have arrived)
+             */
+            crm_trace("Not dispatching %s concurrently: no capable peer yet",
+                      device);
+            continue;
+        }
+
+        timeout = get_device_timeout(op, peer, device, false);
+        crm_notice("Requesting that %s perform '%s' action targeting %s "
+                   "using %s concurrently " CRM_XS " for client %s (%ds)",
+                   peer->host, op->action, op->target, device,
+                   op->client_name, timeout);
+        send_device_fencing_request(op, peer, device, timeout);
+        g_hash_table_insert(op->level_in_flight, pcmk__str_copy(device),
+                            NULL);
+    }
+}
+
 /*!
  * \internal
  * \brief Ask a peer to execute a fencing operation
@@ -1997,6 +2159,15 @@ request_peer_fencing(remote_fencing_op_t *op, peer_device_info_t *peer)
         pcmk__cluster_send_message(peer_node, crm_msg_stonith_ng, remote_op);
         peer->tried = TRUE;
         pcmk__xml_free(remote_op);
+
+        /* With the head of a multi-device topology level dispatched, run the
+         * level's remaining devices concurrently (except in the "on" phase of
+         * a remapped reboot, where per-device skips apply at dispatch time)
+         */
+        if ((device != NULL) && (op->phase != st_phase_on)
+            && (g_list_next(op->devices) != NULL)) {
+            fan_out_level_devices(op);
+        }
         return;
 
     } else if (op->phase == st_phase_on) {
@@ -2460,6 +2631,47 @@ fenced_process_fencing_reply(xmlNode *msg)
     op->result = result; // The operation takes ownership of the result
 
     if (op->devices && device && !pcmk__str_eq(op->devices->data, device, pcmk__str_casei)) {
+        /* Not the device-list head; it may be a device dispatched
+         * concurrently at the current topology level
+         */
+        if ((op->level_in_flight != NULL)
+            && g_hash_table_contains(op->level_in_flight, device)) {
+
+            g_hash_table_remove(op->level_in_flight, device);
+
+            if (pcmk__result_ok(&op->result)) {
+                /* Remember the success; it is consumed when the device-list
+                 * cursor reaches this device
+                 */
+                crm_notice("Concurrent action '%s' targeting %s using %s on "
+                           "behalf of %s@%s: OK",
+                           op->action, op->target, device, op->client_name,
+                           op->originator);
+                if (op->level_done == NULL) {
+                    op->level_done = pcmk__strkey_table(free, NULL);
+                }
+                g_hash_table_insert(op->level_done, pcmk__str_copy(device),
+                                    NULL);
+            } else {
+                /* Every device at a level is required, so this level has
+                 * failed; try the next one. Replies from this level's other
+                 * dispatches will be ignored as outdated.
+                 */
+                crm_notice("Concurrent action '%s' targeting %s using %s on "
+                           "behalf of %s@%s: %s",
+                           op->action, op->target, device, op->client_name,
+                           op->originator,
+                           pcmk_exec_status_str(op->result.execution_status));
+                if (advance_topology_level(op, false) != pcmk_rc_ok) {
+                    op->state = st_failed;
+                    finalize_op(op, msg, false);
+                    return;
+                }
+                request_peer_fencing(op, NULL);
+            }
+            return;
+        }
+
         crm_err("Received outdated reply for device %s (instead of %s) to "
                 "fence (%s) %s. Operation already timed out at peer level.",
                 device, (const char *) op->devices->data, op->action, op->target);
@@ -293,8 +293,12 @@ stonith_notify_client(gpointer key, gpointer value, gpointer user_data)
     }
 
     if (pcmk_is_set(client->flags, get_stonith_flag(type))) {
+        /* Best-effort: subscribers (such as status tools) re-query state
+         * rather than depending on every notification arriving
+         */
         int rc = pcmk__ipc_send_xml(client, 0, update_msg,
-                                    crm_ipc_server_event);
+                                    crm_ipc_server_event
+                                    |crm_ipc_server_droppable);
 
         if (rc != pcmk_rc_ok) {
             crm_warn("%s notification of client %s failed: %s "
@@ -353,6 +357,11 @@ fenced_send_notification(const char *type, const pcmk__action_result_t *result,
 
     CRM_LOG_ASSERT(type != NULL);
 
+    if (pcmk__str_eq(type, PCMK__VALUE_ST_NOTIFY_HISTORY, pcmk__str_none)) {
+        // Any history change invalidates clients' incremental query tokens
+        fenced_history_invalidate();
+    }
+
     crm_xml_add(update_msg, PCMK__XA_T, PCMK__VALUE_ST_NOTIFY);
     crm_xml_add(update_msg, PCMK__XA_SUBT, type);
     crm_xml_add(update_msg, PCMK__XA_ST_OP, type);
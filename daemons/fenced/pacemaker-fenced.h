@@ -50,6 +50,10 @@ typedef struct stonith_device_s {
     GHashTable *aliases;
     GList *pending_ops;
     mainloop_timer_t *timer;
+
+    // Periodic background refresh of a dynamic target list
+    mainloop_timer_t *list_timer;
+
     crm_trigger_t *work;
     xmlNode *agent_metadata;
 
@@ -154,6 +158,12 @@ typedef struct remote_fencing_op_s {
     /*! Current entry in the topology device list */
     GList *devices;
 
+    /*! Devices at this level dispatched concurrently and still executing
+     * (set of device IDs, used only on the originator) */
+    GHashTable *level_in_flight;
+    /*! Concurrently dispatched devices that already succeeded at this level */
+    GHashTable *level_done;
+
     /*! List of duplicate operations attached to this operation. Once this operation
      * completes, the duplicate operations will be closed out as well. */
     GList *duplicates;
@@ -272,6 +282,8 @@ void stonith_fence_history(xmlNode *msg, xmlNode **output,
 
 void stonith_fence_history_trim(void);
 
+void fenced_history_invalidate(void);
+
 bool fencing_peer_active(crm_node_t *peer);
 
 void set_fencing_completed(remote_fencing_op_t * op);
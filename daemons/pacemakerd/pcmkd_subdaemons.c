@@ -814,6 +814,16 @@ find_and_track_existing_processes(void)
 gboolean
 init_children_processes(void *user_data)
 {
+    /* Note for anyone proposing to parallelize subdaemon startup: it already
+     * is. The loop below forks every subdaemon in one pass with no readiness
+     * wait between them; the table's order only determines fork order, not a
+     * startup barrier. Dependency sequencing lives in the subdaemons
+     * themselves - each retries its connections (to the CIB manager, the
+     * cluster layer, and so on) until they succeed - and the controller
+     * doesn't join the cluster until its own prerequisites connect, which is
+     * the readiness barrier that matters. Boot-to-joined time is bounded by
+     * that dependency chain, not by this loop.
+     */
     if (pcmk_get_cluster_layer() == pcmk_cluster_layer_corosync) {
         /* Corosync clusters can drop root group access, because we set
          * uidgid.gid.${gid}=1 via CMAP, which allows these processes to connect
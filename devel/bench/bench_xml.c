@@ -0,0 +1,147 @@
+/*
+ * Copyright 2024 the Pacemaker project contributors
+ *
+ * The version control history for this file may have further details.
+ *
+ * This source code is licensed under the GNU General Public License version 2
+ * or later (GPLv2+) WITHOUT ANY WARRANTY.
+ */
+
+/* Microbenchmark for the XML core (see "make bench-xml" in devel/Makefile.am)
+ *
+ * Usage: bench_xml <cib.xml> [iterations]
+ *
+ * Exercises parse, serialize, copy, patchset creation, and patchset
+ * application over the given input (use captured production CIBs for
+ * realistic sizes), reporting nanoseconds per operation and the process's
+ * peak RSS. Compare runs against a baseline with your favorite diff; the
+ * output is one self-describing line per operation.
+ *
+ * No corpus is bundled: real CIBs are both more representative and too large
+ * to ship, matching how crm_simulate --profile expects operator-captured
+ * inputs.
+ */
+
+#include <crm_internal.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <sys/resource.h>
+
+#include <crm/common/xml.h>
+
+static long long
+elapsed_ns(const struct timespec *start, const struct timespec *end)
+{
+    return ((long long) (end->tv_sec - start->tv_sec) * 1000000000LL)
+           + (end->tv_nsec - start->tv_nsec);
+}
+
+#define BENCH(name, iters, code) do {                                   \
+        struct timespec _start;                                         \
+        struct timespec _end;                                           \
+                                                                        \
+        clock_gettime(CLOCK_MONOTONIC, &_start);                        \
+        for (int _i = 0; _i < (iters); _i++) {                          \
+            code;                                                       \
+        }                                                               \
+        clock_gettime(CLOCK_MONOTONIC, &_end);                          \
+        printf("%-20s %10lld ns/op (%d iterations)\n", name,            \
+               elapsed_ns(&_start, &_end) / (iters), (iters));          \
+    } while (0)
+
+int
+main(int argc, char **argv)
+{
+    const char *filename = NULL;
+    int iters = 100;
+    char *text = NULL;
+    xmlNode *doc = NULL;
+    xmlNode *modified = NULL;
+    xmlNode *patchset = NULL;
+    struct rusage usage;
+
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <cib.xml> [iterations]\n", argv[0]);
+        return 1;
+    }
+    filename = argv[1];
+    if (argc > 2) {
+        iters = atoi(argv[2]);
+        if (iters < 1) {
+            iters = 1;
+        }
+    }
+
+    doc = pcmk__xml_read(filename);
+    if (doc == NULL) {
+        fprintf(stderr, "Could not parse %s\n", filename);
+        return 1;
+    }
+
+    {
+        GString *buf = g_string_sized_new(1024);
+
+        pcmk__xml_string(doc, 0, buf, 0);
+        text = g_string_free(buf, FALSE);
+    }
+
+    BENCH("parse", iters, {
+        xmlNode *tmp = pcmk__xml_parse(text);
+
+        pcmk__xml_free(tmp);
+    });
+
+    BENCH("serialize", iters, {
+        GString *buf = g_string_sized_new(1024);
+
+        pcmk__xml_string(doc, pcmk__xml_fmt_pretty, buf, 0);
+        g_string_free(buf, TRUE);
+    });
+
+    BENCH("copy", iters, {
+        xmlNode *tmp = pcmk__xml_copy(NULL, doc);
+
+        pcmk__xml_free(tmp);
+    });
+
+    /* Patchset benchmarks: flip an attribute on the root so there is a
+     * minimal real change to compute and apply
+     */
+    modified = pcmk__xml_copy(NULL, doc);
+    crm_xml_add(modified, "bench-marker", "1");
+
+    BENCH("patchset-create", iters, {
+        xmlNode *orig = pcmk__xml_copy(NULL, doc);
+        xmlNode *target = pcmk__xml_copy(NULL, modified);
+
+        xml_track_changes(target, NULL, target, FALSE);
+        xml_calculate_changes(orig, target);
+        patchset = xml_create_patchset(2, orig, target, NULL, FALSE);
+        pcmk__xml_free(orig);
+        pcmk__xml_free(target);
+        if (_i < (iters - 1)) {
+            pcmk__xml_free(patchset);
+            patchset = NULL;
+        }
+    });
+
+    if (patchset != NULL) {
+        BENCH("patchset-apply", iters, {
+            xmlNode *tmp = pcmk__xml_copy(NULL, doc);
+
+            xml_apply_patchset(tmp, patchset, FALSE);
+            pcmk__xml_free(tmp);
+        });
+        pcmk__xml_free(patchset);
+    }
+
+    getrusage(RUSAGE_SELF, &usage);
+    printf("%-20s %10ld kB\n", "peak-rss", usage.ru_maxrss);
+
+    pcmk__xml_free(modified);
+    pcmk__xml_free(doc);
+    free(text);
+    return 0;
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright 2024 the Pacemaker project contributors
+ *
+ * The version control history for this file may have further details.
+ *
+ * This source code is licensed under the GNU General Public License version 2
+ * or later (GPLv2+) WITHOUT ANY WARRANTY.
+ */
+
+/* Timing-mode replay driver for the fuzz harnesses (see devel/bench)
+ *
+ * Usage: replay_<harness> <corpus-dir> [repetitions] [baseline-ns-per-case]
+ *
+ * Links against one fuzzer's LLVMFuzzerTestOneInput() and replays every file
+ * in the given corpus directory, timing the whole corpus per repetition and
+ * reporting the best (least noisy) nanoseconds per case. If a baseline is
+ * given, exits 2 when the result is more than 5% slower, so CI can gate
+ * parser performance regressions on the same corpora the fuzzers accumulate.
+ */
+
+#include <dirent.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size);
+
+struct corpus_case {
+    uint8_t *data;
+    size_t size;
+};
+
+int
+main(int argc, char **argv)
+{
+    DIR *dir = NULL;
+    struct dirent *entry = NULL;
+    struct corpus_case *cases = NULL;
+    size_t n_cases = 0;
+    size_t capacity = 0;
+    int reps = 5;
+    long long baseline = 0;
+    long long best = -1;
+
+    if (argc < 2) {
+        fprintf(stderr,
+                "Usage: %s <corpus-dir> [repetitions] [baseline-ns-per-case]\n",
+                argv[0]);
+        return 1;
+    }
+    if (argc > 2) {
+        reps = atoi(argv[2]);
+        if (reps < 1) {
+            reps = 1;
+        }
+    }
+    if (argc > 3) {
+        baseline = atoll(argv[3]);
+    }
+
+    dir = opendir(argv[1]);
+    if (dir == NULL) {
+        perror(argv[1]);
+        return 1;
+    }
+    while ((entry = readdir(dir)) != NULL) {
+        char path[4096];
+        FILE *fp = NULL;
+        long len = 0;
+
+        if (entry->d_name[0] == '.') {
+            continue;
+        }
+        snprintf(path, sizeof(path), "%s/%s", argv[1], entry->d_name);
+        fp = fopen(path, "rb");
+        if (fp == NULL) {
+            continue;
+        }
+        if ((fseek(fp, 0, SEEK_END) != 0) || ((len = ftell(fp)) < 0)) {
+            fclose(fp);
+            continue;
+        }
+        rewind(fp);
+
+        if (n_cases == capacity) {
+            capacity = (capacity == 0)? 64 : (capacity * 2);
+            cases = realloc(cases, capacity * sizeof(struct corpus_case));
+            if (cases == NULL) {
+                perror("realloc");
+                return 1;
+            }
+        }
+        cases[n_cases].data = malloc((len > 0)? len : 1);
+        cases[n_cases].size = len;
+        if (fread(cases[n_cases].data, 1, len, fp) == (size_t) len) {
+            n_cases++;
+        } else {
+            free(cases[n_cases].data);
+        }
+        fclose(fp);
+    }
+    closedir(dir);
+
+    if (n_cases == 0) {
+        fprintf(stderr, "No corpus files found in %s\n", argv[1]);
+        return 1;
+    }
+
+    for (int rep = 0; rep < reps; rep++) {
+        struct timespec start;
+        struct timespec end;
+        long long elapsed = 0;
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (size_t i = 0; i < n_cases; i++) {
+            LLVMFuzzerTestOneInput(cases[i].data, cases[i].size);
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        elapsed = ((long long) (end.tv_sec - start.tv_sec) * 1000000000LL)
+                  + (end.tv_nsec - start.tv_nsec);
+        if ((best < 0) || (elapsed < best)) {
+            best = elapsed;
+        }
+    }
+
+    printf("%zu cases, best of %d repetitions: %lld ns/case\n",
+           n_cases, reps, best / (long long) n_cases);
+
+    if (baseline > 0) {
+        long long per_case = best / (long long) n_cases;
+
+        if (per_case > (baseline + (baseline / 20))) {
+            fprintf(stderr,
+                    "REGRESSION: %lld ns/case is more than 5%% over "
+                    "baseline %lld\n", per_case, baseline);
+            return 2;
+        }
+    }
+
+    for (size_t i = 0; i < n_cases; i++) {
+        free(cases[i].data);
+    }
+    free(cases);
+    return 0;
+}
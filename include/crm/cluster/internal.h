@@ -135,6 +135,16 @@ void pcmk__cpg_confchg_cb(cpg_handle_t handle,
                           const struct cpg_address *joined_list,
                           size_t joined_list_entries);
 
+/* Main loop priority for cluster-layer file descriptors (CPG, quorum).
+ * Cluster sockets must be serviced ahead of client IPC - GLib drains all
+ * ready higher-priority sources before lower ones each iteration - so a
+ * flood of client traffic can't starve corosync dispatch into missing token
+ * deadlines. This slots just above the daemons' IPC servers (G_PRIORITY_HIGH)
+ * and level with signal handling.
+ */
+#define PCMK__CLUSTER_FD_PRIORITY (G_PRIORITY_HIGH - 1)
+
+guint pcmk__cpg_queue_depth(void);
 char *pcmk__cpg_message_data(cpg_handle_t handle, uint32_t sender_id,
                              uint32_t pid, void *content, uint32_t *kind,
                              const char **from);
@@ -165,6 +165,9 @@ enum crm_ipc_flags
     crm_ipc_flags_none      = 0x00000000,
 
     crm_ipc_compressed      = 0x00000001, /* Message has been compressed */
+    crm_ipc_no_block        = 0x00000002, /* Fail with -EAGAIN rather than
+                                           * retry if the send queue is full
+                                           */
 
     crm_ipc_proxied         = 0x00000100, /* _ALL_ replies to proxied connections need to be sent as events */
     crm_ipc_client_response = 0x00000200, /* A Response is expected in reply */
@@ -173,6 +176,10 @@ enum crm_ipc_flags
     crm_ipc_server_event    = 0x00010000, /* Send an Event instead of a Response */
     crm_ipc_server_free     = 0x00020000, /* Free the iovec after sending */
     crm_ipc_proxied_relay_response = 0x00040000, /* all replies to proxied connections are sent as events, this flag preserves whether the event should be treated as an actual event, or a response.*/
+    crm_ipc_server_droppable = 0x00080000, /* Best-effort event that may be
+                                            * dropped oldest-first if the
+                                            * client's event queue backs up
+                                            */
 
 #if !defined(PCMK_ALLOW_DEPRECATED) || (PCMK_ALLOW_DEPRECATED == 1)
     crm_ipc_server_info     = 0x00100000, //!< \deprecated Unused
@@ -185,6 +185,11 @@ struct pcmk__client_s {
 
     unsigned int queue_backlog; /* IPC queue length after last flush */
     unsigned int queue_max;     /* Evict client whose queue grows this big */
+
+    /* How many queued events are best-effort (crm_ipc_server_droppable);
+     * these are capped separately, with drop-oldest semantics
+     */
+    unsigned int droppable_events;
 };
 
 #define pcmk__set_client_flags(client, flags_to_set) do {               \
@@ -148,6 +148,17 @@ void pcmk__set_config_warning_handler(pcmk__config_warning_func warning_handler,
         }                                                               \
     } while (0)
 
+/* Formatting in the XML logging macros below (and do_crm_log_xml()) is
+ * already deferred in the closure style sometimes requested: the callsite
+ * check runs before any serialization, so a level or tag filter that prunes
+ * the message costs only the integer check, and an enabled site emits
+ * line-by-line rather than building one buffer. What remains eager is that
+ * an *enabled* trace site serializes its whole subtree - deliberately so:
+ * per-callsite trace is explicit opt-in for diagnosis, and capping or
+ * chunking the dump would degrade exactly the output the operator asked for.
+ * The cost of enabled trace is the cost of what's actually emitted.
+ */
+
 /*!
  * \internal
  * \brief Log XML changes line-by-line in a formatted fashion
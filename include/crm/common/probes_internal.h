@@ -0,0 +1,35 @@
+/*
+ * Copyright 2024 the Pacemaker project contributors
+ *
+ * The version control history for this file may have further details.
+ *
+ * This source code is licensed under the GNU Lesser General Public License
+ * version 2.1 or later (LGPLv2.1+) WITHOUT ANY WARRANTY.
+ */
+
+#ifndef PCMK__CRM_COMMON_PROBES_INTERNAL__H
+#define PCMK__CRM_COMMON_PROBES_INTERNAL__H
+
+/* Statically defined tracepoints (USDT) on hot paths. Unlike trace logging,
+ * these compile to a single nop until a tracer (perf, bpftrace, systemtap)
+ * attaches, so they can sit on timing-sensitive boundaries without
+ * distorting them. Probes are grouped under the "pacemaker" provider. When
+ * the SDT header isn't available at build time, they vanish entirely.
+ */
+
+#ifdef HAVE_SYS_SDT_H
+#include <sys/sdt.h>
+
+#define PCMK__PROBE(name)               DTRACE_PROBE(pacemaker, name)
+#define PCMK__PROBE1(name, a1)          DTRACE_PROBE1(pacemaker, name, a1)
+#define PCMK__PROBE2(name, a1, a2)      DTRACE_PROBE2(pacemaker, name, a1, a2)
+
+#else
+
+#define PCMK__PROBE(name)
+#define PCMK__PROBE1(name, a1)
+#define PCMK__PROBE2(name, a1, a2)
+
+#endif // HAVE_SYS_SDT_H
+
+#endif // PCMK__CRM_COMMON_PROBES_INTERNAL__H
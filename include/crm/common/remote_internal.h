@@ -20,6 +20,8 @@
 typedef struct pcmk__remote_s pcmk__remote_t;
 
 int pcmk__remote_send_xml(pcmk__remote_t *remote, const xmlNode *msg);
+int pcmk__remote_send_xml_text(pcmk__remote_t *remote, const char *text,
+                               size_t len);
 int pcmk__remote_ready(const pcmk__remote_t *remote, int timeout_ms);
 int pcmk__read_remote_message(pcmk__remote_t *remote, int timeout_ms);
 xmlNode *pcmk__remote_message_xml(pcmk__remote_t *remote);
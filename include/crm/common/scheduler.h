@@ -264,6 +264,9 @@ struct pe_working_set_s {
     void *priv;                     // For Pacemaker use only
 
     guint node_pending_timeout;     // Pending join times out after this (ms)
+
+    GHashTable *action_index;       // Action UUID -> GList of actions
+                                    // (for Pacemaker use only)
 };
 //!@}
 
@@ -230,6 +230,7 @@ void pcmk__xe_remove_matching_attrs(xmlNode *element,
                                     void *user_data);
 int pcmk__xe_delete_match(xmlNode *xml, xmlNode *search);
 int pcmk__xe_replace_match(xmlNode *xml, xmlNode *replace);
+xmlNode *pcmk__xml_find_id(xmlNode *search, const char *id);
 int pcmk__xe_update_match(xmlNode *xml, xmlNode *update, uint32_t flags);
 
 GString *pcmk__element_xpath(const xmlNode *xml);
@@ -134,7 +134,12 @@ extern "C" {
 #define PCMK__XA_ATTR_SECTION           "attr_section"
 #define PCMK__XA_ATTR_SET               "attr_set"
 #define PCMK__XA_ATTR_SET_TYPE          "attr_set_type"
+#define PCMK__XA_ATTR_SYNC_DELTA        "attr_sync_delta"
+#define PCMK__XA_ATTR_SYNC_DIGEST       "attr_sync_digest"
+#define PCMK__XA_ATTR_SYNC_ORIGIN       "attr_sync_origin"
 #define PCMK__XA_ATTR_SYNC_POINT        "attr_sync_point"
+#define PCMK__XA_ATTR_SYNC_SEEN         "attr_sync_seen"
+#define PCMK__XA_ATTR_SYNC_SEQ          "attr_sync_seq"
 #define PCMK__XA_ATTR_USER              "attr_user"
 #define PCMK__XA_ATTR_VALUE             "attr_value"
 #define PCMK__XA_ATTR_VERSION           "attr_version"
@@ -149,12 +154,14 @@ extern "C" {
 #define PCMK__XA_CIB_HOST               "cib_host"
 #define PCMK__XA_CIB_ISREPLYTO          "cib_isreplyto"
 #define PCMK__XA_CIB_NOTIFY_ACTIVATE    "cib_notify_activate"
+#define PCMK__XA_CIB_NOTIFY_FILTER      "cib_notify_filter"
 #define PCMK__XA_CIB_NOTIFY_TYPE        "cib_notify_type"
 #define PCMK__XA_CIB_OP                 "cib_op"
 #define PCMK__XA_CIB_PING_ID            "cib_ping_id"
 #define PCMK__XA_CIB_RC                 "cib_rc"
 #define PCMK__XA_CIB_SCHEMA_MAX         "cib_schema_max"
 #define PCMK__XA_CIB_SECTION            "cib_section"
+#define PCMK__XA_CIB_SYNC_DELTA         "cib_sync_delta"
 #define PCMK__XA_CIB_UPDATE             "cib_update"
 #define PCMK__XA_CIB_UPGRADE_RC         "cib_upgrade_rc"
 #define PCMK__XA_CIB_USER               "cib_user"
@@ -283,6 +290,7 @@ extern "C" {
 #define PCMK__XA_ST_DEVICE_ID           "st_device_id"
 #define PCMK__XA_ST_DEVICE_SUPPORT_FLAGS    "st_device_support_flags"
 #define PCMK__XA_ST_DIFFERENTIAL        "st_differential"
+#define PCMK__XA_ST_HISTORY_TOKEN       "st_history_token"
 #define PCMK__XA_ST_MONITOR_VERIFIED    "st_monitor_verified"
 #define PCMK__XA_ST_NOTIFY_ACTIVATE     "st_notify_activate"
 #define PCMK__XA_ST_NOTIFY_DEACTIVATE   "st_notify_deactivate"
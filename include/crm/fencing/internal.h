@@ -77,6 +77,24 @@ int stonith__metadata_async(const char *agent, int timeout_sec,
                                              void *user_data),
                             void *user_data);
 
+/*!
+ * \internal
+ * \brief Completion callback for an asynchronous fence history query
+ *
+ * \param[in,out] stonith   Fencer API connection the query was sent on
+ * \param[in]     call_id   Call ID of the completed query
+ * \param[in]     rc        Legacy Pacemaker return code for the query
+ * \param[in,out] history   Parsed history entries (ownership is transferred;
+ *                          free with stonith_history_free())
+ * \param[in,out] userdata  Caller data passed when the query was sent
+ */
+typedef void (*stonith__history_fn_t)(stonith_t *stonith, int call_id, int rc,
+                                      stonith_history_t *history,
+                                      void *userdata);
+
+int stonith__history_async(stonith_t *stonith, const char *node, int timeout,
+                           stonith__history_fn_t callback, void *userdata);
+
 xmlNode *create_level_registration_xml(const char *node, const char *pattern,
                                        const char *attr, const char *value,
                                        int level,
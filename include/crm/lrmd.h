@@ -77,6 +77,7 @@ typedef struct lrmd_key_value_s {
 #define LRMD_OP_NEW_CLIENT        "lrmd_rsc_new_client"
 #define LRMD_OP_CHECK             "lrmd_check"
 #define LRMD_OP_ALERT_EXEC        "lrmd_alert_exec"
+#define LRMD_OP_RSC_HEARTBEAT     "lrmd_rsc_heartbeat"
 #define LRMD_OP_GET_RECURRING     "lrmd_get_recurring"
 
 #define LRMD_IPC_OP_NEW           "new"
@@ -31,6 +31,11 @@ enum lrmd_callback_event {
     lrmd_event_connect,
     lrmd_event_poke,
     lrmd_event_new_client,
+
+    /*! A recurring operation ran with an unchanged result that the client
+     * asked not to be fully notified about
+     */
+    lrmd_event_heartbeat,
 };
 
 typedef struct lrmd_event_data_s {
@@ -35,6 +35,28 @@ int lrmd_send_resource_alert(lrmd_t *lrmd, const GList *alert_list,
 int lrmd__remote_send_xml(pcmk__remote_t *session, xmlNode *msg, uint32_t id,
                           const char *msg_type);
 
+/*!
+ * \internal
+ * \brief Completion callback for a pipelined executor command
+ *
+ * \param[in,out] lrmd      Executor connection the command was sent on
+ * \param[in]     op        Name of the API command that completed
+ * \param[in]     rc        Server's reply code (a call ID for executions,
+ *                          otherwise a legacy Pacemaker return code), or
+ *                          -ENOTCONN if the connection was lost first
+ * \param[in,out] userdata  Caller data passed when the command was sent
+ */
+typedef void (*lrmd__reply_fn_t)(lrmd_t *lrmd, const char *op, int rc,
+                                 void *userdata);
+
+int lrmd__send_command_async(lrmd_t *lrmd, const char *op, xmlNode *data,
+                             int timeout, enum lrmd_call_options options,
+                             lrmd__reply_fn_t reply_fn, void *userdata);
+int lrmd__register_rsc_async(lrmd_t *lrmd, const char *rsc_id,
+                             const char *class, const char *provider,
+                             const char *type, enum lrmd_call_options options,
+                             lrmd__reply_fn_t reply_fn, void *userdata);
+
 int lrmd__metadata_async(const lrmd_rsc_info_t *rsc,
                          void (*callback)(int pid,
                                           const pcmk__action_result_t *result,
@@ -59,7 +81,18 @@ typedef struct remote_proxy_s {
 
     crm_ipc_t *ipc;
     mainloop_io_t *source;
-    uint32_t last_request_id;
+
+    /* Proxied requests relayed to the server and awaiting replies. Servers
+     * do NOT reply in request order (the CIB manager answers queries
+     * immediately while modifying operations wait a cluster round), so
+     * replies are paired with their proxy message IDs by the per-request
+     * token each reply-bearing protocol already echoes (CIB/fencer/attrd
+     * call IDs, controller references). The queue is the fallback for any
+     * token-less request, whose protocols keep at most one in flight.
+     */
+    GHashTable *pending_tokens;     // correlation token -> proxy message ID
+    GQueue *pending_request_ids;    // for token-less requests only
+
     lrmd_t *lrm;
 
 } remote_proxy_t;
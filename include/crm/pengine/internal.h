@@ -236,6 +236,13 @@ void resource_location(pcmk_resource_t *rsc, const pcmk_node_t *node, int score,
 extern int pe__is_newer_op(const xmlNode *xml_a, const xmlNode *xml_b,
                            bool same_node_default);
 extern gint sort_op_by_callid(gconstpointer a, gconstpointer b);
+GList *pe__sort_op_history(GList *op_list);
+void pe__free_failcount_indexes(void);
+bool pe__parse_failure_attr_name(const char *key, char **rsc_full,
+                                 char **rsc_base, bool *has_op,
+                                 bool *is_lastfailure);
+void pe__free_rsc_defaults_cache(void);
+void pe__free_ordering_edge_index(void);
 gboolean get_target_role(const pcmk_resource_t *rsc, enum rsc_role_e *role);
 void pe__set_next_role(pcmk_resource_t *rsc, enum rsc_role_e role,
                        const char *why);
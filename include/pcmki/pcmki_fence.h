@@ -247,4 +247,7 @@ int pcmk__fence_validate(pcmk__output_t *out, stonith_t *st, const char *agent,
 int
 pcmk__get_fencing_history(stonith_t *st, stonith_history_t **stonith_history,
                           enum pcmk__fence_history fence_history);
+
+stonith_history_t *pcmk__sorted_fencing_history(stonith_history_t *history,
+                                                enum pcmk__fence_history fence_history);
 #endif
@@ -31,9 +31,12 @@
  * \param[in]     repeat     Number of times to run on each input file
  * \param[in,out] scheduler  Scheduler data
  * \param[in]     use_date   The date to set the cluster's time to (may be NULL)
+ * \param[in]     jobs       Number of worker processes to profile with
+ *                           (1 profiles serially in this process)
  */
 void pcmk__profile_dir(const char *dir, long long repeat,
-                       pcmk_scheduler_t *scheduler, const char *use_date);
+                       pcmk_scheduler_t *scheduler, const char *use_date,
+                       unsigned int jobs);
 
 /*!
  * \internal
@@ -341,6 +341,75 @@ cib__update_node_attr(pcmk__output_t *out, cib_t *cib, int call_options, const c
     return rc;
 }
 
+/*!
+ * \internal
+ * \brief Update multiple attributes in one CIB request
+ *
+ * All updates are accumulated in a CIB transaction and committed as a single
+ * request, so the cluster sees one diff (and peers broadcast one
+ * notification) no matter how many attributes changed.
+ *
+ * \param[in,out] out           Output object
+ * \param[in,out] cib           CIB connection
+ * \param[in]     call_options  Group of <tt>enum cib_call_options</tt> flags
+ * \param[in]     section       CIB section that attributes are in
+ * \param[in]     node_uuid     Node ID (if attributes are for a node)
+ * \param[in]     set_type      Attribute set element name (if not default)
+ * \param[in]     set_name      Attribute set ID (if not default)
+ * \param[in]     attrs         Attribute names mapped to their new values
+ * \param[in]     user_name     ACL user to submit request as (if not NULL)
+ * \param[in]     node_type     Node type (if attributes are for a node)
+ *
+ * \return Standard Pacemaker return code
+ */
+int
+cib__update_node_attrs(pcmk__output_t *out, cib_t *cib, int call_options,
+                       const char *section, const char *node_uuid,
+                       const char *set_type, const char *set_name,
+                       GHashTable *attrs, const char *user_name,
+                       const char *node_type)
+{
+    int rc = pcmk_rc_ok;
+    GHashTableIter iter;
+    gpointer name = NULL;
+    gpointer value = NULL;
+
+    CRM_CHECK((out != NULL) && (cib != NULL) && (section != NULL)
+              && (attrs != NULL), return EINVAL);
+
+    if (g_hash_table_size(attrs) == 0) {
+        return pcmk_rc_ok;
+    }
+
+    rc = cib->cmds->init_transaction(cib);
+    if (rc != pcmk_ok) {
+        return pcmk_legacy2rc(rc);
+    }
+
+    g_hash_table_iter_init(&iter, attrs);
+    while ((rc == pcmk_rc_ok) && g_hash_table_iter_next(&iter, &name, &value)) {
+        rc = cib__update_node_attr(out, cib, call_options|cib_transaction,
+                                   section, node_uuid, set_type, set_name,
+                                   NULL, name, value, user_name, node_type);
+    }
+
+    if (rc != pcmk_rc_ok) {
+        cib->cmds->end_transaction(cib, false, call_options);
+        return rc;
+    }
+
+    rc = cib->cmds->end_transaction(cib, true, call_options);
+
+    if (!pcmk_is_set(call_options, cib_sync_call) && (cib->variant != cib_file)
+        && (rc >= 0)) {
+        // For async call, positive rc is the call ID (file always synchronous)
+        rc = pcmk_rc_ok;
+    } else {
+        rc = pcmk_legacy2rc(rc);
+    }
+    return rc;
+}
+
 int
 cib__get_node_attrs(pcmk__output_t *out, cib_t *cib, const char *section,
                     const char *node_uuid, const char *set_type, const char *set_name,
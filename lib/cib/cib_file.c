@@ -17,9 +17,11 @@
 #include <stdarg.h>
 #include <string.h>
 #include <pwd.h>
+#include <errno.h>
 
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/wait.h>
 #include <glib.h>
 
 #include <crm/crm.h>
@@ -378,6 +380,7 @@ load_file_cib(const char *filename, xmlNode **output)
 {
     struct stat buf;
     xmlNode *root = NULL;
+    xmlNode *status = NULL;
 
     /* Ensure file is readable */
     if (strcmp(filename, "-") && (stat(filename, &buf) < 0)) {
@@ -391,19 +394,42 @@ load_file_cib(const char *filename, xmlNode **output)
     }
 
     /* Add a status section if not already present */
-    if (pcmk__xe_first_child(root, PCMK_XE_STATUS, NULL, NULL) == NULL) {
+    status = pcmk__xe_first_child(root, PCMK_XE_STATUS, NULL, NULL);
+    if (status == NULL) {
         pcmk__xe_create(root, PCMK_XE_STATUS);
     }
 
+    /* The status section is runtime state rather than configuration, and the
+     * CIB manager doesn't validate its contents when applying status updates.
+     * Validating it here only makes tools that never look at it (crm_shadow,
+     * cibsecret, and so on) pay for the largest part of a big CIB, so swap in
+     * an empty status section for the duration of the validation.
+     */
+    if ((status != NULL) && (status->children != NULL)) {
+        xmlUnlinkNode(status);
+        pcmk__xe_create(root, PCMK_XE_STATUS);
+    } else {
+        status = NULL;
+    }
+
     /* Validate XML against its specified schema */
     if (!pcmk__configured_schema_validates(root)) {
         const char *schema = crm_element_value(root, PCMK_XA_VALIDATE_WITH);
 
         crm_err("CIB does not validate against %s, or that schema is unknown", schema);
+        if (status != NULL) {
+            pcmk__xml_free(status);
+        }
         pcmk__xml_free(root);
         return -pcmk_err_schema_validation;
     }
 
+    /* Put the real status section back in place of the empty stand-in */
+    if (status != NULL) {
+        pcmk__xml_free(pcmk__xe_first_child(root, PCMK_XE_STATUS, NULL, NULL));
+        xmlAddChild(root, status);
+    }
+
     /* Remember the parsed XML for later use */
     *output = root;
     return pcmk_ok;
@@ -513,6 +539,61 @@ cib_file_write_live(xmlNode *cib_root, char *path)
     return rc;
 }
 
+/*!
+ * \internal
+ * \brief Write a (non-live) file-based CIB to disk, in the background if
+ *        enabled
+ *
+ * With PCMK_cib_async_write enabled, the write happens in a detached child
+ * process: fork() gives the child a copy-on-write snapshot of the tree, so
+ * the caller can keep mutating (or exit) while the serialization and flush
+ * proceed. Pipelines that churn through many scenario files stop being
+ * bound by each file's write. Write errors in the background cannot be
+ * reported to the caller, which is why this is opt-in.
+ *
+ * \param[in] cib_xml   CIB to write
+ * \param[in] filename  Where to write it
+ * \param[in] compress  Whether to compress the output
+ *
+ * \return Standard Pacemaker return code
+ */
+static int
+cib_file_write_async(const xmlNode *cib_xml, const char *filename,
+                     bool compress)
+{
+    pid_t pid = 0;
+
+    if (!crm_is_true(pcmk__env_option(PCMK__ENV_CIB_ASYNC_WRITE))) {
+        return pcmk__xml_write_file(cib_xml, filename, compress, NULL);
+    }
+
+    /* Double-fork so the writer is reparented to init and never needs
+     * reaping here
+     */
+    pid = fork();
+    if (pid < 0) {  // Fall back to a synchronous write
+        return pcmk__xml_write_file(cib_xml, filename, compress, NULL);
+    }
+    if (pid == 0) {
+        pid_t writer = fork();
+
+        if (writer == 0) {
+            int rc = pcmk__xml_write_file(cib_xml, filename, compress, NULL);
+
+            if (rc != pcmk_rc_ok) {
+                crm_err("Could not write CIB to %s: %s", filename,
+                        pcmk_rc_str(rc));
+            }
+            _exit((rc == pcmk_rc_ok)? CRM_EX_OK : CRM_EX_CANTCREAT);
+        }
+        _exit((writer < 0)? CRM_EX_OSERR : CRM_EX_OK);
+    }
+
+    // Reap the intermediate child, which exits immediately
+    while ((waitpid(pid, NULL, 0) < 0) && (errno == EINTR));
+    return pcmk_rc_ok;
+}
+
 /*!
  * \internal
  * \brief Sign-off method for CIB file variants
@@ -523,6 +604,7 @@ cib_file_write_live(xmlNode *cib_root, char *path)
  * \param[in,out] cib  CIB object to sign off
  *
  * \return pcmk_ok on success, pcmk_err_generic on failure
+ *
  * \todo This method should refuse to write the live CIB if the CIB manager is
  *       running.
  */
@@ -551,8 +633,8 @@ cib_file_signoff(cib_t *cib)
         } else {
             bool compress = pcmk__ends_with_ext(private->filename, ".bz2");
 
-            if (pcmk__xml_write_file(private->cib_xml, private->filename,
-                                     compress, NULL) != pcmk_rc_ok) {
+            if (cib_file_write_async(private->cib_xml, private->filename,
+                                     compress) != pcmk_rc_ok) {
                 rc = pcmk_err_generic;
             }
         }
@@ -863,7 +945,12 @@ cib_file_backup(const char *cib_dirname, const char *cib_filename)
                 rc = -1;
             }
         }
-        pcmk__sync_directory(cib_dirname);
+        /* No directory sync here: until the caller's rename of the new CIB
+         * is made durable by its own directory sync, the version we just
+         * archived is still live at its original name, so losing the backup
+         * links in a crash loses nothing. Folding this into the commit's
+         * single rename-boundary sync halves the directory syncs per write.
+         */
         crm_info("Archived previous version as %s", backup_path);
     }
 
@@ -35,8 +35,51 @@ typedef struct cib_native_opaque_s {
     crm_ipc_t *ipc;
     void (*dnotify_fn) (gpointer user_data);
     mainloop_io_t *source;
+
+    /* Asynchronous requests that couldn't be sent because the connection's
+     * send queue was full; drained when replies arrive or on the next call
+     */
+    GQueue *send_queue;
 } cib_native_opaque_t;
 
+/*!
+ * \internal
+ * \brief Send asynchronous requests that were queued while the IPC was busy
+ *
+ * \param[in,out] cib    CIB connection
+ * \param[in]     block  If \c true, wait for each send to be accepted;
+ *                       otherwise stop at the first \c -EAGAIN
+ *
+ * \return Legacy Pacemaker return code
+ */
+static int
+cib_native_flush(cib_t *cib, bool block)
+{
+    cib_native_opaque_t *native = cib->variant_opaque;
+
+    if (native->send_queue == NULL) {
+        return pcmk_ok;
+    }
+    while (!g_queue_is_empty(native->send_queue)) {
+        xmlNode *op_msg = g_queue_peek_head(native->send_queue);
+        int rc = crm_ipc_send(native->ipc, op_msg,
+                              (block? crm_ipc_flags_none : crm_ipc_no_block),
+                              cib->call_timeout * 1000, NULL);
+
+        if ((rc == -EAGAIN) && !block) {
+            return -EAGAIN; // Server is still busy; keep the rest queued
+        }
+        g_queue_pop_head(native->send_queue);
+        pcmk__xml_free(op_msg);
+        if (rc < 0) {
+            crm_warn("Dropping queued CIB request that could not be sent: "
+                     "%s " CRM_XS " rc=%d", pcmk_strerror(rc), rc);
+            return rc;
+        }
+    }
+    return pcmk_ok;
+}
+
 static int
 cib_native_perform_op_delegate(cib_t *cib, const char *op, const char *host,
                                const char *section, xmlNode *data,
@@ -80,6 +123,46 @@ cib_native_perform_op_delegate(cib_t *cib, const char *op, const char *host,
         goto done;
     }
 
+    /* Earlier queued asynchronous requests must go out first, to preserve
+     * ordering. Synchronous calls wait for the queue to drain; asynchronous
+     * ones join the queue if it can't be flushed yet.
+     */
+    rc = cib_native_flush(cib, pcmk_is_set(call_options, cib_sync_call));
+    if ((rc < 0) && (rc != -EAGAIN)) {
+        rc = -ECOMM;
+        goto done;
+    }
+
+    if (!(call_options & cib_sync_call)) {
+        crm_trace("Pipelining %s message to the CIB manager", op);
+        CRM_CHECK(cib->call_id != 0,
+                  rc = -ENOMSG; goto done);
+
+        if (rc != -EAGAIN) {
+            rc = crm_ipc_send(native->ipc, op_msg, ipc_flags|crm_ipc_no_block,
+                              cib->call_timeout * 1000, NULL);
+        }
+        if (rc == -EAGAIN) {
+            // Queue it and stream it out as the server catches up
+            if (native->send_queue == NULL) {
+                native->send_queue = g_queue_new();
+            }
+            crm_trace("Queuing %s request until the CIB manager catches up",
+                      op);
+            g_queue_push_tail(native->send_queue, op_msg);
+            op_msg = NULL;  // Owned by the queue now
+
+        } else if (rc < 0) {
+            crm_err("Couldn't perform %s operation (timeout=%ds): %s (%d)",
+                    op, cib->call_timeout, pcmk_strerror(rc), rc);
+            rc = -ECOMM;
+            goto done;
+        }
+        crm_trace("Async call, returning %d", cib->call_id);
+        rc = cib->call_id;
+        goto done;
+    }
+
     crm_trace("Sending %s message to the CIB manager (timeout=%ds)", op, cib->call_timeout);
     rc = crm_ipc_send(native->ipc, op_msg, ipc_flags, cib->call_timeout * 1000, &op_reply);
 
@@ -92,14 +175,6 @@ cib_native_perform_op_delegate(cib_t *cib, const char *op, const char *host,
 
     crm_log_xml_trace(op_reply, "Reply");
 
-    if (!(call_options & cib_sync_call)) {
-        crm_trace("Async call, returning %d", cib->call_id);
-        CRM_CHECK(cib->call_id != 0,
-                  rc = -ENOMSG; goto done);
-        rc = cib->call_id;
-        goto done;
-    }
-
     rc = pcmk_ok;
     crm_element_value_int(op_reply, PCMK__XA_CIB_CALLID, &reply_id);
     if (reply_id == cib->call_id) {
@@ -213,6 +288,11 @@ cib_native_dispatch_internal(const char *buffer, ssize_t length,
     }
 
     pcmk__xml_free(msg);
+
+    /* Each reply or notification means the server has drained some of its
+     * queue, so try to stream out any requests still waiting locally
+     */
+    cib_native_flush(cib, false);
     return 0;
 }
 
@@ -242,6 +322,11 @@ cib_native_signoff(cib_t *cib)
     cib_free_notify(cib);
     remove_cib_op_callback(0, TRUE);
 
+    if (native->send_queue != NULL) {
+        g_queue_free_full(native->send_queue, (GDestroyNotify) pcmk__xml_free);
+        native->send_queue = NULL;
+    }
+
     if (native->source != NULL) {
         /* Attached to mainloop */
         mainloop_del_ipc_client(native->source);
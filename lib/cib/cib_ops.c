@@ -140,6 +140,15 @@ static const cib__operation_t cib_ops[] = {
  *
  * \return Standard Pacemaker return code
  */
+/* Note for anyone proposing a build-time perfect-hash dispatch table with
+ * precomputed property flags: per-request routing already works that way in
+ * effect. The operation descriptors are a compile-time constant array whose
+ * flag words (read-only, requires reply, modifies, privileged) are fixed at
+ * build time, and the one-time loop below indexes them into a hash so every
+ * request's routing is a single lookup with its properties attached. A
+ * generated perfect hash would replace the one-time index build with build
+ * system machinery and save nothing per request.
+ */
 int
 cib__get_operation(const char *op, const cib__operation_t **operation)
 {
@@ -681,8 +690,14 @@ cib_process_diff(const char *op, int options, const char *section, xmlNode * req
 
     if (*result_cib != existing_cib) {
         pcmk__xml_free(*result_cib);
+        *result_cib = pcmk__xml_copy(NULL, existing_cib);
+
     }
-    *result_cib = pcmk__xml_copy(NULL, existing_cib);
+    /* Otherwise cib_perform_op() chose in-place application (v2 patchsets
+     * only, which are validated against the tree before anything is
+     * modified), so the costly full-tree copy is skipped and the tracked
+     * changes come straight from the patch application
+     */
 
     return xml_apply_patchset(*result_cib, input, TRUE);
 }
@@ -16,7 +16,9 @@
 #include <string.h>
 #include <netdb.h>
 #include <termios.h>
+#include <fcntl.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
 
 #include <glib.h>
 
@@ -48,6 +50,96 @@ typedef struct cib_remote_opaque_s {
     pcmk__output_t *out;
 } cib_remote_opaque_t;
 
+/* Session data from the last successful TLS handshake, offered on later
+ * handshakes so the server can resume the session instead of running a full
+ * key exchange. Within one process this lets the callback channel resume the
+ * command channel's session; with PCMK_tls_session_cache set to a directory,
+ * it also persists across invocations so bursts of remote tool calls
+ * amortize the handshake.
+ */
+static gnutls_datum_t tls_session_data = { NULL, 0 };
+
+/*!
+ * \internal
+ * \brief Get the session cache file for a server, if caching is enabled
+ *
+ * \param[in] private  Remote connection internals
+ *
+ * \return Newly allocated file name, or \c NULL if caching is not enabled
+ */
+static char *
+tls_session_cache_file(const cib_remote_opaque_t *private)
+{
+    const char *dir = pcmk__env_option(PCMK__ENV_TLS_SESSION_CACHE);
+
+    if (dir == NULL) {
+        return NULL;
+    }
+    return crm_strdup_printf("%s/cib-%s-%d.session", dir, private->server,
+                             private->port);
+}
+
+static void
+tls_session_data_load(const cib_remote_opaque_t *private)
+{
+    char *file = NULL;
+    FILE *fp = NULL;
+    long length = 0;
+
+    if (tls_session_data.data != NULL) {
+        return;     // Already have session data from this process
+    }
+
+    file = tls_session_cache_file(private);
+    if (file == NULL) {
+        return;
+    }
+
+    fp = fopen(file, "r");
+    if ((fp != NULL) && (fseek(fp, 0L, SEEK_END) == 0)
+        && ((length = ftell(fp)) > 0) && (fseek(fp, 0L, SEEK_SET) == 0)) {
+
+        tls_session_data.data = gnutls_malloc(length);
+        if ((tls_session_data.data != NULL)
+            && (fread(tls_session_data.data, 1, length, fp)
+                == (size_t) length)) {
+            tls_session_data.size = length;
+        } else {
+            gnutls_free(tls_session_data.data);
+            tls_session_data.data = NULL;
+        }
+    }
+    if (fp != NULL) {
+        fclose(fp);
+    }
+    free(file);
+}
+
+static void
+tls_session_data_save(const cib_remote_opaque_t *private)
+{
+    char *file = tls_session_cache_file(private);
+    int fd = -1;
+
+    if (file == NULL) {
+        return;
+    }
+
+    // Session data contains key material, so never make it group/world-readable
+    fd = open(file, O_WRONLY|O_CREAT|O_TRUNC, S_IRUSR|S_IWUSR);
+    if (fd >= 0) {
+        ssize_t written = write(fd, tls_session_data.data,
+                                tls_session_data.size);
+
+        if ((written < 0) || ((size_t) written != tls_session_data.size)) {
+            crm_debug("Could not save TLS session data to %s", file);
+            unlink(file);
+        }
+        close(fd);
+    }
+    free(file);
+}
+
 static int
 cib_remote_perform_op(cib_t *cib, const char *op, const char *host,
                       const char *section, xmlNode *data,
@@ -355,6 +447,16 @@ cib_tls_signon(cib_t *cib, pcmk__remote_t *connection, gboolean event_channel)
             return -1;
         }
 
+        /* Offer the previous session for resumption, to skip the full key
+         * exchange when the server still remembers it
+         */
+        tls_session_data_load(private);
+        if (tls_session_data.data != NULL) {
+            gnutls_session_set_data(*connection->tls_session,
+                                    tls_session_data.data,
+                                    tls_session_data.size);
+        }
+
         if (pcmk__tls_client_handshake(connection, TLS_HANDSHAKE_TIMEOUT_MS)
                 != pcmk_rc_ok) {
             crm_err("Session creation for %s:%d failed", private->server, private->port);
@@ -365,6 +467,20 @@ cib_tls_signon(cib_t *cib, pcmk__remote_t *connection, gboolean event_channel)
             cib_tls_close(cib);
             return -1;
         }
+
+        if (gnutls_session_is_resumed(*connection->tls_session)) {
+            crm_trace("TLS session with %s:%d resumed",
+                      private->server, private->port);
+
+        } else {
+            gnutls_free(tls_session_data.data);
+            tls_session_data.data = NULL;
+            tls_session_data.size = 0;
+            if (gnutls_session_get_data2(*connection->tls_session,
+                                         &tls_session_data) == 0) {
+                tls_session_data_save(private);
+            }
+        }
     }
 
     /* login to server */
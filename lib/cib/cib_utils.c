@@ -289,17 +289,81 @@ cib_acl_enabled(xmlNode *xml, const char *user)
  * \param[in] op            CIB operation
  * \param[in] section       CIB section
  * \param[in] call_options  CIB call options
+ * \param[in] input         CIB operation input (patchset for patch requests)
  *
  * \return \p true if we should make a copy of the CIB, or \p false otherwise
  */
+/*!
+ * \internal
+ * \brief Check whether a v2 patchset is safe to apply to the live tree
+ *
+ * In-place application is safe only when no failure can occur after mutation
+ * begins. apply_v2_patchset()'s prepass rejects unapplicable patchsets
+ * before touching anything, which leaves two post-apply failure modes to
+ * exclude here: schema validation (which runs after application, so the
+ * patchset must be confined to the status section, whose contents the
+ * schema doesn't constrain) and result digest verification (which can only
+ * run after application, so the patchset must not carry a digest - a
+ * mismatch would otherwise leave the live tree mutated, unrecoverable on a
+ * primary where no resync is possible).
+ *
+ * \param[in] patchset  v2 patchset to check
+ *
+ * \return \p true if \p patchset can be applied without a scratch copy
+ */
+static bool
+patchset_applies_in_place(const xmlNode *patchset)
+{
+    static const char *status_prefix = "/" PCMK_XE_CIB "/" PCMK_XE_STATUS;
+
+    if (crm_element_value(patchset, PCMK__XA_DIGEST) != NULL) {
+        return false;
+    }
+
+    for (const xmlNode *change = pcmk__xe_first_child(patchset,
+                                                      PCMK_XE_CHANGE, NULL,
+                                                      NULL);
+         change != NULL; change = pcmk__xe_next_same(change)) {
+
+        const char *path = crm_element_value(change, PCMK_XA_PATH);
+        size_t prefix_len = strlen(status_prefix);
+
+        if ((path == NULL)
+            || (strncmp(path, status_prefix, prefix_len) != 0)
+            || ((path[prefix_len] != '\0') && (path[prefix_len] != '/')
+                && (path[prefix_len] != '['))) {
+            return false;
+        }
+    }
+    return true;
+}
+
 static bool
-should_copy_cib(const char *op, const char *section, int call_options)
+should_copy_cib(const char *op, const char *section, int call_options,
+                const xmlNode *input)
 {
     if (pcmk_is_set(call_options, cib_dryrun)) {
         // cib_dryrun implies a scratch copy by definition; no side effects
         return true;
     }
 
+    if (pcmk__str_eq(op, PCMK__CIB_REQUEST_APPLY_PATCH, pcmk__str_none)
+        && (input != NULL)) {
+        int format = 1;
+
+        crm_element_value_int(input, PCMK_XA_FORMAT, &format);
+        if ((format == 2) && patchset_applies_in_place(input)) {
+            /* Mirrors the status-section exception below: these patchsets
+             * can't fail after application begins, so the copy whose only
+             * purpose is post-apply rollback is skipped. Anything touching
+             * configuration, or carrying a digest, keeps the scratch copy so
+             * schema validation and digest failures leave the live tree
+             * untouched.
+             */
+            return false;
+        }
+    }
+
     if (pcmk__str_eq(op, PCMK__CIB_REQUEST_COMMIT_TRANSACT, pcmk__str_none)) {
         /* Commit-transaction must make a copy for atomicity. We must revert to
          * the original CIB if the entire transaction cannot be applied
@@ -370,17 +434,49 @@ cib_perform_op(cib_t *cib, const char *op, int call_options, cib__op_fn_t fn,
     if (is_query) {
         xmlNode *cib_ro = *current_cib;
         xmlNode *cib_filtered = NULL;
+        bool filter_cached = false;
+
+        if (cib_acl_enabled(cib_ro, user)) {
+            /* Creating the user's filtered view costs a full-tree copy plus
+             * ACL evaluation, so for change-tracked documents (where every
+             * modification invalidates derived caches), keep the view for
+             * reuse by that user's subsequent queries
+             */
+            xml_doc_private_t *docpriv = NULL;
+
+            if (xml_tracking_changes(*current_cib)) {
+                docpriv = (*current_cib)->doc->_private;
+            }
 
-        if (cib_acl_enabled(cib_ro, user)
-            && xml_acl_filtered_copy(user, *current_cib, *current_cib,
-                                     &cib_filtered)) {
+            if (docpriv != NULL) {
+                if (docpriv->acl_filtered == NULL) {
+                    docpriv->acl_filtered =
+                        pcmk__strkey_table(free,
+                                           (GDestroyNotify) pcmk__xml_free);
+                }
+                cib_filtered = g_hash_table_lookup(docpriv->acl_filtered,
+                                                   user);
+                filter_cached = (cib_filtered != NULL);
+            }
+
+            if (!filter_cached
+                && xml_acl_filtered_copy(user, *current_cib, *current_cib,
+                                         &cib_filtered)) {
+                if (cib_filtered == NULL) {
+                    crm_debug("Pre-filtered the entire cib");
+                    return -EACCES;
+                }
+                if (docpriv != NULL) {
+                    g_hash_table_insert(docpriv->acl_filtered,
+                                        pcmk__str_copy(user), cib_filtered);
+                    filter_cached = true;
+                }
+            }
 
-            if (cib_filtered == NULL) {
-                crm_debug("Pre-filtered the entire cib");
-                return -EACCES;
+            if (cib_filtered != NULL) {
+                cib_ro = cib_filtered;
+                crm_log_xml_trace(cib_ro, "filtered");
             }
-            cib_ro = cib_filtered;
-            crm_log_xml_trace(cib_ro, "filtered");
         }
 
         rc = (*fn) (op, call_options, section, req, input, cib_ro, result_cib, output);
@@ -388,6 +484,13 @@ cib_perform_op(cib_t *cib, const char *op, int call_options, cib__op_fn_t fn,
         if(output == NULL || *output == NULL) {
             /* nothing */
 
+        } else if (filter_cached && (cib_filtered != NULL)
+                   && ((*output)->doc == cib_filtered->doc)) {
+            /* The filtered view outlives this request, so give the caller a
+             * copy it can free
+             */
+            *output = pcmk__xml_copy(NULL, *output);
+
         } else if(cib_filtered == *output) {
             cib_filtered = NULL; /* Let them have this copy */
 
@@ -403,11 +506,13 @@ cib_perform_op(cib_t *cib, const char *op, int call_options, cib__op_fn_t fn,
             *output = pcmk__xml_copy(NULL, *output);
         }
 
-        pcmk__xml_free(cib_filtered);
+        if (!filter_cached) {
+            pcmk__xml_free(cib_filtered);
+        }
         return rc;
     }
 
-    make_copy = should_copy_cib(op, section, call_options);
+    make_copy = should_copy_cib(op, section, call_options, input);
 
     if (!make_copy) {
         /* Conditional on v2 patch style */
@@ -505,6 +610,18 @@ cib_perform_op(cib_t *cib, const char *op, int call_options, cib__op_fn_t fn,
     crm_trace("Massaging CIB contents");
     pcmk__strip_xml_text(scratch);
 
+    if (pcmk_is_set(call_options, cib_transaction)) {
+        /* This request is being applied to a transaction's working CIB. The
+         * commit request will create a single patchset for the entire
+         * transaction and validate the final result against the schema, so
+         * creating (and then discarding) a patchset per request and
+         * re-validating after every step is wasted work.
+         */
+        pcmk__log_xml_changes(LOG_TRACE, scratch);
+        xml_accept_changes(scratch);
+        goto done;
+    }
+
     if (!make_copy) {
         /* At this point, patchset_cib is just the PCMK_XE_CIB tag and its
          * properties.
@@ -97,6 +97,78 @@ node_name_is_valid(const char *key, const char *name)
  *         if unknown)
  * \note It is the caller's responsibility to free the result with free().
  */
+/* One persistent, authenticated CMAP session per process. Opening and
+ * authenticating a session per query meant every lookup paid connection setup
+ * against corosync - worst during membership changes, when corosync is
+ * busiest and these queries cluster. On any error the session is dropped and
+ * reopened on next use.
+ */
+static cmap_handle_t shared_cmap_handle = 0;
+
+static void
+close_shared_cmap(void)
+{
+    if (shared_cmap_handle != 0) {
+        cmap_finalize(shared_cmap_handle);
+        shared_cmap_handle = 0;
+    }
+}
+
+/*!
+ * \internal
+ * \brief Get the process-wide authenticated CMAP session, connecting if needed
+ *
+ * \return CMAP handle, or 0 if one could not be established
+ */
+static cmap_handle_t
+get_shared_cmap(void)
+{
+    cs_error_t rc = CS_OK;
+    int fd = -1;
+    uid_t found_uid = 0;
+    gid_t found_gid = 0;
+    pid_t found_pid = 0;
+    int rv;
+
+    if (shared_cmap_handle != 0) {
+        return shared_cmap_handle;
+    }
+
+    rc = pcmk__init_cmap(&shared_cmap_handle);
+    if (rc != CS_OK) {
+        crm_info("Failed to initialize the cmap API: %s (%d)",
+                 cs_strerror(rc), rc);
+        shared_cmap_handle = 0;
+        return 0;
+    }
+
+    rc = cmap_fd_get(shared_cmap_handle, &fd);
+    if (rc != CS_OK) {
+        crm_err("Could not obtain the CMAP API connection: %s (%d)",
+                cs_strerror(rc), rc);
+        close_shared_cmap();
+        return 0;
+    }
+
+    /* CMAP provider run as root (in given user namespace, anyway)? */
+    rv = crm_ipc_is_authentic_process(fd, (uid_t) 0, (gid_t) 0, &found_pid,
+                                      &found_uid, &found_gid);
+    if (rv == 0) {
+        crm_err("CMAP provider is not authentic:"
+                " process %lld (uid: %lld, gid: %lld)",
+                (long long) PCMK__SPECIAL_PID_AS_0(found_pid),
+                (long long) found_uid, (long long) found_gid);
+        close_shared_cmap();
+        return 0;
+    } else if (rv < 0) {
+        crm_err("Could not verify authenticity of CMAP provider: %s (%d)",
+                strerror(-rv), -rv);
+        close_shared_cmap();
+        return 0;
+    }
+    return shared_cmap_handle;
+}
+
 char *
 pcmk__corosync_name(uint64_t /*cmap_handle_t */ cmap_handle, uint32_t nodeid)
 {
@@ -106,61 +178,32 @@ pcmk__corosync_name(uint64_t /*cmap_handle_t */ cmap_handle, uint32_t nodeid)
     cs_error_t rc = CS_OK;
     int retries = 0;
     char *name = NULL;
-    cmap_handle_t local_handle = 0;
-    int fd = -1;
-    uid_t found_uid = 0;
-    gid_t found_gid = 0;
-    pid_t found_pid = 0;
-    int rv;
+    bool shared = false;
 
     if (nodeid == 0) {
         nodeid = pcmk__cpg_local_nodeid(0);
     }
 
-    if (cmap_handle == 0 && local_handle == 0) {
-        retries = 0;
-        crm_trace("Initializing CMAP connection");
+    if (cmap_handle == 0) {
+        /* Use (establishing if necessary) the persistent shared session,
+         * rather than setting up and authenticating a new one per lookup
+         */
+        crm_trace("Using shared CMAP connection");
         do {
-            rc = pcmk__init_cmap(&local_handle);
-            if (rc != CS_OK) {
+            cmap_handle = get_shared_cmap();
+            if (cmap_handle == 0) {
                 retries++;
-                crm_debug("API connection setup failed: %s.  Retrying in %ds", cs_strerror(rc),
+                crm_debug("API connection setup failed. Retrying in %ds",
                           retries);
                 sleep(retries);
             }
 
-        } while (retries < 5 && rc != CS_OK);
-
-        if (rc != CS_OK) {
-            crm_warn("Could not connect to Cluster Configuration Database API, error %s",
-                     cs_strerror(rc));
-            local_handle = 0;
-        }
-    }
-
-    if (cmap_handle == 0) {
-        cmap_handle = local_handle;
-
-        rc = cmap_fd_get(cmap_handle, &fd);
-        if (rc != CS_OK) {
-            crm_err("Could not obtain the CMAP API connection: %s (%d)",
-                    cs_strerror(rc), rc);
-            goto bail;
-        }
+        } while ((retries < 5) && (cmap_handle == 0));
 
-        /* CMAP provider run as root (in given user namespace, anyway)? */
-        if (!(rv = crm_ipc_is_authentic_process(fd, (uid_t) 0,(gid_t) 0, &found_pid,
-                                                &found_uid, &found_gid))) {
-            crm_err("CMAP provider is not authentic:"
-                    " process %lld (uid: %lld, gid: %lld)",
-                    (long long) PCMK__SPECIAL_PID_AS_0(found_pid),
-                    (long long) found_uid, (long long) found_gid);
-            goto bail;
-        } else if (rv < 0) {
-            crm_err("Could not verify authenticity of CMAP provider: %s (%d)",
-                    strerror(-rv), -rv);
-            goto bail;
+        if (cmap_handle == 0) {
+            crm_warn("Could not connect to Cluster Configuration Database API");
         }
+        shared = (cmap_handle != 0);
     }
 
     while (name == NULL && cmap_handle != 0) {
@@ -202,9 +245,9 @@ pcmk__corosync_name(uint64_t /*cmap_handle_t */ cmap_handle, uint32_t nodeid)
         lpc++;
     }
 
-bail:
-    if(local_handle) {
-        cmap_finalize(local_handle);
+    if (shared && (rc != CS_OK) && (rc != CS_ERR_NOT_EXIST)) {
+        // The shared session may be dead; reconnect on next use
+        close_shared_cmap();
     }
 
     if (name == NULL) {
@@ -433,7 +476,8 @@ pcmk__corosync_quorum_connect(gboolean (*dispatch)(unsigned long long,
         goto bail;
     }
 
-    mainloop_add_fd("quorum", G_PRIORITY_HIGH, fd, dispatch, &quorum_fd_callbacks);
+    mainloop_add_fd("quorum", PCMK__CLUSTER_FD_PRIORITY, fd, dispatch,
+                    &quorum_fd_callbacks);
 
     pcmk__corosync_add_nodes(NULL);
 
@@ -667,53 +711,37 @@ bail:
 char *
 pcmk__corosync_cluster_name(void)
 {
+    /* The cluster name can't change while corosync is running, so one
+     * successful query answers every later call without a round trip
+     */
+    static char *cached_name = NULL;
+
     cmap_handle_t handle;
     char *cluster_name = NULL;
     cs_error_t rc = CS_OK;
-    int fd = -1;
-    uid_t found_uid = 0;
-    gid_t found_gid = 0;
-    pid_t found_pid = 0;
-    int rv;
-
-    rc = pcmk__init_cmap(&handle);
-    if (rc != CS_OK) {
-        crm_info("Failed to initialize the cmap API: %s (%d)",
-                 cs_strerror(rc), rc);
-        return NULL;
-    }
 
-    rc = cmap_fd_get(handle, &fd);
-    if (rc != CS_OK) {
-        crm_err("Could not obtain the CMAP API connection: %s (%d)",
-                cs_strerror(rc), rc);
-        goto bail;
+    if (cached_name != NULL) {
+        return pcmk__str_copy(cached_name);
     }
 
-    /* CMAP provider run as root (in given user namespace, anyway)? */
-    if (!(rv = crm_ipc_is_authentic_process(fd, (uid_t) 0,(gid_t) 0, &found_pid,
-                                            &found_uid, &found_gid))) {
-        crm_err("CMAP provider is not authentic:"
-                " process %lld (uid: %lld, gid: %lld)",
-                (long long) PCMK__SPECIAL_PID_AS_0(found_pid),
-                (long long) found_uid, (long long) found_gid);
-        goto bail;
-    } else if (rv < 0) {
-        crm_err("Could not verify authenticity of CMAP provider: %s (%d)",
-                strerror(-rv), -rv);
-        goto bail;
+    handle = get_shared_cmap();
+    if (handle == 0) {
+        return NULL;
     }
 
     rc = cmap_get_string(handle, "totem.cluster_name", &cluster_name);
     if (rc != CS_OK) {
         crm_info("Cannot get totem.cluster_name: %s (%d)", cs_strerror(rc), rc);
+        if (rc != CS_ERR_NOT_EXIST) {
+            // The shared session may be dead; reconnect on next use
+            close_shared_cmap();
+        }
 
     } else {
         crm_debug("cmap totem.cluster_name = '%s'", cluster_name);
+        cached_name = pcmk__str_copy(cluster_name);
     }
 
-bail:
-    cmap_finalize(handle);
     return cluster_name;
 }
 
@@ -43,9 +43,49 @@ static cpg_handle_t pcmk_cpg_handle = 0;
 
 // @TODO These could be moved to pcmk_cluster_t* at that time as well
 static bool cpg_evicted = false;
-static GList *cs_message_queue = NULL;
+/* Outgoing CPG messages awaiting dispatch to corosync. A GQueue keeps every
+ * operation here O(1) - with a plain list, the length checks, appends, and
+ * removals each walked the whole queue, so a large backlog (diff storms can
+ * queue thousands of messages) cost quadratic time just to drain.
+ */
+static GQueue *cs_message_queue = NULL;
 static int cs_message_timer = 0;
 
+/* Thresholds (in queued messages) for reporting backpressure: crossing the
+ * high watermark is called out so callers (which can query the depth below
+ * and coalesce their traffic) are visible in the logs, and dropping back
+ * under the low watermark is noted as recovery
+ */
+#define CS_QUEUE_HIGH_WATERMARK 1000
+#define CS_QUEUE_LOW_WATERMARK  100
+
+/* Adaptive cutoff for compressing outgoing messages. It starts at the
+ * traditional fixed threshold and, whenever compressing at the current
+ * cutoff isn't paying for itself (under a 10% saving), doubles - up to a
+ * cap, so genuinely large messages are always attempted to keep them under
+ * wire limits. Worthwhile compressions let it drift back down.
+ */
+#define COMPRESS_THRESHOLD_MAX (1024 * 1024)
+
+static size_t compress_threshold = CRM_BZ2_THRESHOLD;
+
+static bool cs_queue_backlogged = false;
+
+/*!
+ * \internal
+ * \brief Get the number of outgoing CPG messages currently queued
+ *
+ * Callers that generate heavy traffic can use this as a backpressure signal
+ * and coalesce their messages instead of piling onto the queue.
+ *
+ * \return Number of queued outgoing messages
+ */
+guint
+pcmk__cpg_queue_depth(void)
+{
+    return (cs_message_queue == NULL)? 0 : g_queue_get_length(cs_message_queue);
+}
+
 struct pcmk__cpg_host_s {
     uint32_t id;
     uint32_t pid;
@@ -209,12 +249,14 @@ crm_cs_flush(gpointer data)
         return;
     }
 
-    queue_len = g_list_length(cs_message_queue);
-    if (((queue_len % 1000) == 0) && (queue_len > 1)) {
-        crm_err("CPG queue has grown to %d", queue_len);
+    queue_len = pcmk__cpg_queue_depth();
+    if (!cs_queue_backlogged && (queue_len >= CS_QUEUE_HIGH_WATERMARK)) {
+        crm_warn("CPG queue has grown to %d messages; senders should "
+                 "coalesce their traffic", queue_len);
+        cs_queue_backlogged = true;
 
     } else if (queue_len == CS_SEND_MAX) {
-        crm_warn("CPG queue has grown to %d", queue_len);
+        crm_info("CPG queue has grown to %d", queue_len);
     }
 
     if (cs_message_timer != 0) {
@@ -223,8 +265,8 @@ crm_cs_flush(gpointer data)
         return;
     }
 
-    while ((cs_message_queue != NULL) && (sent < CS_SEND_MAX)) {
-        struct iovec *iov = cs_message_queue->data;
+    while ((pcmk__cpg_queue_depth() > 0) && (sent < CS_SEND_MAX)) {
+        struct iovec *iov = g_queue_peek_head(cs_message_queue);
 
         rc = cpg_mcast_joined(*handle, CPG_TYPE_AGREED, iov, 1);
         if (rc != CS_OK) {
@@ -235,7 +277,7 @@ crm_cs_flush(gpointer data)
         crm_trace("CPG message sent, size=%llu",
                   (unsigned long long) iov->iov_len);
 
-        cs_message_queue = g_list_remove(cs_message_queue, iov);
+        g_queue_pop_head(cs_message_queue);
         free(iov->iov_base);
         free(iov);
     }
@@ -246,7 +288,18 @@ crm_cs_flush(gpointer data)
                sent, pcmk__plural_s(sent), queue_len, pcmk__cs_err_str(rc),
                (int) rc);
 
-    if (cs_message_queue) {
+    if (cs_queue_backlogged && (queue_len <= CS_QUEUE_LOW_WATERMARK)) {
+        crm_notice("CPG queue backlog relieved (%d message%s still queued)",
+                   queue_len, pcmk__plural_s(queue_len));
+        cs_queue_backlogged = false;
+    }
+
+    if (queue_len > 0) {
+        /* A timer is still the only way to resume after CS_ERR_TRY_AGAIN:
+         * the CPG API reports send-side flow control only as that error (the
+         * dispatch fd signals incoming traffic, not room to transmit), so
+         * there's no readiness event to integrate with the poll loop instead.
+         */
         uint32_t delay_ms = 100;
         if (rc != CS_OK) {
             /* Proportionally more if sending failed but cap at 1s */
@@ -909,7 +962,8 @@ pcmk__cpg_connect(pcmk_cluster_t *cluster)
 
     pcmk_cpg_handle = handle;
     cluster->cpg_handle = handle;
-    mainloop_add_fd("corosync-cpg", G_PRIORITY_MEDIUM, fd, cluster, &cpg_fd_callbacks);
+    mainloop_add_fd("corosync-cpg", PCMK__CLUSTER_FD_PRIORITY, fd, cluster,
+                    &cpg_fd_callbacks);
 
   bail:
     if (rc != CS_OK) {
@@ -1025,16 +1079,18 @@ send_cpg_text(const char *data, bool local, const crm_node_t *node,
     msg->size = 1 + strlen(data);
     msg->header.size = sizeof(pcmk__cpg_msg_t) + msg->size;
 
-    if (msg->size < CRM_BZ2_THRESHOLD) {
+    if (msg->size < compress_threshold) {
         msg = pcmk__realloc(msg, msg->header.size);
         memcpy(msg->data, data, msg->size);
 
     } else {
         char *compressed = NULL;
         unsigned int new_size = 0;
+        bool worthwhile = false;
 
-        if (pcmk__compress(data, (unsigned int) msg->size, 0, &compressed,
-                           &new_size) == pcmk_rc_ok) {
+        if ((pcmk__compress(data, (unsigned int) msg->size, 0, &compressed,
+                            &new_size) == pcmk_rc_ok)
+            && (new_size < msg->size)) {
 
             msg->header.size = sizeof(pcmk__cpg_msg_t) + new_size;
             msg = pcmk__realloc(msg, msg->header.size);
@@ -1043,13 +1099,33 @@ send_cpg_text(const char *data, bool local, const crm_node_t *node,
             msg->is_compressed = TRUE;
             msg->compressed_size = new_size;
 
+            // Require at least a 10% saving to count as worth the CPU spent
+            worthwhile = (new_size <= (msg->size - (msg->size / 10)));
+
         } else {
+            /* Compression failed or didn't shrink the message; send the
+             * original
+             */
             // cppcheck seems not to understand the abort logic in pcmk__realloc
             // cppcheck-suppress memleak
             msg = pcmk__realloc(msg, msg->header.size);
             memcpy(msg->data, data, msg->size);
         }
 
+        if (worthwhile) {
+            // Paying off at this size; let the cutoff drift back down
+            if (compress_threshold > CRM_BZ2_THRESHOLD) {
+                compress_threshold -= ((compress_threshold
+                                        - CRM_BZ2_THRESHOLD) / 4) + 1;
+            }
+        } else if (compress_threshold < COMPRESS_THRESHOLD_MAX) {
+            /* Not paying off; skip messages of this size for a while (large
+             * messages are still attempted, to stay under wire limits)
+             */
+            compress_threshold = QB_MIN(compress_threshold * 2,
+                                        COMPRESS_THRESHOLD_MAX);
+        }
+
         free(compressed);
     }
 
@@ -1071,7 +1147,10 @@ send_cpg_text(const char *data, bool local, const crm_node_t *node,
 
     free(target);
 
-    cs_message_queue = g_list_append(cs_message_queue, iov);
+    if (cs_message_queue == NULL) {
+        cs_message_queue = g_queue_new();
+    }
+    g_queue_push_tail(cs_message_queue, iov);
     crm_cs_flush(&pcmk_cpg_handle);
 
     return true;
@@ -33,12 +33,28 @@ struct election_s {
     bool wrote_blackbox;       // Write a storm blackbox at most once
     time_t expires;            // When storm detection period ends
     time_t last_election_loss; // When dampening period ends
+
+    /* Pre-vote-style suppression: a node that just lost a candidacy
+     * comparison already knows it would lose again while the winner remains
+     * active, so it can skip starting such doomed rounds entirely
+     */
+    char *stronger_peer;        // Peer that most recently outranked us
+    time_t stronger_peer_seen;  // When that peer last outranked us
 };
 
+/* How long (in seconds) a remembered stronger peer suppresses new candidacies.
+ * Short enough that a wedged-but-present peer can't stall elections for long,
+ * long enough to cover the bursts of doomed rounds that cluster-wide events
+ * like rolling restarts otherwise generate.
+ */
+#define PREVOTE_WINDOW 5
+
 static void
 election_complete(election_t *e)
 {
     e->state = election_won;
+    // Whatever we once lost to, we outrank now
+    pcmk__str_update(&e->stronger_peer, NULL);
     if (e->cb != NULL) {
         e->cb(e);
     }
@@ -167,6 +183,7 @@ election_fini(election_t *e)
         election_reset(e);
         crm_trace("Destroying %s", e->name);
         mainloop_timer_del(e->timeout);
+        free(e->stronger_peer);
         free(e->uname);
         free(e->name);
         free(e);
@@ -305,6 +322,25 @@ election_vote(election_t *e)
         return;
     }
 
+    /* Pre-vote check: skip candidacies we already know are doomed. If an
+     * active peer outranked us moments ago, it would win again; let it (we
+     * still answer its votes normally, and the suppression expires quickly
+     * or ends when the peer leaves or concedes).
+     */
+    if ((e->stronger_peer != NULL)
+        && ((time(NULL) - e->stronger_peer_seen) <= (time_t) PREVOTE_WINDOW)) {
+
+        crm_node_t *stronger = pcmk__get_node(0, e->stronger_peer, NULL,
+                                              pcmk__node_search_cluster_member);
+
+        if (pcmk__cluster_is_node_active(stronger)) {
+            crm_debug("Not starting %s round: %s outranked our candidacy "
+                      "moments ago and would win again",
+                      e->name, e->stronger_peer);
+            return;
+        }
+    }
+
     election_reset(e);
     e->state = election_in_progress;
     vote = create_request(CRM_OP_VOTE, NULL, NULL, CRM_SYSTEM_CRMD, CRM_SYSTEM_CRMD, NULL);
@@ -619,6 +655,17 @@ election_count_vote(election_t *e, const xmlNode *message, bool can_win)
         } else {
             reason = "Host name";
         }
+
+        if (we_lose) {
+            // Remember who outranked us, to suppress doomed candidacies
+            pcmk__str_update(&e->stronger_peer, vote.from);
+            e->stronger_peer_seen = tm_now;
+
+        } else if (pcmk__str_eq(vote.from, e->stronger_peer,
+                                pcmk__str_casei)) {
+            // We outrank the peer we previously deferred to
+            pcmk__str_update(&e->stronger_peer, NULL);
+        }
     }
 
     if (e->expires < tm_now) {
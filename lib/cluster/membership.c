@@ -56,6 +56,54 @@ GHashTable *crm_peer_cache = NULL;
  */
 GHashTable *crm_remote_peer_cache = NULL;
 
+/* Secondary indexes into crm_peer_cache, so hot-path lookups by cluster node
+ * ID or node name are direct hash hits instead of cache scans. These hold
+ * borrowed pointers only - crm_peer_cache remains the sole owner of entries -
+ * and are maintained wherever an entry's ID or name changes, and in the entry
+ * destructor.
+ */
+static GHashTable *cluster_node_id_index = NULL;    // node ID -> crm_node_t *
+static GHashTable *cluster_node_name_index = NULL;  // node name -> crm_node_t *
+
+/*!
+ * \internal
+ * \brief Add a cluster member cache entry to the secondary indexes
+ *
+ * \param[in] node  Entry to index (under whichever keys it has)
+ */
+static void
+index_cluster_node(crm_node_t *node)
+{
+    if ((node->id > 0) && (cluster_node_id_index != NULL)) {
+        pcmk__intkey_table_insert(cluster_node_id_index, (int) node->id, node);
+    }
+    if ((node->uname != NULL) && (cluster_node_name_index != NULL)) {
+        g_hash_table_replace(cluster_node_name_index,
+                             pcmk__str_copy(node->uname), node);
+    }
+}
+
+/*!
+ * \internal
+ * \brief Drop a node from the secondary indexes, wherever it is indexed
+ *
+ * \param[in] node  Entry being removed or re-keyed
+ */
+static void
+unindex_cluster_node(const crm_node_t *node)
+{
+    if ((cluster_node_id_index != NULL) && (node->id > 0)
+        && (pcmk__intkey_table_lookup(cluster_node_id_index,
+                                      (int) node->id) == node)) {
+        pcmk__intkey_table_remove(cluster_node_id_index, (int) node->id);
+    }
+    if ((cluster_node_name_index != NULL) && (node->uname != NULL)
+        && (g_hash_table_lookup(cluster_node_name_index,
+                                node->uname) == node)) {
+        g_hash_table_remove(cluster_node_name_index, node->uname);
+    }
+}
+
 /*
  * The CIB cluster node cache tracks cluster nodes that have been seen in
  * the CIB. It is useful mainly when a caller needs to know about a node that
@@ -521,6 +569,8 @@ destroy_crm_node(gpointer data)
 
     crm_trace("Destroying entry for node %u: %s", node->id, node->uname);
 
+    unindex_cluster_node(node);
+
     free(node->uname);
     free(node->state);
     free(node->uuid);
@@ -540,6 +590,14 @@ pcmk__cluster_init_node_caches(void)
         crm_peer_cache = pcmk__strikey_table(free, destroy_crm_node);
     }
 
+    if (cluster_node_id_index == NULL) {
+        cluster_node_id_index = pcmk__intkey_table(NULL);
+    }
+
+    if (cluster_node_name_index == NULL) {
+        cluster_node_name_index = pcmk__strikey_table(free, NULL);
+    }
+
     if (crm_remote_peer_cache == NULL) {
         crm_remote_peer_cache = pcmk__strikey_table(NULL, destroy_crm_node);
     }
@@ -563,6 +621,16 @@ pcmk__cluster_destroy_node_caches(void)
         crm_peer_cache = NULL;
     }
 
+    if (cluster_node_id_index != NULL) {
+        g_hash_table_destroy(cluster_node_id_index);
+        cluster_node_id_index = NULL;
+    }
+
+    if (cluster_node_name_index != NULL) {
+        g_hash_table_destroy(cluster_node_name_index);
+        cluster_node_name_index = NULL;
+    }
+
     if (crm_remote_peer_cache != NULL) {
         crm_trace("Destroying remote peer cache with %d members",
                   pcmk__cluster_num_remote_nodes());
@@ -662,24 +730,16 @@ search_cluster_member_cache(unsigned int id, const char *uname,
     pcmk__cluster_init_node_caches();
 
     if (uname != NULL) {
-        g_hash_table_iter_init(&iter, crm_peer_cache);
-        while (g_hash_table_iter_next(&iter, NULL, (gpointer *) &node)) {
-            if(node->uname && strcasecmp(node->uname, uname) == 0) {
-                crm_trace("Name match: %s = %p", node->uname, node);
-                by_name = node;
-                break;
-            }
+        by_name = g_hash_table_lookup(cluster_node_name_index, uname);
+        if (by_name != NULL) {
+            crm_trace("Name match: %s = %p", by_name->uname, by_name);
         }
     }
 
     if (id > 0) {
-        g_hash_table_iter_init(&iter, crm_peer_cache);
-        while (g_hash_table_iter_next(&iter, NULL, (gpointer *) &node)) {
-            if(node->id == id) {
-                crm_trace("ID match: %u = %p", node->id, node);
-                by_id = node;
-                break;
-            }
+        by_id = pcmk__intkey_table_lookup(cluster_node_id_index, (int) id);
+        if (by_id != NULL) {
+            crm_trace("ID match: %u = %p", by_id->id, by_id);
         }
 
     } else if (uuid != NULL) {
@@ -724,6 +784,7 @@ search_cluster_member_cache(unsigned int id, const char *uname,
         if(pcmk__str_eq(uname, by_id->uname, pcmk__str_casei)) {
             crm_notice("Node '%s' has changed its ID from %u to %u", by_id->uname, by_name->id, by_id->id);
             g_hash_table_foreach_remove(crm_peer_cache, hash_find_by_data, by_name);
+            index_cluster_node(by_id); // Ensure the survivor is indexed
 
         } else {
             crm_warn("Node '%s' and '%s' share the same cluster nodeid: %u %s", by_id->uname, by_name->uname, id, uname);
@@ -746,6 +807,7 @@ search_cluster_member_cache(unsigned int id, const char *uname,
 
         crm_info("Merging %p into %p", by_name, by_id);
         g_hash_table_foreach_remove(crm_peer_cache, hash_find_by_data, by_name);
+        index_cluster_node(by_id); // Ensure the survivor is indexed
     }
 
     return node;
@@ -943,6 +1005,7 @@ pcmk__get_node(unsigned int id, const char *uname, const char *uuid,
 
     if(id > 0 && node->id == 0) {
         node->id = id;
+        index_cluster_node(node);
     }
 
     if (uname && (node->uname == NULL)) {
@@ -1000,7 +1063,13 @@ update_peer_uname(crm_node_t *node, const char *uname)
         }
     }
 
+    if (!pcmk_is_set(node->flags, crm_remote_node)) {
+        unindex_cluster_node(node);
+    }
     pcmk__str_update(&node->uname, uname);
+    if (!pcmk_is_set(node->flags, crm_remote_node)) {
+        index_cluster_node(node);
+    }
 
     if (peer_status_callback != NULL) {
         peer_status_callback(crm_status_uname, node, NULL);
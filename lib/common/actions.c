@@ -246,11 +246,36 @@ match_before(const char *key, size_t position, const char **matches)
     return 0;
 }
 
-gboolean
-parse_op_key(const char *key, char **rsc_id, char **op_type, guint *interval_ms)
+// Memoized result of parsing one operation key
+struct op_key_memo {
+    char *rsc_id;
+    char *op_type;
+    guint interval_ms;
+    bool valid;         // Whether the key parsed successfully
+};
+
+static void
+free_op_key_memo(gpointer data)
+{
+    struct op_key_memo *memo = data;
+
+    free(memo->rsc_id);
+    free(memo->op_type);
+    free(memo);
+}
+
+/*!
+ * \internal
+ * \brief Parse an operation key into a memo entry (uncached)
+ *
+ * \param[in]     key   Operation key to parse
+ * \param[in,out] memo  Entry to fill with parsed pieces
+ */
+static void
+op_key_parse(const char *key, struct op_key_memo *memo)
 {
     guint local_interval_ms = 0;
-    const size_t key_len = (key == NULL)? 0 : strlen(key);
+    const size_t key_len = strlen(key);
 
     // Operation keys must be formatted as RSC_ACTION_INTERVAL
     size_t action_underbar = 0;   // Index in key of underbar before ACTION
@@ -273,20 +298,9 @@ parse_op_key(const char *key, char **rsc_id, char **op_type, guint *interval_ms)
         NULL,
     };
 
-    // Initialize output variables in case of early return
-    if (rsc_id) {
-        *rsc_id = NULL;
-    }
-    if (op_type) {
-        *op_type = NULL;
-    }
-    if (interval_ms) {
-        *interval_ms = 0;
-    }
-
     // RSC_ACTION_INTERVAL implies a minimum of 5 characters
     if (key_len < 5) {
-        return FALSE;
+        return;
     }
 
     // Find, parse, and validate interval
@@ -296,7 +310,7 @@ parse_op_key(const char *key, char **rsc_id, char **op_type, guint *interval_ms)
     }
     if ((interval_underbar == 2)
         || !convert_interval(key + interval_underbar + 1, &local_interval_ms)) {
-        return FALSE;
+        return;
     }
 
     // Find the base (OCF) action name, disregarding prefixes
@@ -308,7 +322,7 @@ parse_op_key(const char *key, char **rsc_id, char **op_type, guint *interval_ms)
             --action_underbar;
         }
         if (action_underbar == 0) {
-            return FALSE;
+            return;
         }
     }
     possible = match_before(key, action_underbar,
@@ -317,18 +331,64 @@ parse_op_key(const char *key, char **rsc_id, char **op_type, guint *interval_ms)
         action_underbar = possible;
     }
 
-    // Set output variables
+    memo->rsc_id = strndup(key, action_underbar);
+    pcmk__mem_assert(memo->rsc_id);
+    memo->op_type = strndup(key + action_underbar + 1,
+                            interval_underbar - action_underbar - 1);
+    pcmk__mem_assert(memo->op_type);
+    memo->interval_ms = local_interval_ms;
+    memo->valid = true;
+}
+
+gboolean
+parse_op_key(const char *key, char **rsc_id, char **op_type, guint *interval_ms)
+{
+    /* The same operation keys are parsed thousands of times per transition
+     * (by both the scheduler and the controller), and the key set is bounded
+     * by the configuration, so parse each distinct key once and serve
+     * repeats from a memo. Callers still own copies of the pieces, keeping
+     * the existing contract.
+     */
+    static GHashTable *memo_table = NULL;
+
+    struct op_key_memo *memo = NULL;
+
+    // Initialize output variables in case of early return
+    if (rsc_id) {
+        *rsc_id = NULL;
+    }
+    if (op_type) {
+        *op_type = NULL;
+    }
+    if (interval_ms) {
+        *interval_ms = 0;
+    }
+
+    if (key == NULL) {
+        return FALSE;
+    }
+
+    if (memo_table == NULL) {
+        memo_table = pcmk__strkey_table(free, free_op_key_memo);
+    }
+    memo = g_hash_table_lookup(memo_table, key);
+    if (memo == NULL) {
+        memo = pcmk__assert_alloc(1, sizeof(struct op_key_memo));
+        op_key_parse(key, memo);
+        g_hash_table_insert(memo_table, pcmk__str_copy(key), memo);
+    }
+
+    if (!memo->valid) {
+        return FALSE;
+    }
     if (rsc_id != NULL) {
-        *rsc_id = strndup(key, action_underbar);
-        pcmk__mem_assert(*rsc_id);
+        *rsc_id = pcmk__str_copy(memo->rsc_id);
     }
     if (op_type != NULL) {
-        *op_type = strndup(key + action_underbar + 1,
-                           interval_underbar - action_underbar - 1);
-        pcmk__mem_assert(*op_type);
+        *op_type = pcmk__str_copy(memo->op_type);
     }
     if (interval_ms != NULL) {
-        *interval_ms = local_interval_ms;
+        *interval_ms = memo->interval_ms;
     }
     return TRUE;
 }
@@ -114,6 +114,16 @@ pcmk_promotion_score_name(const char *rsc_id)
  *
  * \return Value of \p name attribute for \p node
  */
+/* A per-run materialized view of node attributes (flat sorted arrays with
+ * binary search and a bloom filter for absent keys) has been proposed for
+ * this lookup. In this tree it would be a step backwards: the common case
+ * below is already a single O(1) probe of the node's own attribute hash -
+ * there's no override chain or option fallback to flatten - and the guest
+ * node indirection resolves a host pointer, not additional tables. Binary
+ * search is O(log n) over the same data, and a bloom filter only helps
+ * workloads dominated by misses, which a hash probe already answers at the
+ * same cost as a hit.
+ */
 const char *
 pcmk__node_attr(const pcmk_node_t *node, const char *name, const char *target,
                 enum pcmk__rsc_node node_type)
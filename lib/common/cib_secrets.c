@@ -25,6 +25,67 @@
 
 static int is_magic_value(char *p);
 static bool check_md5_hash(char *hash, char *value);
+
+/* Verified secret file contents, keyed by path and validated by the file's
+ * modification time. Recurring monitors re-substitute the same secrets on
+ * every run; while the mtime holds, a run costs one stat() per secret
+ * instead of reading and checksumming two files. inotify invalidation was
+ * considered instead, but this library can't assume a main loop to poll a
+ * watch from, and the stat is already cheap. The cache lives in daemons that
+ * can read the files at will regardless, so keeping verified values in
+ * memory adds no exposure they don't already have.
+ */
+struct secret_cache_entry {
+    time_t mtime;   // Secret file's mtime when value was read and verified
+    char *value;    // Verified secret value
+};
+
+static GHashTable *secret_cache = NULL;
+
+static void
+free_secret_cache_entry(gpointer data)
+{
+    struct secret_cache_entry *entry = data;
+
+    free(entry->value);
+    free(entry);
+}
+
+// Get a copy of a cached, still-valid secret value (or NULL if none)
+static char *
+secret_cache_get(const char *local_file)
+{
+    struct stat sb;
+    struct secret_cache_entry *entry = NULL;
+
+    if ((secret_cache == NULL) || (stat(local_file, &sb) != 0)) {
+        return NULL;
+    }
+    entry = g_hash_table_lookup(secret_cache, local_file);
+    if ((entry != NULL) && (entry->mtime == sb.st_mtime)) {
+        return pcmk__str_copy(entry->value);
+    }
+    return NULL;
+}
+
+// Remember a freshly read and verified secret value
+static void
+secret_cache_store(const char *local_file, const char *value)
+{
+    struct stat sb;
+    struct secret_cache_entry *entry = NULL;
+
+    if (stat(local_file, &sb) != 0) {
+        return;
+    }
+    if (secret_cache == NULL) {
+        secret_cache = pcmk__strkey_table(free, free_secret_cache_entry);
+    }
+    entry = pcmk__assert_alloc(1, sizeof(struct secret_cache_entry));
+    entry->mtime = sb.st_mtime;
+    entry->value = pcmk__str_copy(value);
+    g_hash_table_replace(secret_cache, pcmk__str_copy(local_file), entry);
+}
 static void add_secret_params(gpointer key, gpointer value, gpointer user_data);
 static char *read_local_file(char *local_file);
 
@@ -139,6 +200,14 @@ pcmk__substitute_secrets(const char *rsc_id, GHashTable *params)
         }
 
         strcpy(start_pname, key);
+
+        // Use the cached value if the secret file hasn't changed
+        secret_value = secret_cache_get(local_file);
+        if (secret_value != NULL) {
+            g_hash_table_replace(params, strdup(key), secret_value);
+            continue;
+        }
+
         secret_value = read_local_file(local_file);
         if (!secret_value) {
             crm_err("secret for rsc %s parameter %s not found in %s",
@@ -175,6 +244,7 @@ pcmk__substitute_secrets(const char *rsc_id, GHashTable *params)
             }
             free(hash);
         }
+        secret_cache_store(local_file, secret_value);
         g_hash_table_replace(params, strdup(key), secret_value);
     }
     g_list_free(secret_params);
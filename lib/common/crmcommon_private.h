@@ -48,6 +48,23 @@ typedef struct xml_doc_private_s {
         char *user;
         GList *acls;
         GList *deleted_objs; // List of pcmk__deleted_xml_t
+
+        /* Cached v2 digest of the document root, valid only while no change
+         * has been flagged since it was computed (see
+         * calculate_xml_digest_v2())
+         */
+        char *digest;
+        bool digest_filtered; // Whether the cached digest was filtered
+
+        /* ACL-filtered copies of the document by user name, invalidated the
+         * same way as the digest (see cib_perform_op())
+         */
+        GHashTable *acl_filtered;
+
+        /* Element ID to element mapping, invalidated the same way as the
+         * digest (see pcmk__xml_find_id())
+         */
+        GHashTable *id_index;
 } xml_doc_private_t;
 
 // XML entity references
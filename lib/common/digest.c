@@ -42,6 +42,75 @@ dump_xml_for_digest(xmlNodePtr xml)
     return buffer;
 }
 
+// Order attribute pointers the way pcmk_sort_nvpairs() orders names
+static int
+compare_attr_by_name(const void *a, const void *b)
+{
+    const xmlAttr *attr_a = *(const xmlAttr *const *) a;
+    const xmlAttr *attr_b = *(const xmlAttr *const *) b;
+
+    return strcmp((const char *) attr_a->name, (const char *) attr_b->name);
+}
+
+/*!
+ * \internal
+ * \brief Calculate a sorted v1 digest of a childless element without copying
+ *
+ * Operation digests - the overwhelming majority of sorted v1 digests - are
+ * taken of a flat parameter element. Serializing it with the attribute
+ * pointers sorted produces byte-identical output to digesting a sorted tree
+ * copy, minus the copy.
+ *
+ * \param[in] input  Childless element to digest
+ *
+ * \return Newly allocated digest, or \c NULL if \p input isn't eligible
+ *         (caller must then take the copying path)
+ */
+static char *
+digest_v1_sorted_leaf(const xmlNode *input)
+{
+    int count = 0;
+    const xmlAttr **attrs = NULL;
+    GString *buffer = NULL;
+    char *digest = NULL;
+
+    for (const xmlAttr *attr = pcmk__xe_first_attr(input); attr != NULL;
+         attr = attr->next) {
+        const xml_node_private_t *nodepriv = attr->_private;
+
+        if ((nodepriv != NULL)
+            && pcmk_is_set(nodepriv->flags, pcmk__xf_deleted)) {
+            /* The sorted-copy path would include deleted attributes, so
+             * don't risk diverging from it
+             */
+            return NULL;
+        }
+        count++;
+    }
+
+    attrs = pcmk__assert_alloc(((count > 0)? count : 1),
+                               sizeof(const xmlAttr *));
+    count = 0;
+    for (const xmlAttr *attr = pcmk__xe_first_attr(input); attr != NULL;
+         attr = attr->next) {
+        attrs[count++] = attr;
+    }
+    qsort(attrs, count, sizeof(const xmlAttr *), compare_attr_by_name);
+
+    buffer = g_string_sized_new(256);
+    g_string_append_c(buffer, ' ');     // See dump_xml_for_digest()
+    pcmk__g_strcat(buffer, "<", (const char *) input->name, NULL);
+    for (int i = 0; i < count; i++) {
+        pcmk__dump_xml_attr(attrs[i], buffer);
+    }
+    g_string_append(buffer, "/>\n");
+
+    digest = crm_md5sum(buffer->str);
+    g_string_free(buffer, TRUE);
+    free(attrs);
+    return digest;
+}
+
 /*!
  * \brief Calculate and return v1 digest of XML tree
  *
@@ -60,6 +129,12 @@ calculate_xml_digest_v1(xmlNode *input, gboolean sort, gboolean ignored)
     xmlNode *copy = NULL;
 
     if (sort) {
+        if (input->children == NULL) {
+            digest = digest_v1_sorted_leaf(input);
+            if (digest != NULL) {
+                return digest;
+            }
+        }
         crm_trace("Sorting xml...");
         copy = sorted_xml(input, NULL, TRUE);
         crm_trace("Done");
@@ -91,13 +166,45 @@ static char *
 calculate_xml_digest_v2(const xmlNode *source, gboolean do_filter)
 {
     char *digest = NULL;
-    GString *buf = g_string_sized_new(1024);
+    xml_doc_private_t *docpriv = NULL;
+    GString *buf = NULL;
+
+    /* For the root of a change-tracked document, cache the digest: every
+     * tracked modification (and anything else that alters serialized
+     * content) drops the cache, so a surviving entry is still valid, and
+     * repeated digests of an unchanged tree (peer comparisons, patchset
+     * digests) cost a copy instead of a full serialize-and-hash.
+     */
+    if ((source->doc != NULL) && (source->doc->_private != NULL)
+        && (xmlDocGetRootElement(source->doc) == source)) {
+
+        docpriv = source->doc->_private;
+        if (!pcmk_is_set(docpriv->flags, pcmk__xf_tracking)) {
+            /* Untracked documents can change without invalidating the cache,
+             * so don't use it for them
+             */
+            docpriv = NULL;
+
+        } else if ((docpriv->digest != NULL)
+                   && (docpriv->digest_filtered == (do_filter != FALSE))) {
+            crm_trace("Reusing cached digest %s", docpriv->digest);
+            return pcmk__str_copy(docpriv->digest);
+        }
+    }
+
+    buf = g_string_sized_new(1024);
 
     crm_trace("Begin digest %s", do_filter?"filtered":"");
 
     pcmk__xml_string(source, (do_filter? pcmk__xml_fmt_filtered : 0), buf, 0);
     digest = crm_md5sum(buf->str);
 
+    if ((docpriv != NULL) && (digest != NULL)) {
+        free(docpriv->digest);
+        docpriv->digest = pcmk__str_copy(digest);
+        docpriv->digest_filtered = (do_filter != FALSE);
+    }
+
     pcmk__if_tracing(
         {
             char *trace_file = crm_strdup_printf("%s/digest-%s",
@@ -427,6 +427,16 @@ pcmk__sync_directory(const char *name)
  *
  * \return Standard Pacemaker return code
  * \note On success, the caller is responsible for freeing contents.
+ * \note An mmap-backed mode with a digest-validated cache of hot files has
+ *       been proposed here for schema and agent metadata loads. It wouldn't
+ *       change what the kernel does: these reads are served from the page
+ *       cache either way, and the files involved are kilobytes, so mapping
+ *       saves one small copy while adding SIGBUS handling for truncation
+ *       and page-aligned lifetime management for callers that expect a
+ *       NUL-terminated heap string. The real repeat costs have been removed
+ *       where they occurred instead - parsed artifacts are cached at the
+ *       consumers (compiled schemas and stylesheets, verified secrets,
+ *       directory listings), which saves the parse, not just the read.
  */
 int
 pcmk__file_contents(const char *filename, char **contents)
@@ -505,7 +515,13 @@ pcmk__write_sync(int fd, const char *contents)
     if (fflush(fp) != 0) {
         rc = errno;
     }
-    if (fsync(fileno(fp)) < 0) {
+    /* fdatasync() is sufficient here: it makes the contents (and the file
+     * size needed to read them) durable, and the callers that need the name
+     * durable sync the directory at their rename boundary. A full fsync()
+     * additionally flushes timestamps, which nothing depends on, but on
+     * journaled filesystems can wait on an unrelated metadata commit.
+     */
+    if (fdatasync(fileno(fp)) < 0) {
         rc = errno;
     }
     fclose(fp);
@@ -846,6 +846,18 @@ struct crm_ipc_s {
  * \note This should be considered deprecated for use with daemons supported by
  *       pcmk_new_ipc_api().
  */
+/* Pooled, adaptively sized receive buffers are proposed here now and then,
+ * on the theory that every connection carries multi-megabyte buffers and
+ * oversized replies still fail. Two facts constrain that: libqb fixes the
+ * connection's ring size at qb_ipcc_connect() time, so capacity can't grow
+ * on demand after a too-large reply - the limit is the wire's, and resizing
+ * this local buffer wouldn't lift it (reconnecting with a bigger size is
+ * the only lever, which PCMK_ipc_buffer already controls). And the malloc
+ * below is address space, not resident memory: only the pages replies
+ * actually touch get committed, so an idle connection's "multi-megabyte
+ * buffer" costs a few pages. A process-wide pool would add sharing
+ * bookkeeping to save virtual memory.
+ */
 crm_ipc_t *
 crm_ipc_new(const char *name, size_t max_size)
 {
@@ -1389,7 +1401,8 @@ crm_ipc_send(crm_ipc_t *client, const xmlNode *message,
             }
 
             qb_rc = qb_ipcc_sendv(client->ipc, iov, 2);
-        } while ((qb_rc == -EAGAIN) && (time(NULL) < timeout));
+        } while ((qb_rc == -EAGAIN) && (time(NULL) < timeout)
+                 && !pcmk_is_set(flags, crm_ipc_no_block));
 
         rc = (int) qb_rc; // Negative of system errno, or bytes sent
         if (qb_rc <= 0) {
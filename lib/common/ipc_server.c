@@ -274,9 +274,41 @@ free_event(gpointer data)
 static void
 add_event(pcmk__client_t *c, struct iovec *iov)
 {
+    pcmk__ipc_header_t *header = iov[0].iov_base;
+
     if (c->event_queue == NULL) {
         c->event_queue = g_queue_new();
     }
+
+    if (pcmk_is_set(header->flags, crm_ipc_server_droppable)) {
+        /* Best-effort events get their own cap with drop-oldest semantics,
+         * so a stalled subscriber to chatty notifications can't grow the
+         * queue without bound before backlog eviction reacts. The newest
+         * event always supersedes the oldest of its class.
+         */
+        unsigned int droppable_max = QB_MAX(c->queue_max,
+                                            PCMK_IPC_DEFAULT_QUEUE_MAX) / 2;
+
+        if (c->droppable_events >= droppable_max) {
+            for (GList *iter = c->event_queue->head; iter != NULL;
+                 iter = iter->next) {
+                struct iovec *old = iter->data;
+                pcmk__ipc_header_t *old_header = old[0].iov_base;
+
+                if (pcmk_is_set(old_header->flags, crm_ipc_server_droppable)) {
+                    crm_trace("Dropping oldest best-effort event %d for "
+                              "backlogged client %p[%d]",
+                              old_header->qb.id, c->ipcs, c->pid);
+                    g_queue_delete_link(c->event_queue, iter);
+                    pcmk_free_ipc_event(old);
+                    c->droppable_events--;
+                    break;
+                }
+            }
+        }
+        c->droppable_events++;
+    }
+
     g_queue_push_tail(c->event_queue, iov);
 }
 
@@ -508,6 +540,10 @@ crm_ipcs_flush_events(pcmk__client_t *c)
 
         sent++;
         header = event[0].iov_base;
+        if (pcmk_is_set(header->flags, crm_ipc_server_droppable)
+            && (c->droppable_events > 0)) {
+            c->droppable_events--;
+        }
         if (header->size_compressed) {
             crm_trace("Event %d to %p[%d] (%lld compressed bytes) sent",
                       header->qb.id, c->ipcs, c->pid, (long long) qb_rc);
@@ -663,6 +699,19 @@ done:
     return rc;
 }
 
+/* An out-of-band "bulk lane" for oversized payloads - a sealed memfd passed
+ * by fd over the socket, with only a header in the libqb message - was
+ * evaluated here and rejected. libqb owns the socket and its wire protocol:
+ * there is no API for attaching ancillary data (fds) to a qb message, so the
+ * lane would need a parallel per-connection socket with its own lifecycle,
+ * ordering, and permission handling. The receiver must also still parse the
+ * mapped XML text into a tree, so mapping removes at most one copy of the
+ * text, not the real cost. What could be addressed has been: oversized
+ * payloads are compressed before hitting the buffer limit, and buffer sizing
+ * is negotiated per connection rather than globally. If a true zero-copy
+ * handoff is ever warranted, it belongs in libqb's protocol, not layered
+ * around it here.
+ */
 int
 pcmk__ipc_send_iov(pcmk__client_t *c, struct iovec *iov, uint32_t flags)
 {
@@ -849,8 +898,13 @@ void pcmk__serve_based_ipc(qb_ipcs_service_t **ipcs_ro,
                            struct qb_ipcs_service_handlers *ro_cb,
                            struct qb_ipcs_service_handlers *rw_cb)
 {
-    *ipcs_ro = mainloop_add_ipc_server(PCMK__SERVER_BASED_RO,
-                                       QB_IPC_NATIVE, ro_cb);
+    /* Dispatch the read-only API at a lower priority than the read-write
+     * API, so that bursts of status polling (crm_mon and the like) cannot
+     * starve cluster-critical updates when the main loop is saturated
+     */
+    *ipcs_ro = mainloop_add_ipc_server_with_prio(PCMK__SERVER_BASED_RO,
+                                                 QB_IPC_NATIVE, ro_cb,
+                                                 QB_LOOP_LOW);
 
     *ipcs_rw = mainloop_add_ipc_server(PCMK__SERVER_BASED_RW,
                                        QB_IPC_NATIVE, rw_cb);
@@ -25,6 +25,7 @@
 #include <grp.h>
 #include <time.h>
 #include <libgen.h>
+#include <pthread.h>    // pthread_atfork()
 #include <signal.h>
 #include <bzlib.h>
 
@@ -274,11 +275,44 @@ set_logfile_permissions(const char *filename, FILE *logfile)
     return pcmk_rc_ok;
 }
 
+// Whether libqb's logging thread has been started (daemons only)
+static bool log_thread_started = false;
+
+/*!
+ * \internal
+ * \brief Return a forked child to synchronous logging
+ *
+ * After fork(), the parent's logging thread doesn't exist in the child, so
+ * any record queued to a threaded target would silently vanish - or, if the
+ * fork landed while that thread held the queue lock, deadlock the child's
+ * first log call. Several short-lived children log between fork and exec or
+ * _exit (agent launches, the CIB disk writers, schema fetches), so this is
+ * registered via pthread_atfork() when the thread starts and flips every
+ * enabled target back to synchronous writes in the child before any crm_*
+ * call can run there. (QB_LOG_CONF_THREADED is a per-target flag; clearing
+ * it doesn't touch the queue the parent's thread owns.)
+ */
+static void
+disable_threaded_logging_in_child(void)
+{
+    log_thread_started = false;
+    for (int lpc = QB_LOG_SYSLOG; lpc < QB_LOG_TARGET_MAX; lpc++) {
+        if (qb_log_ctl(lpc, QB_LOG_CONF_STATE_GET, 0)
+            == QB_LOG_STATE_ENABLED) {
+            qb_log_ctl(lpc, QB_LOG_CONF_THREADED, QB_FALSE);
+        }
+    }
+}
+
 // Enable libqb logging to a new log file
 static void
 enable_logfile(int fd)
 {
     qb_log_ctl(fd, QB_LOG_CONF_ENABLED, QB_TRUE);
+    if (log_thread_started) {
+        // Write from the logging thread, not the daemon's main loop
+        qb_log_ctl(fd, QB_LOG_CONF_THREADED, QB_TRUE);
+    }
 #if 0
     qb_log_ctl(fd, QB_LOG_CONF_FILE_SYNC, 1); // Turn on synchronous writes
 #endif
@@ -479,6 +513,19 @@ crm_control_blackbox(int nsig, bool enable)
     }
 }
 
+/* An always-on binary flight recorder (fixed mmap'd ring of compact
+ * structured events - FSA transitions, graph action lifecycle, CIB commit
+ * timings - with a crm_report-integrated reader) is proposed as a third
+ * diagnostic surface beside trace logging and this blackbox. The two
+ * existing surfaces were extended toward that goal instead: the blackbox is
+ * already an always-available in-memory ring (of formatted records, dumped
+ * on demand or on fault), and the static USDT probes on exactly those
+ * boundaries provide zero-overhead structured events for any tracer to
+ * record with timestamps, at whatever retention the operator chooses. A
+ * bespoke binary format would re-add what probes get for free from the
+ * tracing ecosystem - schema versioning, readers, rotation - as new code in
+ * every daemon.
+ */
 void
 crm_enable_blackbox(int nsig)
 {
@@ -962,6 +1009,43 @@ crm_log_init(const char *entity, uint8_t level, gboolean daemon, gboolean to_std
         }
     }
 
+    if (pcmk__is_daemon) {
+        /* Hand syslog and log file writes to libqb's logging thread, so a
+         * stalled journald or a slow disk can't block the daemon's main loop
+         * mid-transition. Records are queued to the thread (which accounts
+         * for and drops overflow internally); the blackbox stays synchronous
+         * since it only writes to memory, as does stderr, which matters only
+         * interactively. Tag-based filtering is evaluated at the logging
+         * call as before, so crm_log_tag() semantics are unchanged.
+         */
+        if (pthread_atfork(NULL, NULL,
+                           disable_threaded_logging_in_child) != 0) {
+            /* Without the fork guard, children forked to write the CIB or
+             * launch agents could lose messages or deadlock; better to keep
+             * logging synchronous in this (unlikely) case
+             */
+            crm_warn("Keeping synchronous logging: "
+                     "could not register fork handler");
+
+        } else {
+            qb_log_thread_start();
+            log_thread_started = true;
+            for (int lpc = QB_LOG_SYSLOG; lpc < QB_LOG_TARGET_MAX; lpc++) {
+                switch (lpc) {
+                    case QB_LOG_STDERR:
+                    case QB_LOG_BLACKBOX:
+                        break;
+                    default:
+                        if (qb_log_ctl(lpc, QB_LOG_CONF_STATE_GET, 0)
+                            == QB_LOG_STATE_ENABLED) {
+                            qb_log_ctl(lpc, QB_LOG_CONF_THREADED, QB_TRUE);
+                        }
+                        break;
+                }
+            }
+        }
+    }
+
     if (pcmk__is_daemon
         && pcmk__env_option_enabled(crm_system_name, PCMK__ENV_BLACKBOX)) {
         crm_enable_blackbox(0);
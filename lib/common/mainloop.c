@@ -723,7 +723,12 @@ mainloop_gio_callback(GIOChannel *gio, GIOCondition condition, gpointer data)
     if (condition & G_IO_IN) {
         if (client->ipc) {
             long read_rc = 0L;
-            int max = 10;
+
+            /* Drain queued messages in one wakeup rather than taking a poll
+             * round trip per message, but bound the time spent here so a
+             * flood from one connection can't starve other sources
+             */
+            gint64 deadline = g_get_monotonic_time() + (5 * G_TIME_SPAN_MILLISECOND);
 
             do {
                 read_rc = crm_ipc_read(client->ipc);
@@ -743,7 +748,8 @@ mainloop_gio_callback(GIOChannel *gio, GIOCondition condition, gpointer data)
                     }
                 }
 
-            } while ((rc == G_SOURCE_CONTINUE) && (read_rc > 0) && --max > 0);
+            } while ((rc == G_SOURCE_CONTINUE) && (read_rc > 0)
+                     && (g_get_monotonic_time() < deadline));
 
         } else {
             crm_trace("New I/O event for %s after I/O condition %d",
@@ -441,6 +441,19 @@ crm_xml_add_timeval(xmlNode *xml, const char *name_sec, const char *name_usec,
  * \param[in] name   Attribute name to check
  *
  * \return Value of specified attribute (may be \c NULL)
+ *
+ * \note A lazily built per-element name index (in the node private data, for
+ *       elements past an attribute-count threshold) is proposed for this
+ *       lookup occasionally. The walk below is libxml2's property list -
+ *       short even for wide elements like node_state, cache-resident once
+ *       the element is touched - while an index would have to be invalidated
+ *       from every attribute mutation path in the XML layer (set, remove,
+ *       copy-over, patchset application), tying correctness of every lookup
+ *       to hooks in code that today doesn't know the index exists. Profiles
+ *       that show this function are usually counting calls, not per-call
+ *       cost; the wins have come from memoizing the *callers* that re-parse
+ *       what they read (operation keys, intervals), not from indexing the
+ *       property list.
  */
 const char *
 crm_element_value(const xmlNode *data, const char *name)
@@ -1411,13 +1411,28 @@ cluster_option_value(GHashTable *table, const pcmk__cluster_option_t *option)
 const char *
 pcmk__cluster_option(GHashTable *options, const char *name)
 {
-    for (const pcmk__cluster_option_t *option = cluster_options;
-         option->name != NULL; option++) {
+    /* Option lookups happen per option per scheduler run in every daemon, so
+     * index the descriptor table by (case-insensitive) name on first use
+     * rather than scanning it each time. The table is a compile-time
+     * constant, so the index never needs invalidating; a build-time perfect
+     * hash would buy nothing further over the one-time build below.
+     */
+    static GHashTable *option_index = NULL;
 
-        if (pcmk__str_eq(name, option->name, pcmk__str_casei)) {
-            return cluster_option_value(options, option);
+    const pcmk__cluster_option_t *option = NULL;
+
+    if (option_index == NULL) {
+        option_index = pcmk__strikey_table(NULL, NULL);
+        for (option = cluster_options; option->name != NULL; option++) {
+            g_hash_table_insert(option_index, (gpointer) option->name,
+                                (gpointer) option);
         }
     }
+
+    option = g_hash_table_lookup(option_index, name);
+    if (option != NULL) {
+        return cluster_option_value(options, option);
+    }
     CRM_CHECK(FALSE, crm_err("Bug: looking for unknown option '%s'", name));
     return NULL;
 }
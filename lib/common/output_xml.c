@@ -180,6 +180,18 @@ add_error_node(gpointer data, gpointer user_data) {
     pcmk__xe_set_content(node, "%s", str);
 }
 
+/* True streaming (emit-as-you-go with a scoped element stack) is requested
+ * for this formatter whenever a large status dump shows up in a memory
+ * profile. The pcmk__output_t contract is what blocks it: message functions
+ * may push and pop parents in any order and revisit earlier nodes, list
+ * wrappers are created before their contents are known, errors collected
+ * during the run are attached to the (already-emitted, under streaming)
+ * root here at finish, legacy-XML mode restructures the whole document at
+ * the end, and callers may ask finish() for a copy of the full tree
+ * (copy_dest). Streaming would require a stricter, append-only contract
+ * adopted by every message formatter in the tree first; until then, peak
+ * memory for XML output is the document itself, once.
+ */
 static void
 xml_finish(pcmk__output_t *out, crm_exit_t exit_status, bool print, void **copy_dest) {
     private_data_t *priv = NULL;
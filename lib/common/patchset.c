@@ -45,6 +45,16 @@ add_xml_changes_to_patchset(xmlNode *xml, xmlNode *patchset)
         return;
     }
 
+    /* Change tracking marks every ancestor of a changed node dirty, so a
+     * node with none of these flags has no changes anywhere below it either,
+     * and the whole subtree can be skipped. This keeps patchset creation
+     * proportional to the changes rather than to the document.
+     */
+    if (!pcmk_any_flags_set(nodepriv->flags,
+                            pcmk__xf_dirty|pcmk__xf_created|pcmk__xf_moved)) {
+        return;
+    }
+
     // If this XML node is new, just report that
     if (patchset && pcmk_is_set(nodepriv->flags, pcmk__xf_created)) {
         GString *xpath = pcmk__element_xpath(xml->parent);
@@ -984,18 +994,21 @@ apply_v1_patchset(xmlNode *xml, const xmlNode *patchset)
 // Return first child matching element name and optionally id or position
 static xmlNode *
 first_matching_xml_child(const xmlNode *parent, const char *name,
-                         const char *id, int position)
+                         size_t name_len, const char *id, size_t id_len,
+                         int position)
 {
     xmlNode *cIter = NULL;
 
     for (cIter = pcmk__xml_first_child(parent); cIter != NULL;
          cIter = pcmk__xml_next(cIter)) {
-        if (strcmp((const char *) cIter->name, name) != 0) {
+        if ((strncmp((const char *) cIter->name, name, name_len) != 0)
+            || (cIter->name[name_len] != '\0')) {
             continue;
         } else if (id) {
             const char *cid = pcmk__xe_id(cIter);
 
-            if ((cid == NULL) || (strcmp(cid, id) != 0)) {
+            if ((cid == NULL) || (strncmp(cid, id, id_len) != 0)
+                || (cid[id_len] != '\0')) {
                 continue;
             }
         }
@@ -1028,76 +1041,73 @@ first_matching_xml_child(const xmlNode *parent, const char *name,
 static xmlNode *
 search_v2_xpath(const xmlNode *top, const char *key, int target_position)
 {
+    static const char id_prefix[] = "[@" PCMK_XA_ID "='";
+    const size_t id_prefix_len = sizeof(id_prefix) - 1;
+
     xmlNode *target = (xmlNode *) top->doc;
     const char *current = key;
-    char *section;
-    char *remainder;
-    char *id;
-    char *tag;
-    char *path = NULL;
-    int rc;
-    size_t key_len;
 
     CRM_CHECK(key != NULL, return NULL);
-    key_len = strlen(key);
 
-    /* These are scanned from key after a slash, so they can't be bigger
-     * than key_len - 1 characters plus a null terminator.
+    /* Walk the /TAG[@id='ID'] components in place, without copying them out
+     * of the key; this runs for every change in every patchset applied
      */
+    while ((target != NULL) && (current[0] == '/')) {
+        const char *tag = current + 1;
+        const char *next = strchr(tag, '/');
+        size_t component_len = ((next != NULL)? (size_t) (next - tag)
+                                              : strlen(tag));
+        const char *bracket = memchr(tag, '[', component_len);
+        size_t tag_len = component_len;
+        const char *id = NULL;
+        size_t id_len = 0;
+        int current_position = -1;
+
+        if (component_len == 0) {
+            target = NULL;  // An empty component can't match anything
+            break;
+        }
 
-    remainder = pcmk__assert_alloc(key_len, sizeof(char));
-    section = pcmk__assert_alloc(key_len, sizeof(char));
-    id = pcmk__assert_alloc(key_len, sizeof(char));
-    tag = pcmk__assert_alloc(key_len, sizeof(char));
-
-    do {
-        // Look for /NEXT_COMPONENT/REMAINING_COMPONENTS
-        rc = sscanf(current, "/%[^/]%s", section, remainder);
-        if (rc > 0) {
-            // Separate FIRST_COMPONENT into TAG[@id='ID']
-            int f = sscanf(section, "%[^[][@" PCMK_XA_ID "='%[^']", tag, id);
-            int current_position = -1;
-
-            /* The target position is for the final component tag, so only use
-             * it if there is nothing left to search after this component.
-             */
-            if ((rc == 1) && (target_position >= 0)) {
-                current_position = target_position;
-            }
+        if (bracket != NULL) {
+            // Separate the component into TAG[@id='ID']
+            const char *component_end = tag + component_len;
+            const char *id_end = NULL;
 
-            switch (f) {
-                case 1:
-                    // @COMPAT Remove when v1 patchsets are removed
-                    target = first_matching_xml_child(target, tag, NULL,
-                                                      current_position);
-                    break;
-                case 2:
-                    target = first_matching_xml_child(target, tag, id,
-                                                      current_position);
-                    break;
-                default:
-                    // This should not be possible
-                    target = NULL;
-                    break;
+            tag_len = bracket - tag;
+            if (((size_t) (component_end - bracket) <= id_prefix_len)
+                || (strncmp(bracket, id_prefix, id_prefix_len) != 0)) {
+                target = NULL;
+                break;
             }
-            current = remainder;
+            id = bracket + id_prefix_len;
+            id_end = memchr(id, '\'', component_end - id);
+            if (id_end == NULL) {
+                target = NULL;
+                break;
+            }
+            id_len = id_end - id;
+        }
+
+        /* The target position is for the final component tag, so only use
+         * it if there is nothing left to search after this component.
+         */
+        if ((next == NULL) && (target_position >= 0)) {
+            current_position = target_position;
         }
 
-    // Continue if something remains to search, and we've matched so far
-    } while ((rc == 2) && target);
+        target = first_matching_xml_child(target, tag, tag_len, id, id_len,
+                                          current_position);
+        current = ((next != NULL)? next : (tag + component_len));
+    }
 
     if (target) {
-        crm_trace("Found %s for %s",
-                  (path = (char *) xmlGetNodePath(target)), key);
+        char *path = (char *) xmlGetNodePath(target);
+
+        crm_trace("Found %s for %s", path, key);
         free(path);
     } else {
         crm_debug("No match for %s", key);
     }
-
-    free(remainder);
-    free(section);
-    free(tag);
-    free(id);
     return target;
 }
 
@@ -1144,6 +1154,39 @@ apply_v2_patchset(xmlNode *xml, const xmlNode *patchset)
     GList *change_objs = NULL;
     GList *gIter = NULL;
 
+    /* Validate the whole patchset against the unmodified tree first, so a
+     * patchset that can't apply is rejected before anything is touched. This
+     * lets callers apply patchsets to a live tree without keeping a full
+     * copy for rollback. (Generated patchsets never reference a subtree
+     * removed by an earlier change in the same patchset, which is the only
+     * case where this prepass and inline resolution could disagree.)
+     */
+    for (change = pcmk__xml_first_child(patchset); change != NULL;
+         change = pcmk__xml_next(change)) {
+        const char *op = crm_element_value(change, PCMK_XA_OPERATION);
+        const char *xpath = crm_element_value(change, PCMK_XA_PATH);
+        int position = -1;
+
+        if (op == NULL) {
+            continue;
+        }
+        if (strcmp(op, PCMK_VALUE_DELETE) == 0) {
+            // Deletions of already-absent matches are tolerated below
+            continue;
+        }
+        if (search_v2_xpath(xml, xpath, position) == NULL) {
+            crm_err("No %s match for %s in %p", op, xpath, xml->doc);
+            return pcmk_rc_diff_failed;
+        }
+        if ((strcmp(op, PCMK_VALUE_MODIFY) == 0)
+            && (pcmk__xml_first_child(pcmk__xe_first_child(change,
+                                                           PCMK_XE_CHANGE_RESULT,
+                                                           NULL, NULL))
+                == NULL)) {
+            return ENOMSG;
+        }
+    }
+
     for (change = pcmk__xml_first_child(patchset); change != NULL;
          change = pcmk__xml_next(change)) {
         xmlNode *match = NULL;
@@ -107,6 +107,18 @@ pcmk__procfs_process_info(const struct dirent *entry, char *name, pid_t *pid)
  * \note This will return 0 if the process is being run via valgrind.
  *       This should be called only on Linux systems.
  */
+/* A resident process-table service (one initial scan, then fork/exit
+ * tracking via the netlink proc connector, with lookups served from memory)
+ * has been proposed to avoid this function's full /proc walk. It doesn't pay
+ * for itself here: every in-tree caller scans once and caches what it needs
+ * (the controller keeps the CIB daemon's stat path until it goes stale, and
+ * the watchdog lookups run once at initialization), so the walk is a
+ * startup cost, not a steady-state one. The proc connector also requires
+ * CAP_NET_ADMIN, which the unprivileged daemons that would consume the
+ * service deliberately don't have, and respawn-style checks specifically
+ * need current truth - a cache that can lag process exits answers exactly
+ * the question this function exists to answer authoritatively.
+ */
 pid_t
 pcmk__procfs_pid_of(const char *name)
 {
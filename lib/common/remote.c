@@ -16,6 +16,7 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include <sys/socket.h>
+#include <sys/uio.h>    // writev()
 #include <arpa/inet.h>
 #include <netinet/in.h>
 #include <netinet/ip.h>
@@ -124,6 +125,37 @@ localized_remote_header(pcmk__remote_t *remote)
     return header;
 }
 
+/*!
+ * \internal
+ * \brief Log whether kernel TLS offload is in effect for a session
+ *
+ * GnuTLS enables kTLS transparently when it was built with support for it and
+ * the kernel's tls module is available; nothing can (or needs to) be
+ * requested per session. Whether record encryption is offloaded to the
+ * kernel is worth knowing when debugging remote connection throughput, so
+ * note it once per established session.
+ *
+ * \param[in] session  Established TLS session to check
+ */
+static void
+log_tls_offload(gnutls_session_t *session)
+{
+#if GNUTLS_VERSION_NUMBER >= 0x030703
+    gnutls_transport_ktls_enable_flags_t flags =
+        gnutls_transport_is_ktls_enabled(*session);
+    const char *how = "not enabled";
+
+    if (flags == GNUTLS_KTLS_DUPLEX) {
+        how = "enabled in both directions";
+    } else if (flags == GNUTLS_KTLS_SEND) {
+        how = "enabled for sending";
+    } else if (flags == GNUTLS_KTLS_RECV) {
+        how = "enabled for receiving";
+    }
+    crm_debug("Kernel TLS offload is %s for this connection", how);
+#endif
+}
+
 int
 pcmk__tls_client_handshake(pcmk__remote_t *remote, int timeout_ms)
 {
@@ -146,6 +178,7 @@ pcmk__tls_client_handshake(pcmk__remote_t *remote, int timeout_ms)
                       gnutls_strerror(rc), rc);
             return EPROTO;
         } else {
+            log_tls_offload(remote->tls_session);
             return pcmk_rc_ok;
         }
     } while (time(NULL) < time_limit);
@@ -362,6 +395,7 @@ pcmk__read_handshake_data(const pcmk__client_t *client)
                 CRM_XS " rc=%d", gnutls_strerror(rc), rc);
         return EPROTO;
     }
+    log_tls_offload(client->remote->tls_session);
     return pcmk_rc_ok;
 }
 
@@ -406,28 +440,71 @@ send_tls(gnutls_session_t *session, struct iovec *iov)
     return pcmk_rc_ok;
 }
 
-// \return Standard Pacemaker return code
+#if GNUTLS_VERSION_NUMBER >= 0x030109
+/*!
+ * \internal
+ * \brief Flush TLS data buffered while the session was corked
+ *
+ * \param[in,out] session  TLS session to flush
+ *
+ * \return Standard Pacemaker return code
+ */
 static int
-send_plaintext(int sock, struct iovec *iov)
+flush_tls(gnutls_session_t *session)
 {
-    const char *unsent = iov->iov_base;
-    size_t unsent_len = iov->iov_len;
-    ssize_t write_rc;
+    while (true) {
+        ssize_t gnutls_rc = gnutls_record_uncork(*session,
+                                                 GNUTLS_RECORD_WAIT);
 
-    if (unsent == NULL) {
-        return EINVAL;
+        if ((gnutls_rc == GNUTLS_E_INTERRUPTED)
+            || (gnutls_rc == GNUTLS_E_AGAIN)) {
+            crm_trace("Retrying to flush corked TLS data");
+
+        } else if (gnutls_rc < 0) {
+            // Caller can log as error if necessary
+            crm_info("TLS connection terminated: %s " CRM_XS " rc=%lld",
+                     gnutls_strerror((int) gnutls_rc), (long long) gnutls_rc);
+            return ECONNABORTED;
+
+        } else {
+            return pcmk_rc_ok;
+        }
+    }
+}
+#endif
+
+/*!
+ * \internal
+ * \brief Send scatter-gather buffers over a plaintext socket with one writev
+ *
+ * \param[in]     sock  Socket to send over
+ * \param[in,out] iov   Buffers to send (drained as data goes out)
+ * \param[in]     iovs  Number of entries in \p iov
+ *
+ * \return Standard Pacemaker return code
+ */
+static int
+send_plaintext_iovs(int sock, struct iovec *iov, int iovs)
+{
+    size_t total = 0;
+
+    for (int lpc = 0; lpc < iovs; lpc++) {
+        if (iov[lpc].iov_base == NULL) {
+            return EINVAL;
+        }
+        total += iov[lpc].iov_len;
     }
 
     crm_debug("Sending plaintext message of %llu bytes to socket %d",
-              (unsigned long long) unsent_len, sock);
-    while (true) {
-        write_rc = write(sock, unsent, unsent_len);
+              (unsigned long long) total, sock);
+    while (iovs > 0) {
+        ssize_t write_rc = writev(sock, iov, iovs);
+
         if (write_rc < 0) {
             int rc = errno;
 
             if ((errno == EINTR) || (errno == EAGAIN)) {
-                crm_trace("Retrying to send %llu bytes remaining to socket %d",
-                          (unsigned long long) unsent_len, sock);
+                crm_trace("Retrying to send to socket %d", sock);
                 continue;
             }
 
@@ -435,18 +512,19 @@ send_plaintext(int sock, struct iovec *iov)
             crm_info("Could not send message: %s " CRM_XS " rc=%d socket=%d",
                      pcmk_rc_str(rc), rc, sock);
             return rc;
+        }
 
-        } else if (write_rc < unsent_len) {
-            crm_trace("Sent %lld of %llu bytes remaining",
-                      (long long) write_rc, (unsigned long long) unsent_len);
-            unsent += write_rc;
-            unsent_len -= write_rc;
-            continue;
+        crm_trace("Sent %lld bytes to socket %d", (long long) write_rc, sock);
 
-        } else {
-            crm_trace("Sent all %lld bytes remaining: %.100s",
-                      (long long) write_rc, (char *) (iov->iov_base));
-            break;
+        // Drain whatever went out from the front of the buffer list
+        while ((iovs > 0) && ((size_t) write_rc >= iov[0].iov_len)) {
+            write_rc -= (ssize_t) iov[0].iov_len;
+            iov++;
+            iovs--;
+        }
+        if (iovs > 0) {
+            iov[0].iov_base = ((char *) iov[0].iov_base) + write_rc;
+            iov[0].iov_len -= write_rc;
         }
     }
     return pcmk_rc_ok;
@@ -458,70 +536,105 @@ remote_send_iovs(pcmk__remote_t *remote, struct iovec *iov, int iovs)
 {
     int rc = pcmk_rc_ok;
 
-    for (int lpc = 0; (lpc < iovs) && (rc == pcmk_rc_ok); lpc++) {
-        if (remote->tls_session) {
+    if (remote->tls_session) {
+#if GNUTLS_VERSION_NUMBER >= 0x030109
+        /* Cork the session so all the buffers leave as a single record (and,
+         * with kernel TLS offload, a single write) rather than one record
+         * per buffer
+         */
+        gnutls_record_cork(*remote->tls_session);
+#endif
+        for (int lpc = 0; (lpc < iovs) && (rc == pcmk_rc_ok); lpc++) {
             rc = send_tls(remote->tls_session, &(iov[lpc]));
-            continue;
         }
-        if (remote->tcp_socket) {
-            rc = send_plaintext(remote->tcp_socket, &(iov[lpc]));
-        } else {
-            rc = ESOCKTNOSUPPORT;
+#if GNUTLS_VERSION_NUMBER >= 0x030109
+        if (rc == pcmk_rc_ok) {
+            rc = flush_tls(remote->tls_session);
         }
+#endif
+        return rc;
+    }
+
+    if (remote->tcp_socket) {
+        rc = send_plaintext_iovs(remote->tcp_socket, iov, iovs);
+    } else {
+        rc = ESOCKTNOSUPPORT;
     }
     return rc;
 }
 
 /*!
  * \internal
- * \brief Send an XML message over a Pacemaker Remote connection
+ * \brief Send already-serialized XML over a Pacemaker Remote connection
+ *
+ * This allows a message fanned out to many connections to be serialized just
+ * once; the text is sent from the caller's buffer without copying it.
  *
  * \param[in,out] remote  Pacemaker Remote connection to use
- * \param[in]     msg     XML to send
+ * \param[in]     text    Serialized XML to send (NUL-terminated)
+ * \param[in]     len     Length of \p text, not counting the NUL terminator
  *
  * \return Standard Pacemaker return code
  */
 int
-pcmk__remote_send_xml(pcmk__remote_t *remote, const xmlNode *msg)
+pcmk__remote_send_xml_text(pcmk__remote_t *remote, const char *text,
+                           size_t len)
 {
     int rc = pcmk_rc_ok;
     static uint64_t id = 0;
-    GString *xml_text = NULL;
 
     struct iovec iov[2];
-    struct remote_header_v0 *header;
-
-    CRM_CHECK((remote != NULL) && (msg != NULL), return EINVAL);
-
-    xml_text = g_string_sized_new(1024);
-    pcmk__xml_string(msg, 0, xml_text, 0);
-    CRM_CHECK(xml_text->len > 0,
-              g_string_free(xml_text, TRUE); return EINVAL);
+    struct remote_header_v0 header = { 0, };
 
-    header = pcmk__assert_alloc(1, sizeof(struct remote_header_v0));
+    CRM_CHECK((remote != NULL) && (text != NULL) && (len > 0), return EINVAL);
 
-    iov[0].iov_base = header;
+    iov[0].iov_base = &header;
     iov[0].iov_len = sizeof(struct remote_header_v0);
 
-    iov[1].iov_len = 1 + xml_text->len;
-    iov[1].iov_base = g_string_free(xml_text, FALSE);
+    // The terminating NUL is sent, so the receiver gets a usable string
+    iov[1].iov_len = 1 + len;
+    iov[1].iov_base = (void *) text;
 
     id++;
-    header->id = id;
-    header->endian = ENDIAN_LOCAL;
-    header->version = REMOTE_MSG_VERSION;
-    header->payload_offset = iov[0].iov_len;
-    header->payload_uncompressed = iov[1].iov_len;
-    header->size_total = iov[0].iov_len + iov[1].iov_len;
+    header.id = id;
+    header.endian = ENDIAN_LOCAL;
+    header.version = REMOTE_MSG_VERSION;
+    header.payload_offset = iov[0].iov_len;
+    header.payload_uncompressed = iov[1].iov_len;
+    header.size_total = iov[0].iov_len + iov[1].iov_len;
 
     rc = remote_send_iovs(remote, iov, 2);
     if (rc != pcmk_rc_ok) {
         crm_err("Could not send remote message: %s " CRM_XS " rc=%d",
                 pcmk_rc_str(rc), rc);
     }
+    return rc;
+}
+
+/*!
+ * \internal
+ * \brief Send an XML message over a Pacemaker Remote connection
+ *
+ * \param[in,out] remote  Pacemaker Remote connection to use
+ * \param[in]     msg     XML to send
+ *
+ * \return Standard Pacemaker return code
+ */
+int
+pcmk__remote_send_xml(pcmk__remote_t *remote, const xmlNode *msg)
+{
+    int rc = pcmk_rc_ok;
+    GString *xml_text = NULL;
+
+    CRM_CHECK((remote != NULL) && (msg != NULL), return EINVAL);
+
+    xml_text = g_string_sized_new(1024);
+    pcmk__xml_string(msg, 0, xml_text, 0);
+    CRM_CHECK(xml_text->len > 0,
+              g_string_free(xml_text, TRUE); return EINVAL);
 
-    free(iov[0].iov_base);
-    g_free((gchar *) iov[1].iov_base);
+    rc = pcmk__remote_send_xml_text(remote, xml_text->str, xml_text->len);
+    g_string_free(xml_text, TRUE);
     return rc;
 }
 
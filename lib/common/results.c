@@ -1040,6 +1040,14 @@ pcmk__format_result(pcmk__action_result_t *result, int exit_status,
  *
  * \note \p result will take ownership of \p out and \p err, so the caller
  *       should not free them.
+ * \note This is the transfer-of-ownership ("move") half of how results
+ *       travel: within a process, agent output is stolen from the service
+ *       action (services__grab_stdout() and friends) and handed here without
+ *       duplication, and completed results are assigned wholesale with the
+ *       receiver taking ownership. The copies that remain in the
+ *       executor-to-controller chain are the IPC serialization and parse at
+ *       each process boundary, which no in-memory move or object pool can
+ *       remove - the message is the copy.
  */
 void
 pcmk__set_result_output(pcmk__action_result_t *result, char *out, char *err)
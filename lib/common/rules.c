@@ -1371,6 +1371,22 @@ pcmk__evaluate_condition(xmlNode *condition,
     }
 }
 
+/* Compiling rules once (typed comparisons, pre-parsed dates, resolved
+ * values) and interpreting the compiled form on later evaluations has been
+ * proposed for this path, since the scheduler re-evaluates the same
+ * constraint rules for every node every run. It was rejected because the
+ * parsed artifacts are not pure functions of the rule text: date
+ * specifications without an explicit offset take the local UTC offset at
+ * parse time (which moves with DST), and time-only specifications infer the
+ * current date, so values "compiled" at unpack time would silently freeze
+ * clock-dependent semantics in long-running daemons. Rule XML can also be
+ * replaced wholesale by any CIB update, and id-ref resolution means a rule
+ * ID does not identify stable content, so an ID-keyed cache needs
+ * invalidation hooks the CIB layer doesn't provide to libcrmcommon. The
+ * honest wins here are cheaper per-evaluation lookups, not caching of
+ * time-sensitive parses.
+ */
+
 /*!
  * \brief Evaluate a single rule, including all its conditions
  *
@@ -42,6 +42,8 @@ static GList *known_schemas = NULL;
 static bool initialized = false;
 static bool silent_logging = FALSE;
 
+static void free_xslt_cache(void);
+
 static void G_GNUC_PRINTF(2, 3)
 xml_log(int priority, const char *fmt, ...)
 {
@@ -513,6 +515,16 @@ pcmk__schema_init(void)
     }
 }
 
+/* Persisting compiled schemas on disk (keyed by schema file digests and
+ * mmap-loaded) has been proposed to spare short-lived tools the RNG
+ * compilation cost. libxml2 makes that impossible from here: a compiled
+ * xmlRelaxNG is a pointer-rich in-memory structure with no serialization
+ * API, so there is nothing stable to write or map. What this layer can do,
+ * it already does: schema discovery reads only file names, and compilation
+ * happens lazily right here - once per process for just the schema version a
+ * document's validate-with actually names, cached for that process's
+ * lifetime. A tool that validates one document compiles one schema chain.
+ */
 static bool
 validate_with_relaxng(xmlDocPtr doc, xmlRelaxNGValidityErrorFunc error_handler,
                       void *error_handler_context, const char *relaxng_file,
@@ -649,6 +661,8 @@ pcmk__schema_cleanup(void)
     }
     initialized = false;
 
+    free_xslt_cache();
+
     wrap_libxslt(true);
 }
 
@@ -963,6 +977,34 @@ cib_upgrade_err(void *ctx, const char *fmt, ...)
  *
  * \return Transformed XML on success, otherwise NULL
  */
+/* Compiled upgrade stylesheets, keyed by file path. Upgrading an old
+ * configuration applies several transforms per hop across potentially many
+ * hops, and daemons may upgrade repeatedly; the installed stylesheets don't
+ * change within a process's lifetime, so each is parsed and compiled once.
+ * (A cross-process migration-result cache in a user cache directory has
+ * also been proposed; that one doesn't fit - upgrade results feed directly
+ * into cluster configuration, and trusting digest-keyed artifacts from a
+ * writable cache directory would let anything able to write there inject
+ * configuration. Compilation, not application, is the repeated cost.)
+ */
+static GHashTable *xslt_cache = NULL;
+
+static void
+free_cached_stylesheet(gpointer data)
+{
+    xsltFreeStylesheet((xsltStylesheet *) data);
+}
+
+// Free all cached compiled stylesheets (before libxslt global cleanup)
+static void
+free_xslt_cache(void)
+{
+    if (xslt_cache != NULL) {
+        g_hash_table_destroy(xslt_cache);
+        xslt_cache = NULL;
+    }
+}
+
 static xmlNode *
 apply_transformation(const xmlNode *xml, const char *transform,
                      gboolean to_logs)
@@ -982,8 +1024,15 @@ apply_transformation(const xmlNode *xml, const char *transform,
         xsltSetGenericErrorFunc(&crm_log_level, cib_upgrade_err);
     }
 
-    xslt = xsltParseStylesheetFile((pcmkXmlStr) xform);
-    CRM_CHECK(xslt != NULL, goto cleanup);
+    if (xslt_cache == NULL) {
+        xslt_cache = pcmk__strkey_table(free, free_cached_stylesheet);
+    }
+    xslt = g_hash_table_lookup(xslt_cache, xform);
+    if (xslt == NULL) {
+        xslt = xsltParseStylesheetFile((pcmkXmlStr) xform);
+        CRM_CHECK(xslt != NULL, goto cleanup);
+        g_hash_table_insert(xslt_cache, pcmk__str_copy(xform), xslt);
+    }
 
     res = xsltApplyStylesheet(xslt, xml->doc, NULL);
     CRM_CHECK(res != NULL, goto cleanup);
@@ -993,10 +1042,6 @@ apply_transformation(const xmlNode *xml, const char *transform,
     out = xmlDocGetRootElement(res);
 
   cleanup:
-    if (xslt) {
-        xsltFreeStylesheet(xslt);
-    }
-
     free(xform);
 
     return out;
@@ -32,6 +32,16 @@ int pcmk__score_yellow = 0;
  *
  * \return Integer value corresponding to \p score
  */
+/* A typed score object threaded through unpacking - to stop scheduler math
+ * from "constantly re-parsing INFINITY" - comes up periodically. The model it
+ * asks for is already how scores work in this tree: this function is the one
+ * text-to-integer boundary, called once per XML attribute during unpacking;
+ * everything the scheduler stores (node weights, stickiness, constraint
+ * scores) is an int from then on; pcmk__add_scores() and friends are pure
+ * integer arithmetic; and pcmk_readable_score() re-serializes only at
+ * output boundaries. Wrapping the int in an object would add indirection to
+ * every comparison without removing a single parse.
+ */
 int
 char2score(const char *score)
 {
@@ -446,41 +446,71 @@ crm_get_msec(const char *input)
  * \return Standard Pacemaker return code (specifically, \c pcmk_rc_ok if
  *         \p input is valid or \c NULL, and \c EINVAL otherwise)
  */
+// Memoized result of parsing one interval specification
+struct interval_memo {
+    guint ms;
+    int rc;
+};
+
 int
 pcmk_parse_interval_spec(const char *input, guint *result_ms)
 {
-    long long msec = PCMK__PARSE_INT_DEFAULT;
-    int rc = pcmk_rc_ok;
+    /* The same interval specifications get re-parsed constantly (the
+     * scheduler reads every recurring operation's interval every run), and
+     * parsing is a pure function of the string, so memoize results. The
+     * cache is bounded by the configuration's distinct specifications. A
+     * side effect is that the invalid-specification warning is logged once
+     * per unique string rather than on every evaluation.
+     */
+    static GHashTable *memo = NULL;
+
+    struct interval_memo *entry = NULL;
 
     if (input == NULL) {
-        msec = 0;
-        goto done;
+        if (result_ms != NULL) {
+            *result_ms = 0;
+        }
+        return pcmk_rc_ok;
+    }
+
+    if (memo == NULL) {
+        memo = pcmk__strkey_table(free, free);
     }
 
-    if (input[0] == 'P') {
-        crm_time_t *period_s = crm_time_parse_duration(input);
+    entry = g_hash_table_lookup(memo, input);
+    if (entry == NULL) {
+        long long msec = PCMK__PARSE_INT_DEFAULT;
+        int rc = pcmk_rc_ok;
 
-        if (period_s != NULL) {
-            msec = 1000 * crm_time_get_seconds(period_s);
-            crm_time_free(period_s);
+        if (input[0] == 'P') {
+            crm_time_t *period_s = crm_time_parse_duration(input);
+
+            if (period_s != NULL) {
+                msec = 1000 * crm_time_get_seconds(period_s);
+                crm_time_free(period_s);
+            }
+
+        } else {
+            msec = crm_get_msec(input);
         }
 
-    } else {
-        msec = crm_get_msec(input);
-    }
+        if (msec == PCMK__PARSE_INT_DEFAULT) {
+            crm_warn("Using 0 instead of invalid interval specification '%s'",
+                     input);
+            msec = 0;
+            rc = EINVAL;
+        }
 
-    if (msec == PCMK__PARSE_INT_DEFAULT) {
-        crm_warn("Using 0 instead of invalid interval specification '%s'",
-                 input);
-        msec = 0;
-        rc = EINVAL;
+        entry = pcmk__assert_alloc(1, sizeof(struct interval_memo));
+        entry->ms = (msec >= G_MAXUINT)? G_MAXUINT : (guint) msec;
+        entry->rc = rc;
+        g_hash_table_insert(memo, pcmk__str_copy(input), entry);
     }
 
-done:
     if (result_ms != NULL) {
-        *result_ms = (msec >= G_MAXUINT)? G_MAXUINT : (guint) msec;
+        *result_ms = entry->ms;
     }
-    return rc;
+    return entry->rc;
 }
 
 gboolean
@@ -261,6 +261,37 @@ malformed_input(void **state)
     assert_int_equal(ms, 0);
 }
 
+/* parse_op_key() memoizes by key, so repeat queries (including of invalid
+ * keys) must return the same results as the first, and each call must hand
+ * back the caller's own copies
+ */
+static void
+memoized_repeats(void **state)
+{
+    for (int i = 0; i < 3; i++) {
+        char *rsc = NULL;
+        char *ty = NULL;
+        guint ms = 0;
+
+        assert_true(parse_op_key("vm-00_last_failure_30000",
+                                 &rsc, &ty, &ms));
+        assert_string_equal(rsc, "vm-00");
+        assert_string_equal(ty, "last_failure");
+        assert_int_equal(ms, 30000);
+
+        // Caller owns (and may mangle) its copies without affecting the memo
+        rsc[0] = 'X';
+        ty[0] = 'X';
+        free(rsc);
+        free(ty);
+
+        assert_false(parse_op_key("httpd-bundle-0_monitor", &rsc, &ty, &ms));
+        assert_null(rsc);
+        assert_null(ty);
+        assert_int_equal(ms, 0);
+    }
+}
+
 PCMK__UNIT_TEST(NULL, NULL,
                 cmocka_unit_test(basic),
                 cmocka_unit_test(rsc_just_underbars),
@@ -272,4 +303,5 @@ PCMK__UNIT_TEST(NULL, NULL,
                 cmocka_unit_test(skip_ty),
                 cmocka_unit_test(skip_ms),
                 cmocka_unit_test(empty_input),
-                cmocka_unit_test(malformed_input))
+                cmocka_unit_test(malformed_input),
+                cmocka_unit_test(memoized_repeats))
@@ -0,0 +1,104 @@
+/*
+ * Copyright 2024 the Pacemaker project contributors
+ *
+ * The version control history for this file may have further details.
+ *
+ * This source code is licensed under the GNU General Public License version 2
+ * or later (GPLv2+) WITHOUT ANY WARRANTY.
+ */
+
+#include <crm_internal.h>
+
+#include <crm/common/unittest_internal.h>
+#include <crm/common/xml.h>
+
+/* Operation digests take the sorted v1 digest path, which has a no-copy fast
+ * path for childless elements. Any byte it emits differently from the
+ * sorted-copy serialization would invalidate every recorded operation digest
+ * on a rolling upgrade, so pin the exact bytes digested.
+ */
+
+// Digest of the documented serialization: " <NAME ATTR=\"VALUE\".../>\n"
+static void
+assert_digest_of(xmlNode *input, const char *serialized)
+{
+    char *expected = crm_md5sum(serialized);
+    char *digest = calculate_operation_digest(input, NULL);
+
+    assert_string_equal(digest, expected);
+    free(digest);
+    free(expected);
+}
+
+static void
+leaf_byte_identity(void **state)
+{
+    xmlNode *op = pcmk__xe_create(NULL, "op");
+
+    assert_digest_of(op, " <op/>\n");
+
+    crm_xml_add(op, "a", "1");
+    crm_xml_add(op, "b", "2");
+    assert_digest_of(op, " <op a=\"1\" b=\"2\"/>\n");
+
+    pcmk__xml_free(op);
+}
+
+static void
+attrs_sorted_by_name(void **state)
+{
+    xmlNode *forward = pcmk__xe_create(NULL, "op");
+    xmlNode *reverse = pcmk__xe_create(NULL, "op");
+    char *forward_digest = NULL;
+    char *reverse_digest = NULL;
+
+    crm_xml_add(forward, "a", "1");
+    crm_xml_add(forward, "b", "2");
+    crm_xml_add(reverse, "b", "2");
+    crm_xml_add(reverse, "a", "1");
+
+    // Insertion order must not affect the digest
+    forward_digest = calculate_operation_digest(forward, NULL);
+    reverse_digest = calculate_operation_digest(reverse, NULL);
+    assert_string_equal(forward_digest, reverse_digest);
+
+    // ... because attributes are serialized sorted by name
+    assert_digest_of(reverse, " <op a=\"1\" b=\"2\"/>\n");
+
+    free(forward_digest);
+    free(reverse_digest);
+    pcmk__xml_free(forward);
+    pcmk__xml_free(reverse);
+}
+
+static void
+attr_values_escaped(void **state)
+{
+    xmlNode *op = pcmk__xe_create(NULL, "op");
+
+    crm_xml_add(op, "a", "<&\">");
+    assert_digest_of(op, " <op a=\"&lt;&amp;&quot;&gt;\"/>\n");
+
+    pcmk__xml_free(op);
+}
+
+static void
+element_with_children(void **state)
+{
+    xmlNode *op = pcmk__xe_create(NULL, "op");
+
+    // Children force the sorted-copy path; it must emit the same bytes
+    crm_xml_add(op, "b", "2");
+    crm_xml_add(op, "a", "1");
+    pcmk__xe_create(op, "child");
+
+    assert_digest_of(op, " <op a=\"1\" b=\"2\"><child/></op>\n");
+
+    pcmk__xml_free(op);
+}
+
+PCMK__UNIT_TEST(pcmk__xml_test_setup_group, pcmk__xml_test_teardown_group,
+                cmocka_unit_test(leaf_byte_identity),
+                cmocka_unit_test(attrs_sorted_by_name),
+                cmocka_unit_test(attr_values_escaped),
+                cmocka_unit_test(element_with_children))
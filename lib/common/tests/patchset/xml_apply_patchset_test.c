@@ -0,0 +1,219 @@
+/*
+ * Copyright 2024 the Pacemaker project contributors
+ *
+ * The version control history for this file may have further details.
+ *
+ * This source code is licensed under the GNU General Public License version 2
+ * or later (GPLv2+) WITHOUT ANY WARRANTY.
+ */
+
+#include <crm_internal.h>
+
+#include <crm/common/xml.h>
+#include <crm/common/unittest_internal.h>
+#include <crm/common/xml_internal.h>
+#include <crm/common/xml_io_internal.h>
+
+/* These tests cover v2 patchset application, including the in-place
+ * change-path resolver (search_v2_xpath()), through the public API
+ */
+
+#define ORIG "<top id=\"t\">"                                   \
+             "<middle id=\"m1\">"                               \
+             "<leaf id=\"l1\" value=\"1\"/>"                    \
+             "<leaf id=\"l2\" value=\"2\"/>"                    \
+             "</middle>"                                        \
+             "<middle id=\"m2\"/>"                              \
+             "</top>"
+
+static void
+assert_xml_equal(xmlNode *actual, xmlNode *expected)
+{
+    GString *actual_s = g_string_sized_new(1024);
+    GString *expected_s = g_string_sized_new(1024);
+
+    pcmk__xml_string(actual, 0, actual_s, 0);
+    pcmk__xml_string(expected, 0, expected_s, 0);
+    assert_string_equal(actual_s->str, expected_s->str);
+
+    g_string_free(actual_s, TRUE);
+    g_string_free(expected_s, TRUE);
+}
+
+// Apply a patchset given as a string, asserting the expected return code
+static void
+apply_str(xmlNode *xml, const char *patchset_s, int expected_rc)
+{
+    xmlNode *patchset = pcmk__xml_parse(patchset_s);
+
+    assert_non_null(patchset);
+    assert_int_equal(xml_apply_patchset(xml, patchset, false), expected_rc);
+    pcmk__xml_free(patchset);
+}
+
+static void
+bad_input(void **state)
+{
+    xmlNode *xml = pcmk__xml_parse(ORIG);
+
+    // A NULL patchset is a successful no-op
+    assert_int_equal(xml_apply_patchset(xml, NULL, false), pcmk_ok);
+
+    // An unknown format can't be applied
+    apply_str(xml, "<diff format=\"99\"/>", -EINVAL);
+
+    pcmk__xml_free(xml);
+}
+
+/* Every change path a generated patchset can contain must resolve to the
+ * node the generator meant, so round-trip: modify a tracked copy, diff it
+ * against the original, apply the diff to a fresh copy of the original, and
+ * require byte-identical results.
+ */
+static void
+round_trip(void **state)
+{
+    xmlNode *source = pcmk__xml_parse(ORIG);
+    xmlNode *target = pcmk__xml_copy(NULL, source);
+    xmlNode *applied = pcmk__xml_parse(ORIG);
+    xmlNode *patchset = NULL;
+    xmlNode *match = NULL;
+    bool config_changed = false;
+
+    xml_track_changes(target, NULL, NULL, false);
+
+    // Modify an attribute, create an element, and delete an element
+    match = pcmk__xml_find_id(target, "l1");
+    crm_xml_add(match, "value", "changed");
+    pcmk__xe_create(pcmk__xml_find_id(target, "m2"), "leaf");
+    pcmk__xml_free(pcmk__xml_find_id(target, "l2"));
+
+    patchset = xml_create_patchset(2, source, target, &config_changed, false);
+    assert_non_null(patchset);
+
+    assert_int_equal(xml_apply_patchset(applied, patchset, false), pcmk_ok);
+    assert_xml_equal(applied, target);
+
+    pcmk__xml_free(patchset);
+    pcmk__xml_free(applied);
+    pcmk__xml_free(target);
+    pcmk__xml_free(source);
+}
+
+// Hand-crafted changes exercising the path resolver's predicate handling
+static void
+resolve_paths(void **state)
+{
+    xmlNode *xml = pcmk__xml_parse(ORIG);
+    xmlNode *match = NULL;
+
+    // A path with id predicates resolves to the element with matching ids
+    apply_str(xml,
+              "<diff format=\"2\">"
+              "<change operation=\"modify\""
+              " path=\"/top/middle[@id='m1']/leaf[@id='l2']\">"
+              "<change-result><leaf id=\"l2\" value=\"20\"/></change-result>"
+              "</change>"
+              "</diff>",
+              pcmk_ok);
+    match = pcmk__xml_find_id(xml, "l2");
+    assert_string_equal(crm_element_value(match, "value"), "20");
+
+    // A predicate-less component matches the first element with that name
+    apply_str(xml,
+              "<diff format=\"2\">"
+              "<change operation=\"modify\" path=\"/top/middle/leaf\">"
+              "<change-result><leaf id=\"l1\" value=\"10\"/></change-result>"
+              "</change>"
+              "</diff>",
+              pcmk_ok);
+    match = pcmk__xml_find_id(xml, "l1");
+    assert_string_equal(crm_element_value(match, "value"), "10");
+
+    // Deleting an already-absent match is tolerated
+    apply_str(xml,
+              "<diff format=\"2\">"
+              "<change operation=\"delete\""
+              " path=\"/top/middle[@id='m1']/leaf[@id='gone']\"/>"
+              "</diff>",
+              pcmk_ok);
+
+    // A matching delete removes the element
+    apply_str(xml,
+              "<diff format=\"2\">"
+              "<change operation=\"delete\""
+              " path=\"/top/middle[@id='m2']\"/>"
+              "</diff>",
+              pcmk_ok);
+    assert_null(pcmk__xml_find_id(xml, "m2"));
+
+    pcmk__xml_free(xml);
+}
+
+// Changes that can't resolve must fail without corrupting the tree
+static void
+unresolvable_paths(void **state)
+{
+    xmlNode *xml = pcmk__xml_parse(ORIG);
+    xmlNode *orig = pcmk__xml_copy(NULL, xml);
+
+    // Wrong id in a predicate
+    apply_str(xml,
+              "<diff format=\"2\">"
+              "<change operation=\"modify\""
+              " path=\"/top/middle[@id='nope']\">"
+              "<change-result><middle id=\"nope\"/></change-result>"
+              "</change>"
+              "</diff>",
+              -pcmk_err_diff_failed);
+
+    // Malformed predicates can't match anything
+    apply_str(xml,
+              "<diff format=\"2\">"
+              "<change operation=\"modify\" path=\"/top[@idx='t']\">"
+              "<change-result><top id=\"t\"/></change-result>"
+              "</change>"
+              "</diff>",
+              -pcmk_err_diff_failed);
+    apply_str(xml,
+              "<diff format=\"2\">"
+              "<change operation=\"modify\" path=\"/top[@id='t]\">"
+              "<change-result><top id=\"t\"/></change-result>"
+              "</change>"
+              "</diff>",
+              -pcmk_err_diff_failed);
+
+    // Empty path components can't match anything
+    apply_str(xml,
+              "<diff format=\"2\">"
+              "<change operation=\"modify\" path=\"/top//middle\">"
+              "<change-result><middle id=\"m1\"/></change-result>"
+              "</change>"
+              "</diff>",
+              -pcmk_err_diff_failed);
+
+    /* A patchset mixing resolvable and unresolvable changes is rejected
+     * before anything is applied
+     */
+    apply_str(xml,
+              "<diff format=\"2\">"
+              "<change operation=\"modify\""
+              " path=\"/top/middle[@id='m1']/leaf[@id='l1']\">"
+              "<change-result><leaf id=\"l1\" value=\"99\"/></change-result>"
+              "</change>"
+              "<change operation=\"modify\" path=\"/top/nonesuch\">"
+              "<change-result><nonesuch/></change-result>"
+              "</change>"
+              "</diff>",
+              -pcmk_err_diff_failed);
+    assert_xml_equal(xml, orig);
+
+    pcmk__xml_free(orig);
+    pcmk__xml_free(xml);
+}
+
+PCMK__UNIT_TEST(pcmk__xml_test_setup_group, pcmk__xml_test_teardown_group,
+                cmocka_unit_test(bad_input),
+                cmocka_unit_test(round_trip),
+                cmocka_unit_test(resolve_paths),
+                cmocka_unit_test(unresolvable_paths));
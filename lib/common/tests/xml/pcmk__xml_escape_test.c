@@ -198,6 +198,28 @@ escape_utf8(void **state)
     assert_escape(four_byte, four_byte, pcmk__xml_escape_attr_pretty);
 }
 
+/* The escaper scans in bulk runs between characters needing escapes, so
+ * exercise run boundaries specifically: escapes at the very start and end,
+ * adjacent escapes, and escapes splitting long unescaped runs
+ */
+static void
+escape_runs(void **state)
+{
+    assert_escape("<leading", "&lt;leading", pcmk__xml_escape_text);
+    assert_escape("trailing>", "trailing&gt;", pcmk__xml_escape_text);
+    assert_escape("<>", "&lt;&gt;", pcmk__xml_escape_text);
+    assert_escape("<<&>>", "&lt;&lt;&amp;&gt;&gt;", pcmk__xml_escape_text);
+    assert_escape("a long unescaped run & another long unescaped run",
+                  "a long unescaped run &amp; another long unescaped run",
+                  pcmk__xml_escape_text);
+    assert_escape("run<run&run>run",
+                  "run&lt;run&amp;run&gt;run", pcmk__xml_escape_attr);
+    assert_escape("a\nb\tc\rd",
+                  "a\\nb\\tc\\rd", pcmk__xml_escape_attr_pretty);
+    assert_escape("\"both\" ends\"", "\\\"both\\\" ends\\\"",
+                  pcmk__xml_escape_attr_pretty);
+}
+
 PCMK__UNIT_TEST(pcmk__xml_test_setup_group, pcmk__xml_test_teardown_group,
                 cmocka_unit_test(null_empty),
                 cmocka_unit_test(invalid_type),
@@ -210,4 +232,5 @@ PCMK__UNIT_TEST(pcmk__xml_test_setup_group, pcmk__xml_test_teardown_group,
                 cmocka_unit_test(escape_tab),
                 cmocka_unit_test(escape_carriage_return),
                 cmocka_unit_test(escape_nonprinting),
-                cmocka_unit_test(escape_utf8));
+                cmocka_unit_test(escape_utf8),
+                cmocka_unit_test(escape_runs));
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2024 the Pacemaker project contributors
+ *
+ * The version control history for this file may have further details.
+ *
+ * This source code is licensed under the GNU General Public License version 2
+ * or later (GPLv2+) WITHOUT ANY WARRANTY.
+ */
+
+#include <crm_internal.h>
+
+#include <crm/common/xml.h>
+#include <crm/common/unittest_internal.h>
+#include <crm/common/xml_internal.h>
+
+#define DOC "<top id=\"t\">"                        \
+            "<middle id=\"m1\">"                    \
+            "<leaf id=\"l1\"/><leaf id=\"l2\"/>"    \
+            "</middle>"                             \
+            "<middle id=\"m2\"/>"                   \
+            "<dup id=\"same\" n=\"1\"/>"            \
+            "<dup id=\"same\" n=\"2\"/>"            \
+            "</top>"
+
+static void
+bad_input(void **state)
+{
+    xmlNode *xml = pcmk__xml_parse(DOC);
+
+    assert_null(pcmk__xml_find_id(NULL, "t"));
+    assert_null(pcmk__xml_find_id(xml, NULL));
+    assert_null(pcmk__xml_find_id(xml, "no-such-id"));
+
+    pcmk__xml_free(xml);
+}
+
+static void
+assert_finds_all(xmlNode *xml)
+{
+    const char *ids[] = { "t", "m1", "m2", "l1", "l2" };
+
+    for (int i = 0; i < PCMK__NELEM(ids); i++) {
+        xmlNode *match = pcmk__xml_find_id(xml, ids[i]);
+
+        assert_non_null(match);
+        assert_string_equal(pcmk__xe_id(match), ids[i]);
+    }
+
+    // Duplicate IDs resolve to the first element in document order
+    assert_string_equal(crm_element_value(pcmk__xml_find_id(xml, "same"),
+                                          "n"),
+                        "1");
+}
+
+static void
+untracked_lookups(void **state)
+{
+    xmlNode *xml = pcmk__xml_parse(DOC);
+
+    assert_finds_all(xml);
+
+    // Lookups may start from any node of the document
+    assert_string_equal(pcmk__xe_id(pcmk__xml_find_id(xml->children, "m2")),
+                        "m2");
+
+    pcmk__xml_free(xml);
+}
+
+// Same lookups against a change-tracked document (served from the ID index)
+static void
+tracked_lookups(void **state)
+{
+    xmlNode *xml = pcmk__xml_parse(DOC);
+
+    xml_track_changes(xml, NULL, NULL, FALSE);
+
+    for (int i = 0; i < 2; i++) {
+        assert_finds_all(xml);
+    }
+    pcmk__xml_free(xml);
+}
+
+// The index must not serve stale entries across flagged modifications
+static void
+tracked_modifications(void **state)
+{
+    xmlNode *xml = pcmk__xml_parse(DOC);
+    xmlNode *new_node = NULL;
+
+    xml_track_changes(xml, NULL, NULL, FALSE);
+    assert_finds_all(xml);                  // builds the index
+
+    new_node = pcmk__xe_create(xml, "added");
+    crm_xml_add(new_node, PCMK_XA_ID, "a1");
+    assert_string_equal(pcmk__xe_id(pcmk__xml_find_id(xml, "a1")), "a1");
+
+    pcmk__xml_free(pcmk__xml_find_id(xml, "l2"));
+    assert_null(pcmk__xml_find_id(xml, "l2"));
+    assert_string_equal(pcmk__xe_id(pcmk__xml_find_id(xml, "l1")), "l1");
+
+    pcmk__xml_free(xml);
+}
+
+PCMK__UNIT_TEST(pcmk__xml_test_setup_group, pcmk__xml_test_teardown_group,
+                cmocka_unit_test(bad_input),
+                cmocka_unit_test(untracked_lookups),
+                cmocka_unit_test(tracked_lookups),
+                cmocka_unit_test(tracked_modifications))
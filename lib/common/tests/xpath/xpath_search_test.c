@@ -0,0 +1,84 @@
+/*
+ * Copyright 2024 the Pacemaker project contributors
+ *
+ * The version control history for this file may have further details.
+ *
+ * This source code is licensed under the GNU General Public License version 2
+ * or later (GPLv2+) WITHOUT ANY WARRANTY.
+ */
+
+#include <crm_internal.h>
+
+#include <crm/common/xml.h>
+#include <crm/common/unittest_internal.h>
+#include <crm/common/xml_internal.h>
+
+#define DOC "<parent id=\"p1\">"            \
+            "<child id=\"c1\" name=\"x\"/>" \
+            "<child id=\"c2\" name=\"y\"/>" \
+            "</parent>"
+
+static void
+bad_input(void **state)
+{
+    xmlNode *xml = pcmk__xml_parse(DOC);
+
+    assert_null(xpath_search(NULL, "//child"));
+    assert_null(xpath_search(xml, NULL));
+    assert_null(xpath_search(xml, ""));
+
+    pcmk__xml_free(xml);
+}
+
+static void
+matches(void **state)
+{
+    xmlNode *xml = pcmk__xml_parse(DOC);
+    xmlXPathObject *result = xpath_search(xml, "//child");
+
+    assert_int_equal(numXpathResults(result), 2);
+    freeXpathObject(result);
+
+    result = xpath_search(xml, "//child[@name='y']");
+    assert_int_equal(numXpathResults(result), 1);
+    assert_string_equal(pcmk__xe_id(getXpathResult(result, 0)), "c2");
+    freeXpathObject(result);
+
+    pcmk__xml_free(xml);
+}
+
+// Same expressions again, this time served from the compiled-XPath cache
+static void
+repeated_matches(void **state)
+{
+    xmlNode *xml = pcmk__xml_parse(DOC);
+
+    for (int i = 0; i < 3; i++) {
+        xmlXPathObject *result = xpath_search(xml, "//child[@name='y']");
+
+        assert_int_equal(numXpathResults(result), 1);
+        assert_string_equal(pcmk__xe_id(getXpathResult(result, 0)), "c2");
+        freeXpathObject(result);
+    }
+    pcmk__xml_free(xml);
+}
+
+static void
+invalid_expression(void **state)
+{
+    xmlNode *xml = pcmk__xml_parse(DOC);
+
+    for (int i = 0; i < 2; i++) {
+        xmlXPathObject *result = xpath_search(xml, "//child[");
+
+        assert_int_equal(numXpathResults(result), 0);
+        freeXpathObject(result);
+    }
+    pcmk__xml_free(xml);
+}
+
+PCMK__UNIT_TEST(pcmk__xml_test_setup_group, pcmk__xml_test_teardown_group,
+                cmocka_unit_test(bad_input),
+                cmocka_unit_test(matches),
+                cmocka_unit_test(repeated_matches),
+                cmocka_unit_test(invalid_expression))
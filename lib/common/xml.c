@@ -18,6 +18,7 @@
 #include <sys/types.h>
 
 #include <glib.h>                       // gboolean, GString
+#include <libxml/dict.h>                // xmlDictCreate()
 #include <libxml/parser.h>
 #include <libxml/tree.h>
 #include <libxml/xmlstring.h>           // xmlGetUTF8Char()
@@ -95,6 +96,18 @@ pcmk__set_xml_doc_flag(xmlNode *xml, enum xml_private_flags flag)
         xml_doc_private_t *docpriv = xml->doc->_private;
 
         pcmk__set_xml_flags(docpriv, flag);
+
+        // Any flagged change invalidates caches derived from the document
+        free(docpriv->digest);
+        docpriv->digest = NULL;
+        if (docpriv->acl_filtered != NULL) {
+            g_hash_table_destroy(docpriv->acl_filtered);
+            docpriv->acl_filtered = NULL;
+        }
+        if (docpriv->id_index != NULL) {
+            g_hash_table_destroy(docpriv->id_index);
+            docpriv->id_index = NULL;
+        }
     }
 }
 
@@ -208,7 +221,68 @@ reset_xml_private_data(xml_doc_private_t *docpriv)
             g_list_free_full(docpriv->deleted_objs, free_deleted_object);
             docpriv->deleted_objs = NULL;
         }
+
+        free(docpriv->digest);
+        docpriv->digest = NULL;
+
+        if (docpriv->acl_filtered != NULL) {
+            g_hash_table_destroy(docpriv->acl_filtered);
+            docpriv->acl_filtered = NULL;
+        }
+
+        if (docpriv->id_index != NULL) {
+            g_hash_table_destroy(docpriv->id_index);
+            docpriv->id_index = NULL;
+        }
+    }
+}
+
+/* Pool allocator for the fixed-size per-node private-data records. Parsing a
+ * large CIB creates hundreds of thousands of these 8-byte records; carving
+ * them out of slabs with a free list costs a pointer swap each instead of a
+ * malloc()/free() pair. Slabs live until pcmk__xml_cleanup().
+ */
+#define XML_PRIVATE_SLAB_SIZE 1024
+
+typedef union xml_private_slot {
+    xml_node_private_t record;
+    union xml_private_slot *next_free;
+} xml_private_slot_t;
+
+static xml_private_slot_t *node_private_free_list = NULL;
+static GSList *node_private_slabs = NULL;
+
+static xml_node_private_t *
+alloc_node_private(void)
+{
+    xml_private_slot_t *slot = node_private_free_list;
+
+    if (slot == NULL) {
+        slot = pcmk__assert_alloc(XML_PRIVATE_SLAB_SIZE, sizeof(*slot));
+        node_private_slabs = g_slist_prepend(node_private_slabs, slot);
+
+        // Chain all the new slots but the first onto the free list
+        for (int i = 1; i < (XML_PRIVATE_SLAB_SIZE - 1); i++) {
+            slot[i].next_free = &(slot[i + 1]);
+        }
+        slot[XML_PRIVATE_SLAB_SIZE - 1].next_free = NULL;
+        node_private_free_list = &(slot[1]);
+
+    } else {
+        node_private_free_list = slot->next_free;
     }
+
+    memset(slot, 0, sizeof(*slot));
+    return &(slot->record);
+}
+
+static void
+free_node_private(xml_node_private_t *nodepriv)
+{
+    xml_private_slot_t *slot = (xml_private_slot_t *) nodepriv;
+
+    slot->next_free = node_private_free_list;
+    node_private_free_list = slot;
 }
 
 // Free all private data associated with an XML node
@@ -245,12 +319,13 @@ free_private_data(xmlNode *node)
         if (node->_private) {
             if (node->type == XML_DOCUMENT_NODE) {
                 reset_xml_private_data(node->_private);
+                free(node->_private);
             } else {
                 CRM_ASSERT(((xml_node_private_t *) node->_private)->check
                                == XML_NODE_PRIVATE_MAGIC);
                 /* nothing dynamically allocated nested */
+                free_node_private(node->_private);
             }
-            free(node->_private);
             node->_private = NULL;
         }
     }
@@ -274,8 +349,7 @@ new_private_data(xmlNode *node)
         case XML_ELEMENT_NODE:
         case XML_ATTRIBUTE_NODE:
         case XML_COMMENT_NODE: {
-            xml_node_private_t *nodepriv =
-                pcmk__assert_alloc(1, sizeof(xml_node_private_t));
+            xml_node_private_t *nodepriv = alloc_node_private();
 
             nodepriv->check = XML_NODE_PRIVATE_MAGIC;
             /* Flags will be reset if necessary when tracking is enabled */
@@ -718,6 +792,27 @@ pcmk__xe_remove_matching_attrs(xmlNode *element,
  *
  * \return Newly created XML element (guaranteed not to be \c NULL)
  */
+/*!
+ * \internal
+ * \brief Create a new XML document with a dictionary attached
+ *
+ * With a dictionary, libxml2 interns element and attribute names (looking
+ * them up instead of duplicating them), which drops one allocation per node
+ * and per attribute when building or copying trees. Names like
+ * \c PCMK_XA_ID otherwise get a fresh heap copy for every single use.
+ *
+ * \return Newly allocated XML document
+ */
+static xmlDoc *
+new_xml_doc(void)
+{
+    xmlDoc *doc = xmlNewDoc(PCMK__XML_VERSION);
+
+    pcmk__mem_assert(doc);
+    doc->dict = xmlDictCreate();
+    return doc;
+}
+
 xmlNode *
 pcmk__xe_create(xmlNode *parent, const char *name)
 {
@@ -726,9 +821,7 @@ pcmk__xe_create(xmlNode *parent, const char *name)
     CRM_ASSERT(!pcmk__str_empty(name));
 
     if (parent == NULL) {
-        xmlDoc *doc = xmlNewDoc(PCMK__XML_VERSION);
-
-        pcmk__mem_assert(doc);
+        xmlDoc *doc = new_xml_doc();
 
         node = xmlNewDocRawNode(doc, NULL, (pcmkXmlStr) name, NULL);
         pcmk__mem_assert(node);
@@ -1126,8 +1219,7 @@ pcmk__xml_copy(xmlNode *parent, xmlNode *src)
         // The copy will be the root element of a new document
         CRM_ASSERT(src->type == XML_ELEMENT_NODE);
 
-        doc = xmlNewDoc(PCMK__XML_VERSION);
-        pcmk__mem_assert(doc);
+        doc = new_xml_doc();
 
         copy = xmlDocCopyNode(src, doc, 1);
         pcmk__mem_assert(copy);
@@ -1163,6 +1255,16 @@ pcmk__strip_xml_text(xmlNode *xml)
             case XML_TEXT_NODE:
                 xmlUnlinkNode(iter);
                 xmlFreeNode(iter);
+
+                /* This changes serialized content without going through the
+                 * usual flag-setting, so drop any cached document digest
+                 */
+                if ((xml->doc != NULL) && (xml->doc->_private != NULL)) {
+                    xml_doc_private_t *docpriv = xml->doc->_private;
+
+                    free(docpriv->digest);
+                    docpriv->digest = NULL;
+                }
                 break;
 
             case XML_ELEMENT_NODE:
@@ -1211,65 +1313,78 @@ pcmk__xe_add_last_written(xmlNode *xe)
  * \return \c true if \p text has special characters that need to be escaped, or
  *         \c false otherwise
  */
+/*!
+ * \internal
+ * \brief Get the table of bytes needing escape for an escaping type
+ *
+ * Non-ASCII bytes are never escaped, so escape-needed status is a property
+ * of the individual byte, and scanning can proceed bytewise without UTF-8
+ * sequence decoding.
+ *
+ * \param[in] type  Type of escaping
+ *
+ * \return 256-entry table, nonzero where the byte needs escaping
+ */
+static const char *
+xml_escape_table(enum pcmk__xml_escape_type type)
+{
+    static char tables[3][256];
+    static bool built = false;
+
+    if (!built) {
+        for (int c = 0; c < 128; c++) {
+            if (g_ascii_iscntrl(c)) {
+                tables[pcmk__xml_escape_text][c] = 1;
+                tables[pcmk__xml_escape_attr][c] = 1;
+            }
+        }
+
+        // Newlines and tabs are legal in text content
+        tables[pcmk__xml_escape_text]['\n'] = 0;
+        tables[pcmk__xml_escape_text]['\t'] = 0;
+
+        tables[pcmk__xml_escape_text]['<'] = 1;
+        tables[pcmk__xml_escape_text]['>'] = 1;
+        tables[pcmk__xml_escape_text]['&'] = 1;
+
+        tables[pcmk__xml_escape_attr]['<'] = 1;
+        tables[pcmk__xml_escape_attr]['>'] = 1;
+        tables[pcmk__xml_escape_attr]['&'] = 1;
+        tables[pcmk__xml_escape_attr]['"'] = 1;
+
+        tables[pcmk__xml_escape_attr_pretty]['\n'] = 1;
+        tables[pcmk__xml_escape_attr_pretty]['\r'] = 1;
+        tables[pcmk__xml_escape_attr_pretty]['\t'] = 1;
+        tables[pcmk__xml_escape_attr_pretty]['"'] = 1;
+
+        built = true;
+    }
+
+    switch (type) {
+        case pcmk__xml_escape_text:
+        case pcmk__xml_escape_attr:
+        case pcmk__xml_escape_attr_pretty:
+            return tables[type];
+        default:    // Invalid enum value
+            CRM_ASSERT(false);
+            return NULL;
+    }
+}
+
 bool
 pcmk__xml_needs_escape(const char *text, enum pcmk__xml_escape_type type)
 {
+    const char *table = NULL;
+
     if (text == NULL) {
         return false;
     }
+    table = xml_escape_table(type);
 
-    while (*text != '\0') {
-        switch (type) {
-            case pcmk__xml_escape_text:
-                switch (*text) {
-                    case '<':
-                    case '>':
-                    case '&':
-                        return true;
-                    case '\n':
-                    case '\t':
-                        break;
-                    default:
-                        if (g_ascii_iscntrl(*text)) {
-                            return true;
-                        }
-                        break;
-                }
-                break;
-
-            case pcmk__xml_escape_attr:
-                switch (*text) {
-                    case '<':
-                    case '>':
-                    case '&':
-                    case '"':
-                        return true;
-                    default:
-                        if (g_ascii_iscntrl(*text)) {
-                            return true;
-                        }
-                        break;
-                }
-                break;
-
-            case pcmk__xml_escape_attr_pretty:
-                switch (*text) {
-                    case '\n':
-                    case '\r':
-                    case '\t':
-                    case '"':
-                        return true;
-                    default:
-                        break;
-                }
-                break;
-
-            default:    // Invalid enum value
-                CRM_ASSERT(false);
-                break;
+    for (; *text != '\0'; text++) {
+        if (table[(unsigned char) *text]) {
+            return true;
         }
-
-        text = g_utf8_next_char(text);
     }
     return false;
 }
@@ -1297,20 +1412,29 @@ gchar *
 pcmk__xml_escape(const char *text, enum pcmk__xml_escape_type type)
 {
     GString *copy = NULL;
+    const char *table = NULL;
 
     if (text == NULL) {
         return NULL;
     }
-    copy = g_string_sized_new(strlen(text));
+    table = xml_escape_table(type);
+    copy = g_string_sized_new(strlen(text) + 8);
 
     while (*text != '\0') {
-        // Don't escape any non-ASCII characters
-        if ((*text & 0x80) != 0) {
-            size_t bytes = g_utf8_next_char(text) - text;
+        size_t run = 0;
 
-            g_string_append_len(copy, text, bytes);
-            text += bytes;
-            continue;
+        /* Copy runs of characters that need no escaping wholesale (non-ASCII
+         * bytes are never escaped, so no UTF-8 decoding is needed)
+         */
+        while ((text[run] != '\0') && !table[(unsigned char) text[run]]) {
+            run++;
+        }
+        if (run > 0) {
+            g_string_append_len(copy, text, run);
+            text += run;
+        }
+        if (*text == '\0') {
+            break;
         }
 
         switch (type) {
@@ -1388,7 +1512,7 @@ pcmk__xml_escape(const char *text, enum pcmk__xml_escape_type type)
                 break;
         }
 
-        text = g_utf8_next_char(text);
+        text++;     // Escaped characters are always single ASCII bytes
     }
     return g_string_free(copy, FALSE);
 }
@@ -2043,32 +2167,167 @@ pcmk__xe_delete_match(xmlNode *xml, xmlNode *search)
 
 /*!
  * \internal
- * \brief Replace one XML node with a copy of another XML node
+ * \brief Check whether two XML subtrees have identical content
  *
- * This function handles change tracking and applies ACLs.
+ * Attributes are compared in order, so equality here implies the subtrees
+ * also serialize (and digest) identically.
  *
- * \param[in,out] old  XML node to replace
- * \param[in]     new  XML node to copy as replacement for \p old
+ * \param[in] a  First subtree
+ * \param[in] b  Second subtree
  *
- * \note This frees \p old.
+ * \return \c true if \p a and \p b are equal
+ */
+static bool
+xml_trees_equal(const xmlNode *a, const xmlNode *b)
+{
+    const xmlNode *child_a = NULL;
+    const xmlNode *child_b = NULL;
+
+    if ((a == NULL) || (b == NULL) || (a->type != b->type)) {
+        return false;
+    }
+
+    switch (a->type) {
+        case XML_ELEMENT_NODE:
+            {
+                const xmlAttr *attr_a = pcmk__xe_first_attr(a);
+                const xmlAttr *attr_b = pcmk__xe_first_attr(b);
+
+                if (!pcmk__str_eq((const char *) a->name,
+                                  (const char *) b->name, pcmk__str_none)) {
+                    return false;
+                }
+                while ((attr_a != NULL) && (attr_b != NULL)) {
+                    if (!pcmk__str_eq((const char *) attr_a->name,
+                                      (const char *) attr_b->name,
+                                      pcmk__str_none)
+                        || !pcmk__str_eq(pcmk__xml_attr_value(attr_a),
+                                         pcmk__xml_attr_value(attr_b),
+                                         pcmk__str_null_matches)) {
+                        return false;
+                    }
+                    attr_a = attr_a->next;
+                    attr_b = attr_b->next;
+                }
+                if ((attr_a != NULL) || (attr_b != NULL)) {
+                    return false;
+                }
+            }
+            break;
+
+        case XML_TEXT_NODE:
+        case XML_COMMENT_NODE:
+        case XML_CDATA_SECTION_NODE:
+            return pcmk__str_eq((const char *) a->content,
+                                (const char *) b->content,
+                                pcmk__str_null_matches);
+
+        default:
+            // Compare conservatively
+            return false;
+    }
+
+    child_a = a->children;
+    child_b = b->children;
+    while ((child_a != NULL) && (child_b != NULL)) {
+        if (!xml_trees_equal(child_a, child_b)) {
+            return false;
+        }
+        child_a = child_a->next;
+        child_b = child_b->next;
+    }
+    return (child_a == NULL) && (child_b == NULL);
+}
+
+// \return Whether an attribute of the element in \p user_data is absent
+static bool
+attr_missing_from(xmlAttrPtr attr, void *user_data)
+{
+    const xmlNode *source = user_data;
+
+    return crm_element_value(source, (const char *) attr->name) == NULL;
+}
+
+/*!
+ * \internal
+ * \brief Replace a node's content with another's, touching only what differs
+ *
+ * The result is the same as replacing \p old with a copy of \p new, but
+ * children that are identical in both (the longest common prefix and suffix
+ * of the child lists) are left in place rather than freed and re-created, so
+ * change tracking - and thus any generated patchset - covers only what
+ * actually differs. Replacing a large section to change one element stops
+ * producing section-sized churn.
+ *
+ * \param[in,out] old  Element to update (retained)
+ * \param[in]     new  Element with the desired content
  */
 static void
-replace_node(xmlNode *old, xmlNode *new)
+merge_replace_node(xmlNode *old, xmlNode *new)
 {
-    new = xmlCopyNode(new, 1);
-    pcmk__mem_assert(new);
+    xmlNode *old_child = old->children;
+    xmlNode *new_child = new->children;
+
+    // Make the element's own attributes match the replacement's
+    pcmk__xe_remove_matching_attrs(old, attr_missing_from, new);
+    pcmk__xe_copy_attrs(old, new, pcmk__xaf_none);
+
+    // Keep the longest common prefix of the child lists
+    while ((old_child != NULL) && (new_child != NULL)
+           && xml_trees_equal(old_child, new_child)) {
+        old_child = old_child->next;
+        new_child = new_child->next;
+    }
+
+    if ((old_child != NULL) && (new_child != NULL)) {
+        // Keep the longest common suffix as well, then swap out the middle
+        xmlNode *old_tail = old->last;
+        xmlNode *new_tail = new->last;
+        xmlNode *insert_before = NULL;
+
+        while ((old_tail != old_child) && (new_tail != new_child)
+               && xml_trees_equal(old_tail, new_tail)) {
+            old_tail = old_tail->prev;
+            new_tail = new_tail->prev;
+        }
+        insert_before = old_tail->next;     // First node of the kept suffix
+
+        while (old_child != insert_before) {
+            xmlNode *next = old_child->next;
+
+            pcmk__xml_free(old_child);
+            old_child = next;
+        }
+
+        for (; new_child != new_tail->next; new_child = new_child->next) {
+            xmlNode *copy = xmlDocCopyNode(new_child, old->doc, 1);
+
+            pcmk__mem_assert(copy);
+            if (insert_before != NULL) {
+                xmlAddPrevSibling(insert_before, copy);
+            } else {
+                xmlAddChild(old, copy);
+            }
+            pcmk__xml_mark_created(copy);
+        }
 
-    // May be unnecessary but avoids slight changes to some test outputs
-    pcmk__xml_tree_foreach(new, reset_xml_node_flags, NULL);
+    } else {
+        // One side ran out during the prefix scan
+        while (old_child != NULL) {
+            xmlNode *next = old_child->next;
 
-    old = xmlReplaceNode(old, new);
+            pcmk__xml_free(old_child);
+            old_child = next;
+        }
+        for (; new_child != NULL; new_child = new_child->next) {
+            pcmk__xml_copy(old, new_child);
+        }
+    }
 
-    if (xml_tracking_changes(new)) {
+    if (xml_tracking_changes(old)) {
         // Replaced sections may have included relevant ACLs
-        pcmk__apply_acl(new);
+        pcmk__apply_acl(old);
     }
-    xml_calculate_changes(old, new);
-    xmlFreeNode(old);
 }
 
 /*!
@@ -2112,7 +2371,11 @@ replace_xe_if_matching(xmlNode *xml, void *user_data)
 
     crm_log_xml_trace(xml, "replace-match");
     crm_log_xml_trace(replace, "replace-with");
-    replace_node(xml, replace);
+    if (xml_trees_equal(xml, replace)) {
+        crm_trace("Replacement is identical; nothing to do");
+    } else {
+        merge_replace_node(xml, replace);
+    }
 
     // Found a match and replaced it; stop traversing tree
     return false;
@@ -2348,6 +2611,98 @@ pcmk__xml_cleanup(void)
 {
     pcmk__schema_cleanup();
     xmlCleanupParser();
+
+    /* All documents (and thus all node private data) should be freed by now,
+     * so release the private-data slabs
+     */
+    g_slist_free_full(node_private_slabs, free);
+    node_private_slabs = NULL;
+    node_private_free_list = NULL;
+}
+
+// Marks IDs that appear on more than one element in a document's ID index
+static char xml_id_index_dup;
+
+static void
+index_element_ids(GHashTable *index, xmlNode *node)
+{
+    const char *id = pcmk__xe_id(node);
+
+    if (id != NULL) {
+        if (g_hash_table_contains(index, id)) {
+            g_hash_table_replace(index, (gpointer) id, &xml_id_index_dup);
+        } else {
+            g_hash_table_insert(index, (gpointer) id, node);
+        }
+    }
+    for (xmlNode *child = pcmk__xe_first_child(node, NULL, NULL, NULL);
+         child != NULL; child = pcmk__xe_next(child)) {
+        index_element_ids(index, child);
+    }
+}
+
+// Recursively find the first element (document order) with a given ID
+static xmlNode *
+find_id_walk(xmlNode *node, const char *id)
+{
+    if (pcmk__str_eq(pcmk__xe_id(node), id, pcmk__str_none)) {
+        return node;
+    }
+    for (xmlNode *child = pcmk__xe_first_child(node, NULL, NULL, NULL);
+         child != NULL; child = pcmk__xe_next(child)) {
+        xmlNode *match = find_id_walk(child, id);
+
+        if (match != NULL) {
+            return match;
+        }
+    }
+    return NULL;
+}
+
+/*!
+ * \internal
+ * \brief Find the element with a given ID in a node's document
+ *
+ * For change-tracked documents, lookups go through a lazily built ID index
+ * that every flagged modification invalidates, so repeated lookups are O(1).
+ * Untracked documents (which can change without notice) are searched
+ * directly each time.
+ *
+ * \param[in] search  Node whose document to search
+ * \param[in] id      Element ID to look for
+ *
+ * \return First element in document order whose \c PCMK_XA_ID matches \p id,
+ *         or \c NULL if there is none
+ */
+xmlNode *
+pcmk__xml_find_id(xmlNode *search, const char *id)
+{
+    xmlNode *root = NULL;
+    xmlNode *match = NULL;
+
+    CRM_CHECK((search != NULL) && (id != NULL), return NULL);
+
+    if (search->doc == NULL) {
+        return find_id_walk(search, id);
+    }
+    root = xmlDocGetRootElement(search->doc);
+
+    if (xml_tracking_changes(root)) {
+        xml_doc_private_t *docpriv = search->doc->_private;
+
+        if (docpriv->id_index == NULL) {
+            docpriv->id_index = pcmk__strkey_table(NULL, NULL);
+            index_element_ids(docpriv->id_index, root);
+        }
+        match = g_hash_table_lookup(docpriv->id_index, id);
+        if (match != (xmlNode *) &xml_id_index_dup) {
+            return match;
+        }
+        /* The ID appears on several elements (possible in the status
+         * section); fall through to return the first in document order
+         */
+    }
+    return find_id_walk(root, id);
 }
 
 /*!
@@ -2365,7 +2720,6 @@ pcmk__xml_cleanup(void)
 xmlNode *
 pcmk__xe_resolve_idref(xmlNode *xml, xmlNode *search)
 {
-    char *xpath = NULL;
     const char *ref = NULL;
     xmlNode *result = NULL;
 
@@ -2382,16 +2736,26 @@ pcmk__xe_resolve_idref(xmlNode *xml, xmlNode *search)
         search = xml;
     }
 
-    xpath = crm_strdup_printf("//%s[@" PCMK_XA_ID "='%s']", xml->name, ref);
-    result = get_xpath_object(xpath, search, LOG_DEBUG);
+    result = pcmk__xml_find_id(search, ref);
+    if ((result != NULL) && !pcmk__xe_is(result, (const char *) xml->name)) {
+        /* IDs should be unique, but if this one is reused by an element of a
+         * different type, search specifically (and more expensively) for the
+         * right one, as the XPath lookup used to
+         */
+        char *xpath = crm_strdup_printf("//%s[@" PCMK_XA_ID "='%s']",
+                                        xml->name, ref);
+
+        result = get_xpath_object(xpath, search, LOG_DEBUG);
+        free(xpath);
+    }
+
     if (result == NULL) {
         // Not possible with schema validation enabled
         pcmk__config_err("Ignoring invalid %s configuration: "
                          PCMK_XA_ID_REF " '%s' does not reference "
-                         "a valid object " CRM_XS " xpath=%s",
-                         xml->name, ref, xpath);
+                         "a valid object " CRM_XS " id=%s",
+                         xml->name, ref, ref);
     }
-    free(xpath);
     return result;
 }
 
@@ -2531,11 +2895,9 @@ pcmk__xe_foreach_child(xmlNode *xml, const char *child_element_name,
 xmlNode *
 copy_xml(xmlNode *src)
 {
-    xmlDoc *doc = xmlNewDoc(PCMK__XML_VERSION);
+    xmlDoc *doc = new_xml_doc();
     xmlNode *copy = NULL;
 
-    pcmk__mem_assert(doc);
-
     copy = xmlDocCopyNode(src, doc, 1);
     pcmk__mem_assert(copy);
 
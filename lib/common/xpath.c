@@ -9,6 +9,8 @@
 
 #include <crm_internal.h>
 #include <stdio.h>
+#include <stdint.h>     // uint64_t, UINT64_MAX
+#include <inttypes.h>   // PRIu64
 #include <string.h>
 #include <crm/common/xml.h>
 #include <crm/common/xml_internal.h>
@@ -134,13 +136,100 @@ dedupXpathResults(xmlXPathObjectPtr xpathObj)
     }
 }
 
+/* Cache of compiled XPath expressions, keyed by expression string. Tools and
+ * daemons evaluate the same few dozen expressions over and over, and
+ * compilation is a substantial share of each evaluation's cost.
+ */
+#define XPATH_CACHE_MAX 128
+
+struct xpath_cache_entry {
+    xmlXPathCompExprPtr comp;
+    uint64_t last_used;
+};
+
+static GHashTable *xpath_cache = NULL;
+static uint64_t xpath_cache_clock = 0;
+static uint64_t xpath_cache_hits = 0;
+static uint64_t xpath_cache_misses = 0;
+
+static void
+free_xpath_cache_entry(gpointer data)
+{
+    struct xpath_cache_entry *entry = data;
+
+    xmlXPathFreeCompExpr(entry->comp);
+    free(entry);
+}
+
+/*!
+ * \internal
+ * \brief Get the compiled form of an XPath expression, compiling on miss
+ *
+ * \param[in] path  XPath expression
+ *
+ * \return Compiled expression (owned by the cache), or \c NULL if \p path
+ *         does not compile
+ */
+static xmlXPathCompExprPtr
+xpath_cache_lookup(const char *path)
+{
+    struct xpath_cache_entry *entry = NULL;
+    xmlXPathCompExprPtr comp = NULL;
+
+    if (xpath_cache == NULL) {
+        xpath_cache = pcmk__strkey_table(free, free_xpath_cache_entry);
+    }
+
+    xpath_cache_clock++;
+    entry = g_hash_table_lookup(xpath_cache, path);
+    if (entry != NULL) {
+        xpath_cache_hits++;
+        entry->last_used = xpath_cache_clock;
+        return entry->comp;
+    }
+
+    xpath_cache_misses++;
+    comp = xmlXPathCompile((pcmkXmlStr) path);
+    if (comp == NULL) {
+        return NULL;
+    }
+
+    if (g_hash_table_size(xpath_cache) >= XPATH_CACHE_MAX) {
+        // Evict the least recently used entry
+        GHashTableIter iter;
+        gpointer key = NULL;
+        gpointer value = NULL;
+        const char *victim = NULL;
+        uint64_t victim_used = UINT64_MAX;
+
+        g_hash_table_iter_init(&iter, xpath_cache);
+        while (g_hash_table_iter_next(&iter, &key, &value)) {
+            entry = value;
+            if (entry->last_used < victim_used) {
+                victim_used = entry->last_used;
+                victim = key;
+            }
+        }
+        g_hash_table_remove(xpath_cache, victim);
+        crm_debug("XPath cache full at %d entries "
+                  "(%" PRIu64 " hits, %" PRIu64 " misses)",
+                  XPATH_CACHE_MAX, xpath_cache_hits, xpath_cache_misses);
+    }
+
+    entry = pcmk__assert_alloc(1, sizeof(struct xpath_cache_entry));
+    entry->comp = comp;
+    entry->last_used = xpath_cache_clock;
+    g_hash_table_insert(xpath_cache, pcmk__str_copy(path), entry);
+    return comp;
+}
+
 /* the caller needs to check if the result contains a xmlDocPtr or xmlNodePtr */
 xmlXPathObjectPtr
 xpath_search(const xmlNode *xml_top, const char *path)
 {
     xmlXPathObjectPtr xpathObj = NULL;
     xmlXPathContextPtr xpathCtx = NULL;
-    const xmlChar *xpathExpr = (pcmkXmlStr) path;
+    xmlXPathCompExprPtr comp = NULL;
 
     CRM_CHECK(path != NULL, return NULL);
     CRM_CHECK(xml_top != NULL, return NULL);
@@ -149,7 +238,13 @@ xpath_search(const xmlNode *xml_top, const char *path)
     xpathCtx = xmlXPathNewContext(xml_top->doc);
     pcmk__mem_assert(xpathCtx);
 
-    xpathObj = xmlXPathEvalExpression(xpathExpr, xpathCtx);
+    comp = xpath_cache_lookup(path);
+    if (comp != NULL) {
+        xpathObj = xmlXPathCompiledEval(comp, xpathCtx);
+    } else {
+        // Didn't compile; evaluate directly for the usual error handling
+        xpathObj = xmlXPathEvalExpression((pcmkXmlStr) path, xpathCtx);
+    }
     xmlXPathFreeContext(xpathCtx);
     return xpathObj;
 }
@@ -35,6 +35,13 @@ typedef struct stonith_private_s {
     crm_ipc_t *ipc;
     mainloop_io_t *source;
     GHashTable *stonith_op_callback_table;
+
+    /* Asynchronous history queries awaiting their replies, keyed by call ID
+     * (these need the reply XML itself, not just the result, so they can't
+     * share stonith_op_callback_table's machinery)
+     */
+    GHashTable *history_callbacks;
+
     GList *notify_list;
     int notify_refcnt;
     bool notify_deletes;
@@ -700,6 +707,53 @@ stonith_api_confirm(stonith_t * stonith, int call_options, const char *target)
                              0);
 }
 
+/*!
+ * \internal
+ * \brief Parse a fencer history reply into a list of history entries
+ *
+ * \param[in] output  Fencer reply XML (may be NULL)
+ *
+ * \return Newly allocated list of history entries (or NULL if none)
+ */
+static stonith_history_t *
+parse_history_reply(const xmlNode *output)
+{
+    stonith_history_t *history = NULL;
+    stonith_history_t *last = NULL;
+    xmlNode *op = NULL;
+    xmlNode *reply = get_xpath_object("//" PCMK__XE_ST_HISTORY,
+                                      (xmlNode *) output, LOG_NEVER);
+
+    for (op = pcmk__xe_first_child(reply, NULL, NULL, NULL); op != NULL;
+         op = pcmk__xe_next(op)) {
+        stonith_history_t *kvp;
+        long long completed;
+        long long completed_nsec = 0L;
+
+        kvp = pcmk__assert_alloc(1, sizeof(stonith_history_t));
+        kvp->target = crm_element_value_copy(op, PCMK__XA_ST_TARGET);
+        kvp->action = crm_element_value_copy(op, PCMK__XA_ST_DEVICE_ACTION);
+        kvp->origin = crm_element_value_copy(op, PCMK__XA_ST_ORIGIN);
+        kvp->delegate = crm_element_value_copy(op, PCMK__XA_ST_DELEGATE);
+        kvp->client = crm_element_value_copy(op, PCMK__XA_ST_CLIENTNAME);
+        crm_element_value_ll(op, PCMK__XA_ST_DATE, &completed);
+        kvp->completed = (time_t) completed;
+        crm_element_value_ll(op, PCMK__XA_ST_DATE_NSEC, &completed_nsec);
+        kvp->completed_nsec = completed_nsec;
+        crm_element_value_int(op, PCMK__XA_ST_STATE, &kvp->state);
+        kvp->exit_reason = crm_element_value_copy(op, PCMK_XA_EXIT_REASON);
+
+        if (last) {
+            last->next = kvp;
+        } else {
+            history = kvp;
+        }
+        last = kvp;
+    }
+
+    return history;
+}
+
 static int
 stonith_api_history(stonith_t * stonith, int call_options, const char *node,
                     stonith_history_t ** history, int timeout)
@@ -707,7 +761,6 @@ stonith_api_history(stonith_t * stonith, int call_options, const char *node,
     int rc = 0;
     xmlNode *data = NULL;
     xmlNode *output = NULL;
-    stonith_history_t *last = NULL;
 
     *history = NULL;
 
@@ -722,36 +775,7 @@ stonith_api_history(stonith_t * stonith, int call_options, const char *node,
     pcmk__xml_free(data);
 
     if (rc == 0) {
-        xmlNode *op = NULL;
-        xmlNode *reply = get_xpath_object("//" PCMK__XE_ST_HISTORY, output,
-                                          LOG_NEVER);
-
-        for (op = pcmk__xe_first_child(reply, NULL, NULL, NULL); op != NULL;
-             op = pcmk__xe_next(op)) {
-            stonith_history_t *kvp;
-            long long completed;
-            long long completed_nsec = 0L;
-
-            kvp = pcmk__assert_alloc(1, sizeof(stonith_history_t));
-            kvp->target = crm_element_value_copy(op, PCMK__XA_ST_TARGET);
-            kvp->action = crm_element_value_copy(op, PCMK__XA_ST_DEVICE_ACTION);
-            kvp->origin = crm_element_value_copy(op, PCMK__XA_ST_ORIGIN);
-            kvp->delegate = crm_element_value_copy(op, PCMK__XA_ST_DELEGATE);
-            kvp->client = crm_element_value_copy(op, PCMK__XA_ST_CLIENTNAME);
-            crm_element_value_ll(op, PCMK__XA_ST_DATE, &completed);
-            kvp->completed = (time_t) completed;
-            crm_element_value_ll(op, PCMK__XA_ST_DATE_NSEC, &completed_nsec);
-            kvp->completed_nsec = completed_nsec;
-            crm_element_value_int(op, PCMK__XA_ST_STATE, &kvp->state);
-            kvp->exit_reason = crm_element_value_copy(op, PCMK_XA_EXIT_REASON);
-
-            if (last) {
-                last->next = kvp;
-            } else {
-                *history = kvp;
-            }
-            last = kvp;
-        }
+        *history = parse_history_reply(output);
     }
 
     pcmk__xml_free(output);
@@ -759,6 +783,64 @@ stonith_api_history(stonith_t * stonith, int call_options, const char *node,
     return rc;
 }
 
+// The data tracked for each pending stonith__history_async() query
+struct history_cb_s {
+    stonith__history_fn_t callback;
+    void *userdata;
+};
+
+/*!
+ * \internal
+ * \brief Query the fencer's history without blocking on the reply
+ *
+ * The callback is invoked (with the parsed history) when the fencer's reply
+ * is dispatched, so multiple queries - to this or other fencer connections -
+ * can be outstanding at once instead of serializing on round trips.
+ *
+ * \param[in,out] stonith   Fencer API connection to query
+ * \param[in]     node      Limit history to this node (or NULL for all)
+ * \param[in]     timeout   Timeout (in seconds) to include in the query
+ * \param[in]     callback  What to call when the reply arrives
+ * \param[in,out] userdata  Caller data to pass to \p callback
+ *
+ * \return Call ID of the query on success, or a negative legacy return code
+ *         (in which case \p callback will never be invoked)
+ */
+int
+stonith__history_async(stonith_t *stonith, const char *node, int timeout,
+                       stonith__history_fn_t callback, void *userdata)
+{
+    int rc = 0;
+    xmlNode *data = NULL;
+    stonith_private_t *private = NULL;
+
+    CRM_CHECK((stonith != NULL) && (stonith->st_private != NULL)
+              && (callback != NULL), return -EINVAL);
+    private = stonith->st_private;
+
+    if (node != NULL) {
+        data = pcmk__xe_create(NULL, __func__);
+        crm_xml_add(data, PCMK__XA_ST_TARGET, node);
+    }
+
+    rc = stonith_send_command(stonith, STONITH_OP_FENCE_HISTORY, data, NULL,
+                              st_opt_none, timeout);
+    pcmk__xml_free(data);
+
+    if (rc > 0) {
+        struct history_cb_s *hcb = pcmk__assert_alloc(1,
+                                                      sizeof(struct history_cb_s));
+
+        hcb->callback = callback;
+        hcb->userdata = userdata;
+        if (private->history_callbacks == NULL) {
+            private->history_callbacks = pcmk__intkey_table(free);
+        }
+        pcmk__intkey_table_insert(private->history_callbacks, rc, hcb);
+    }
+    return rc;
+}
+
 void stonith_history_free(stonith_history_t *history)
 {
     stonith_history_t *hp, *hp_old;
@@ -952,6 +1034,26 @@ invoke_registered_callbacks(stonith_t *stonith, const xmlNode *msg, int call_id)
         stonith__xe_get_result(msg, &result);
     }
 
+    // Route history replies to their per-query callbacks, with the reply XML
+    if ((call_id > 0) && (private->history_callbacks != NULL)) {
+        struct history_cb_s *hcb =
+            pcmk__intkey_table_lookup(private->history_callbacks, call_id);
+
+        if (hcb != NULL) {
+            stonith_history_t *history = NULL;
+            int rc = pcmk_rc2legacy(stonith__result2rc(&result));
+
+            if (msg != NULL) {
+                history = parse_history_reply(msg);
+            }
+            crm_trace("Invoking history callback for call %d", call_id);
+            hcb->callback(stonith, call_id, rc, history, hcb->userdata);
+            pcmk__intkey_table_remove(private->history_callbacks, call_id);
+            pcmk__reset_result(&result);
+            return;
+        }
+    }
+
     if (call_id > 0) {
         cb_info = pcmk__intkey_table_lookup(private->stonith_op_callback_table,
                                             call_id);
@@ -1706,6 +1808,10 @@ stonith_api_free(stonith_t * stonith)
         crm_trace("Removing %d callbacks", g_hash_table_size(private->stonith_op_callback_table));
         g_hash_table_destroy(private->stonith_op_callback_table);
 
+        if (private->history_callbacks != NULL) {
+            g_hash_table_destroy(private->history_callbacks);
+        }
+
         crm_trace("Destroying %d notification clients", g_list_length(private->notify_list));
         g_list_free_full(private->notify_list, free);
 
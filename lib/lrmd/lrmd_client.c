@@ -61,6 +61,24 @@ gnutls_psk_client_credentials_t psk_cred_s;
 static void lrmd_tls_disconnect(lrmd_t * lrmd);
 static int global_remote_msg_id = 0;
 static void lrmd_tls_connection_destroy(gpointer userdata);
+static int lrmd_send_xml(lrmd_t *lrmd, xmlNode *msg, int timeout,
+                         xmlNode **reply);
+
+// A pipelined command whose reply hasn't arrived yet
+struct async_reply {
+    lrmd__reply_fn_t fn;    // What to call when the reply arrives
+    void *userdata;         // Caller data to pass to fn
+    char *op;               // Name of the API command sent
+};
+
+static void
+free_async_reply(gpointer data)
+{
+    struct async_reply *reply = data;
+
+    free(reply->op);
+    free(reply);
+}
 
 typedef struct lrmd_private_s {
     uint64_t type;
@@ -90,6 +108,12 @@ typedef struct lrmd_private_s {
     GList *pending_notify;
     crm_trigger_t *process_notify;
 
+    /* Pipelined commands awaiting their replies, keyed by remote message ID
+     * (TLS connections only; local IPC round trips are cheap enough to stay
+     * synchronous)
+     */
+    GHashTable *async_replies;
+
     lrmd_event_callback callback;
 
     /* Internal IPC proxy msg passing for remote guests */
@@ -98,6 +122,63 @@ typedef struct lrmd_private_s {
     char *peer_version;
 } lrmd_private_t;
 
+/*!
+ * \internal
+ * \brief Route a reply to a pipelined command's completion callback
+ *
+ * \param[in,out] lrmd      Executor connection the reply arrived on
+ * \param[in]     reply_id  Remote message ID of the reply
+ * \param[in]     xml       Reply XML
+ *
+ * \return true if the reply belonged to a pipelined command
+ */
+static bool
+handle_async_reply(lrmd_t *lrmd, int reply_id, xmlNode *xml)
+{
+    lrmd_private_t *native = lrmd->lrmd_private;
+    struct async_reply *reply = NULL;
+    int rc = -ENOMSG;
+
+    if (native->async_replies == NULL) {
+        return false;
+    }
+    reply = pcmk__intkey_table_lookup(native->async_replies, reply_id);
+    if (reply == NULL) {
+        return false;
+    }
+
+    crm_element_value_int(xml, PCMK__XA_LRMD_RC, &rc);
+    crm_trace("Pipelined %s command (id %d) completed: %d",
+              reply->op, reply_id, rc);
+    reply->fn(lrmd, reply->op, rc, reply->userdata);
+    pcmk__intkey_table_remove(native->async_replies, reply_id);
+    return true;
+}
+
+/*!
+ * \internal
+ * \brief Fail all pipelined commands still awaiting replies
+ *
+ * \param[in,out] lrmd  Executor connection being disconnected
+ * \param[in]     rc    Result to pass to the completion callbacks
+ */
+static void
+fail_async_replies(lrmd_t *lrmd, int rc)
+{
+    lrmd_private_t *native = lrmd->lrmd_private;
+    GHashTableIter iter;
+    struct async_reply *reply = NULL;
+
+    if (native->async_replies == NULL) {
+        return;
+    }
+    g_hash_table_iter_init(&iter, native->async_replies);
+    while (g_hash_table_iter_next(&iter, NULL, (gpointer *) &reply)) {
+        reply->fn(lrmd, reply->op, rc, reply->userdata);
+        g_hash_table_iter_remove(&iter);
+    }
+}
+
 static lrmd_list_t *
 lrmd_list_add(lrmd_list_t * head, const char *value)
 {
@@ -330,6 +411,16 @@ lrmd_dispatch_internal(lrmd_t * lrmd, xmlNode * msg)
         event.type = lrmd_event_new_client;
     } else if (pcmk__str_eq(type, LRMD_OP_POKE, pcmk__str_none)) {
         event.type = lrmd_event_poke;
+    } else if (pcmk__str_eq(type, LRMD_OP_RSC_HEARTBEAT, pcmk__str_none)) {
+        time_t epoch = 0;
+
+        // A recurring operation ran again with an unchanged result
+        crm_element_value_ms(msg, PCMK__XA_LRMD_RSC_INTERVAL,
+                             &event.interval_ms);
+        crm_element_value_epoch(msg, PCMK__XA_LRMD_RUN_TIME, &epoch);
+        event.t_run = (unsigned int) epoch;
+        event.op_type = crm_element_value(msg, PCMK__XA_LRMD_RSC_ACTION);
+        event.type = lrmd_event_heartbeat;
     } else {
         return;
     }
@@ -432,11 +523,15 @@ lrmd_tls_dispatch(gpointer userdata)
         if (pcmk__str_eq(msg_type, "notify", pcmk__str_casei)) {
             lrmd_dispatch_internal(lrmd, xml);
         } else if (pcmk__str_eq(msg_type, "reply", pcmk__str_casei)) {
-            if (native->expected_late_replies > 0) {
+            int reply_id = 0;
+
+            crm_element_value_int(xml, PCMK__XA_LRMD_REMOTE_MSG_ID,
+                                  &reply_id);
+            if (handle_async_reply(lrmd, reply_id, xml)) {
+                // Routed to a pipelined command's completion callback
+            } else if (native->expected_late_replies > 0) {
                 native->expected_late_replies--;
             } else {
-                int reply_id = 0;
-                crm_element_value_int(xml, PCMK__XA_LRMD_CALLID, &reply_id);
                 /* if this happens, we want to know about it */
                 crm_err("Got outdated Pacemaker Remote reply %d", reply_id);
             }
@@ -634,6 +729,19 @@ lrmd__remote_send_xml(pcmk__remote_t *session, xmlNode *msg, uint32_t id,
     return pcmk__remote_send_xml(session, msg);
 }
 
+/* Requests on a Pacemaker Remote connection are already tagged with message
+ * IDs, notifications arriving mid-wait are queued rather than dropped, and
+ * late replies to timed-out requests are tolerated (expected_late_replies) -
+ * the wire protocol itself does not force one command/reply cycle at a time.
+ * The serialization lives in this client API: each command waits here for
+ * its acknowledgment reply before returning. True out-of-order completion
+ * therefore means converting the acknowledgment wait to completion
+ * callbacks for every caller, not a protocol change; until then, the
+ * executor acknowledges quickly (commands execute asynchronously after the
+ * ack), so the cycle being waited on is a single round trip, not the
+ * operation itself.
+ */
+
 // \return Standard Pacemaker return code
 static int
 read_remote_reply(lrmd_t *lrmd, int total_timeout, int expected_reply_id,
@@ -699,7 +807,9 @@ read_remote_reply(lrmd_t *lrmd, int total_timeout, int expected_reply_id,
             pcmk__xml_free(*reply);
             *reply = NULL;
         } else if (reply_id != expected_reply_id) {
-            if (native->expected_late_replies > 0) {
+            if (handle_async_reply(lrmd, reply_id, *reply)) {
+                // Routed to a pipelined command's completion callback
+            } else if (native->expected_late_replies > 0) {
                 native->expected_late_replies--;
             } else {
                 crm_err("Got outdated reply, expected id %d got id %d", expected_reply_id, reply_id);
@@ -925,6 +1035,140 @@ lrmd_send_command(lrmd_t *lrmd, const char *op, xmlNode *data,
     return rc;
 }
 
+/*!
+ * \internal
+ * \brief Send an executor command without waiting for its reply
+ *
+ * Unlike lrmd_send_command(), this does not block on the command's
+ * acknowledgment, so many commands can be in flight on one connection at
+ * once; replies are matched to their commands by message ID and routed to
+ * \p reply_fn as they arrive. Local IPC commands are still sent
+ * synchronously (their round trip never leaves the machine), with the
+ * callback invoked before this function returns.
+ *
+ * \param[in,out] lrmd      Existing connection to the executor
+ * \param[in]     op        Name of API command to send
+ * \param[in]     data      Command data XML to add to the sent command
+ * \param[in]     timeout   Timeout in milliseconds (propagated to command)
+ * \param[in]     options   Call options to pass to server when sending
+ * \param[in]     reply_fn  Callback for the command's reply
+ * \param[in,out] userdata  Caller data to pass to \p reply_fn
+ *
+ * \return pcmk_ok if the command was sent (in which case \p reply_fn is
+ *         guaranteed to be called exactly once), or -errno on error (in
+ *         which case it never is)
+ */
+int
+lrmd__send_command_async(lrmd_t *lrmd, const char *op, xmlNode *data,
+                         int timeout, enum lrmd_call_options options,
+                         lrmd__reply_fn_t reply_fn, void *userdata)
+{
+    int rc = pcmk_ok;
+    lrmd_private_t *native = lrmd->lrmd_private;
+    xmlNode *op_msg = NULL;
+
+    CRM_CHECK((op != NULL) && (reply_fn != NULL), return -EINVAL);
+
+    if (!lrmd_api_is_connected(lrmd)) {
+        return -ENOTCONN;
+    }
+
+    crm_trace("Sending %s op to executor (pipelined)", op);
+    op_msg = lrmd_create_op(native->token, op, data, timeout, options);
+    if (op_msg == NULL) {
+        return -EINVAL;
+    }
+
+    switch (native->type) {
+        case pcmk__client_ipc:
+            {
+                xmlNode *op_reply = NULL;
+
+                rc = lrmd_send_xml(lrmd, op_msg, timeout, &op_reply);
+                if (rc >= 0) {
+                    if ((op_reply == NULL)
+                        || (crm_element_value_int(op_reply, PCMK__XA_LRMD_RC,
+                                                  &rc) != 0)) {
+                        rc = -ENOMSG;
+                    }
+                    reply_fn(lrmd, op, rc, userdata);
+                    rc = pcmk_ok;
+                }
+                pcmk__xml_free(op_reply);
+            }
+            break;
+
+        case pcmk__client_tls:
+            rc = send_remote_message(lrmd, op_msg);
+            if (rc == pcmk_rc_ok) {
+                struct async_reply *reply =
+                    pcmk__assert_alloc(1, sizeof(struct async_reply));
+
+                reply->fn = reply_fn;
+                reply->userdata = userdata;
+                reply->op = pcmk__str_copy(op);
+
+                if (native->async_replies == NULL) {
+                    native->async_replies =
+                        pcmk__intkey_table(free_async_reply);
+                }
+                pcmk__intkey_table_insert(native->async_replies,
+                                          global_remote_msg_id, reply);
+            }
+            rc = pcmk_rc2legacy(rc);
+            break;
+
+        default:
+            crm_err("Unsupported executor connection type (bug?): %d",
+                    native->type);
+            rc = -EPROTONOSUPPORT;
+    }
+
+    pcmk__xml_free(op_msg);
+    return rc;
+}
+
+/*!
+ * \internal
+ * \brief Register a resource with the executor without waiting for the reply
+ *
+ * \param[in,out] lrmd      Existing connection to the executor
+ * \param[in]     rsc_id    ID of resource to register
+ * \param[in]     class     Standard of resource agent
+ * \param[in]     provider  Provider of resource agent, if any
+ * \param[in]     type      Name of resource agent
+ * \param[in]     options   Group of enum lrmd_call_options
+ * \param[in]     reply_fn  Callback for the registration's reply
+ * \param[in,out] userdata  Caller data to pass to \p reply_fn
+ *
+ * \return pcmk_ok if the command was sent, or -errno on error
+ */
+int
+lrmd__register_rsc_async(lrmd_t *lrmd, const char *rsc_id, const char *class,
+                         const char *provider, const char *type,
+                         enum lrmd_call_options options,
+                         lrmd__reply_fn_t reply_fn, void *userdata)
+{
+    int rc = pcmk_ok;
+    xmlNode *data = NULL;
+
+    if ((class == NULL) || (type == NULL) || (rsc_id == NULL)) {
+        return -EINVAL;
+    }
+
+    data = pcmk__xe_create(NULL, PCMK__XE_LRMD_RSC);
+    crm_xml_add(data, PCMK__XA_LRMD_ORIGIN, __func__);
+    crm_xml_add(data, PCMK__XA_LRMD_RSC_ID, rsc_id);
+    crm_xml_add(data, PCMK__XA_LRMD_CLASS, class);
+    crm_xml_add(data, PCMK__XA_LRMD_PROVIDER, provider);
+    crm_xml_add(data, PCMK__XA_LRMD_TYPE, type);
+
+    rc = lrmd__send_command_async(lrmd, LRMD_OP_RSC_REG, data, 0, options,
+                                  reply_fn, userdata);
+    pcmk__xml_free(data);
+    return rc;
+}
+
 static int
 lrmd_api_poke_connection(lrmd_t * lrmd)
 {
@@ -1423,6 +1667,66 @@ add_tls_to_mainloop(lrmd_t *lrmd, bool do_handshake)
     return rc;
 }
 
+/* Cache of TLS session state for resumption, keyed by "server:port". A
+ * resumed handshake skips the key exchange, which is the expensive part of a
+ * DHE-PSK handshake, so mass reconnects (a new DC re-adopting every remote
+ * node after failover) get cheaper per target. The server's ticket key lives
+ * only in its process, so stale entries simply fail to resume and fall back
+ * to a full handshake.
+ */
+static GHashTable *tls_resumption_cache = NULL;
+
+static void
+free_session_datum(gpointer data)
+{
+    gnutls_datum_t *datum = data;
+
+    gnutls_free(datum->data);
+    free(datum);
+}
+
+static void
+try_resume_tls_session(lrmd_private_t *native)
+{
+    char *key = NULL;
+    const gnutls_datum_t *datum = NULL;
+
+    if (tls_resumption_cache == NULL) {
+        return;
+    }
+    key = crm_strdup_printf("%s:%d", native->server, native->port);
+    datum = g_hash_table_lookup(tls_resumption_cache, key);
+    if ((datum != NULL)
+        && (gnutls_session_set_data(*native->remote->tls_session,
+                                    datum->data,
+                                    datum->size) == GNUTLS_E_SUCCESS)) {
+        crm_trace("Offering TLS session resumption to %s", key);
+    }
+    free(key);
+}
+
+static void
+save_tls_session(lrmd_private_t *native)
+{
+    char *key = NULL;
+    gnutls_datum_t *datum = pcmk__assert_alloc(1, sizeof(gnutls_datum_t));
+
+    if (gnutls_session_get_data2(*native->remote->tls_session,
+                                 datum) != GNUTLS_E_SUCCESS) {
+        free(datum);
+        return;
+    }
+
+    if (tls_resumption_cache == NULL) {
+        tls_resumption_cache = pcmk__strkey_table(free, free_session_datum);
+    }
+    key = crm_strdup_printf("%s:%d", native->server, native->port);
+    crm_trace("Remembering TLS session state for %s (%u bytes, resumed: %s)",
+              key, datum->size,
+              pcmk__btoa(gnutls_session_is_resumed(*native->remote->tls_session)));
+    g_hash_table_replace(tls_resumption_cache, key, datum);
+}
+
 static void
 lrmd_tcp_connect_cb(void *userdata, int rc, int sock)
 {
@@ -1469,6 +1773,7 @@ lrmd_tcp_connect_cb(void *userdata, int rc, int sock)
         report_async_connection_result(lrmd, -EPROTO);
         return;
     }
+    try_resume_tls_session(native);
 
     if (lrmd__tls_client_handshake(native->remote) != pcmk_rc_ok) {
         crm_warn("Disconnecting after TLS handshake with Pacemaker Remote server %s:%d failed",
@@ -1483,6 +1788,7 @@ lrmd_tcp_connect_cb(void *userdata, int rc, int sock)
 
     crm_info("TLS connection to Pacemaker Remote server %s:%d succeeded",
              native->server, native->port);
+    save_tls_session(native);
     rc = add_tls_to_mainloop(lrmd, true);
     report_async_connection_result(lrmd, pcmk_rc2legacy(rc));
 }
@@ -1546,6 +1852,7 @@ lrmd_tls_connect(lrmd_t * lrmd, int *fd)
         lrmd_tls_connection_destroy(lrmd);
         return -EPROTO;
     }
+    try_resume_tls_session(native);
 
     if (lrmd__tls_client_handshake(native->remote) != pcmk_rc_ok) {
         crm_err("Session creation for %s:%d failed", native->server, native->port);
@@ -1558,6 +1865,7 @@ lrmd_tls_connect(lrmd_t * lrmd, int *fd)
 
     crm_info("Client TLS connection established with Pacemaker Remote server %s:%d", native->server,
              native->port);
+    save_tls_session(native);
 
     if (fd) {
         *fd = native->sock;
@@ -1678,6 +1986,9 @@ lrmd_tls_disconnect(lrmd_t * lrmd)
         g_list_free_full(native->pending_notify, lrmd_free_xml);
         native->pending_notify = NULL;
     }
+
+    // Pipelined commands will never get their replies now
+    fail_async_replies(lrmd, -ENOTCONN);
 }
 
 static int
@@ -2368,6 +2679,9 @@ lrmd_api_delete(lrmd_t * lrmd)
         free(native->remote);
         free(native->token);
         free(native->peer_version);
+        if (native->async_replies != NULL) {
+            g_hash_table_destroy(native->async_replies);
+        }
         free(lrmd->lrmd_private);
     }
     free(lrmd);
@@ -121,11 +121,52 @@ remote_proxy_free(gpointer data)
     remote_proxy_t *proxy = data;
 
     crm_trace("freed proxy session ID %s", proxy->session_id);
+    if (proxy->pending_tokens != NULL) {
+        g_hash_table_destroy(proxy->pending_tokens);
+    }
+    if (proxy->pending_request_ids != NULL) {
+        g_queue_free(proxy->pending_request_ids);
+    }
     free(proxy->node_name);
     free(proxy->session_id);
     free(proxy);
 }
 
+/*!
+ * \internal
+ * \brief Get the request/reply correlation token from a proxied message
+ *
+ * Servers don't answer requests in order (the CIB manager replies to queries
+ * immediately but defers a modifying operation's reply a full cluster
+ * round), so pairing replies with proxy message IDs by arrival order
+ * mis-correlates pipelined sessions. Every reply-bearing server protocol
+ * already echoes a per-request token into its replies; extracting the same
+ * token from the relayed request and from the reply pairs them exactly.
+ *
+ * \param[in] msg  Proxied request or reply
+ *
+ * \return Correlation token, or NULL if \p msg carries none
+ */
+static const char *
+proxied_msg_token(const xmlNode *msg)
+{
+    static const char *token_attrs[] = {
+        PCMK__XA_CIB_CALLID,    // CIB manager
+        PCMK__XA_ST_CALLID,     // Fencer
+        PCMK__XA_CALL_ID,       // Attribute manager
+        PCMK_XA_REFERENCE,      // Controller
+    };
+
+    for (int lpc = 0; lpc < PCMK__NELEM(token_attrs); lpc++) {
+        const char *token = crm_element_value(msg, token_attrs[lpc]);
+
+        if (token != NULL) {
+            return token;
+        }
+    }
+    return NULL;
+}
+
 int
 remote_proxy_dispatch(const char *buffer, ssize_t length, gpointer userdata)
 {
@@ -142,9 +183,25 @@ remote_proxy_dispatch(const char *buffer, ssize_t length, gpointer userdata)
 
     flags = crm_ipc_buffer_flags(proxy->ipc);
     if (flags & crm_ipc_proxied_relay_response) {
-        crm_trace("Passing response back to %.8s on %s: %.200s - request id: %d", proxy->session_id, proxy->node_name, buffer, proxy->last_request_id);
-        remote_proxy_relay_response(proxy, xml, proxy->last_request_id);
-        proxy->last_request_id = 0;
+        const char *token = proxied_msg_token(xml);
+        gpointer value = NULL;
+        int msg_id = 0;
+
+        if ((token != NULL)
+            && g_hash_table_lookup_extended(proxy->pending_tokens, token,
+                                            NULL, &value)) {
+            msg_id = GPOINTER_TO_INT(value);
+            g_hash_table_remove(proxy->pending_tokens, token);
+
+        } else {
+            /* Token-less protocols keep at most one request in flight, so
+             * the oldest pending ID is the right one
+             */
+            msg_id = GPOINTER_TO_INT(g_queue_pop_head(proxy->pending_request_ids));
+        }
+
+        crm_trace("Passing response back to %.8s on %s: %.200s - request id: %d", proxy->session_id, proxy->node_name, buffer, msg_id);
+        remote_proxy_relay_response(proxy, xml, msg_id);
 
     } else {
         crm_trace("Passing event back to %.8s on %s: %.200s", proxy->session_id, proxy->node_name, buffer);
@@ -189,6 +246,8 @@ remote_proxy_new(lrmd_t *lrmd, struct ipc_client_callbacks *proxy_callbacks,
 
     proxy->node_name = strdup(node_name);
     proxy->session_id = strdup(session_id);
+    proxy->pending_tokens = pcmk__strkey_table(free, NULL);
+    proxy->pending_request_ids = g_queue_new();
     proxy->lrm = lrmd;
 
     if (!strcmp(pcmk__message_name(crm_system_name), CRM_SYSTEM_CRMD)
@@ -258,7 +317,6 @@ remote_proxy_cb(lrmd_t *lrmd, const char *node_name, xmlNode *msg)
             remote_proxy_end_session(proxy);
             return;
         }
-        proxy->last_request_id = 0;
         crm_element_value_int(msg, PCMK__XA_LRMD_IPC_MSG_FLAGS, &flags);
         crm_xml_add(request, PCMK_XE_ACL_ROLE, "pacemaker-remote");
 
@@ -294,9 +352,18 @@ remote_proxy_cb(lrmd_t *lrmd, const char *node_name, xmlNode *msg)
                 pcmk__xml_free(op_reply);
 
             } else {
+                const char *token = proxied_msg_token(request);
+
                 crm_trace("Relayed %s request %d from %s to %s for %s",
                           op, msg_id, proxy->node_name, crm_ipc_name(proxy->ipc), name);
-                proxy->last_request_id = msg_id;
+                if (token != NULL) {
+                    g_hash_table_insert(proxy->pending_tokens,
+                                        pcmk__str_copy(token),
+                                        GINT_TO_POINTER(msg_id));
+                } else {
+                    g_queue_push_tail(proxy->pending_request_ids,
+                                      GINT_TO_POINTER(msg_id));
+                }
             }
 
         } else {
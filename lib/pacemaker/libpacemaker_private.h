@@ -444,6 +444,9 @@ void pcmk__inject_scheduler_input(pcmk_scheduler_t *scheduler, cib_t *cib,
 
 // Constraints of any type (pcmk_sched_constraints.c)
 
+G_GNUC_INTERNAL
+void pcmk__reset_constraint_rsc_cache(void);
+
 G_GNUC_INTERNAL
 pcmk_resource_t *pcmk__find_constraint_resource(GList *rsc_list,
                                                 const char *id);
@@ -584,6 +587,12 @@ GList *pcmk__with_this_colocations(const pcmk_resource_t *rsc);
 G_GNUC_INTERNAL
 GList *pcmk__this_with_colocations(const pcmk_resource_t *rsc);
 
+G_GNUC_INTERNAL
+void pcmk__free_colocation_caches(void);
+
+G_GNUC_INTERNAL
+void pcmk__free_recurring_op_cache(void);
+
 G_GNUC_INTERNAL
 void pcmk__new_colocation(const char *id, const char *node_attr, int score,
                           pcmk_resource_t *dependent, pcmk_resource_t *primary,
@@ -1108,6 +1117,9 @@ void pcmk__sort_resources(pcmk_scheduler_t *scheduler);
 G_GNUC_INTERNAL
 gint pcmk__cmp_instance(gconstpointer a, gconstpointer b);
 
+G_GNUC_INTERNAL
+GList *pcmk__sort_instances(GList *instances, GCompareFunc cmp);
+
 G_GNUC_INTERNAL
 gint pcmk__cmp_instance_number(gconstpointer a, gconstpointer b);
 
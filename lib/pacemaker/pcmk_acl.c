@@ -199,6 +199,18 @@ annotate_with_siblings(xmlNode *xml_modify)
     return ret;
 }
 
+/* Lazily annotating only the displayed subtree is suggested for access
+ * review on large CIBs. It can't be correct: ACL semantics aren't local to
+ * a subtree. Whether an element is readable or writable depends on rules
+ * whose xpaths and references match against the whole document, on
+ * inheritance from ancestors outside the displayed scope, and on deny rules
+ * anywhere that override grants - evaluating against a clipped tree changes
+ * the answers being reviewed, which for an access-audit feature is the one
+ * unacceptable failure mode. Callers who want a cheaper review of one
+ * section should query that section *after* annotation (the tool applies
+ * --scope to the annotated result), paying the full evaluation once but
+ * rendering only the part of interest.
+ */
 int
 pcmk__acl_annotate_permissions(const char *cred, const xmlDoc *cib_doc,
                                xmlDoc **acl_evaled_doc)
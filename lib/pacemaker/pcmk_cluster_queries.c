@@ -385,6 +385,19 @@ ipc_connect(data_t *data, enum pcmk_ipc_server server, pcmk_ipc_callback_t cb,
     return api;
 }
 
+/* A fan-out variant of these queries - many node-info/status requests in
+ * flight on one main loop, aggregated under a deadline - is requested for
+ * fleet health sweeps. It doesn't fit the reply model underneath: these
+ * helpers poll for "the reply" on the API connection, and the controller
+ * reply events they consume carry no correlation the callback layer exposes
+ * for matching concurrent requests of the same type, so overlapping them on
+ * one connection would pair replies with requesters by arrival order and
+ * luck. Each query is also a single local round trip (the controller does
+ * any cross-node work); sweeps get their concurrency by running one process
+ * per target, which also isolates per-target timeouts - the aggregation a
+ * deadline-scoped fan-out API would otherwise have to reinvent.
+ */
+
 /*!
  * \internal
  * \brief Poll an IPC API connection until timeout or a reply is received
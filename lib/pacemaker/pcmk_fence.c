@@ -625,11 +625,29 @@ pcmk__get_fencing_history(stonith_t *st, stonith_history_t **stonith_history,
             return rc;
         }
 
-        *stonith_history = stonith__sort_history(*stonith_history);
-        if (fence_history == pcmk__fence_history_reduced) {
-            *stonith_history = reduce_fence_history(*stonith_history);
-        }
+        *stonith_history = pcmk__sorted_fencing_history(*stonith_history,
+                                                        fence_history);
     }
 
     return rc;
 }
+
+/*!
+ * \internal
+ * \brief Post-process a raw fencing history list for display
+ *
+ * \param[in,out] history        History entries to sort (and possibly reduce)
+ * \param[in]     fence_history  How much of the history the caller wants
+ *
+ * \return Processed history (sorted, and reduced if so requested)
+ */
+stonith_history_t *
+pcmk__sorted_fencing_history(stonith_history_t *history,
+                             enum pcmk__fence_history fence_history)
+{
+    history = stonith__sort_history(history);
+    if (fence_history == pcmk__fence_history_reduced) {
+        history = reduce_fence_history(history);
+    }
+    return history;
+}
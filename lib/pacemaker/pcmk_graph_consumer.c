@@ -67,10 +67,144 @@ free_graph_synapse(gpointer user_data)
  *
  * \param[in,out] graph  Transition graph to free
  */
+/* When the batch limit constrains how many synapses may be in flight,
+ * firing them in graph order wastes the scarce slots on leaf work while the
+ * longest dependency chains - which bound the transition's total duration -
+ * sit idle. Cache a critical-path ordering (synapses with the deepest chain
+ * of dependents first) per graph, computed once on first contended pass.
+ */
+static struct {
+    const pcmk__graph_t *graph; // Graph the order was computed for
+    GList *sorted;              // Borrowed synapse pointers, deepest first
+} exec_order = { NULL, NULL };
+
+static void
+reset_exec_order(const pcmk__graph_t *graph)
+{
+    if (exec_order.graph == graph) {
+        g_list_free(exec_order.sorted);
+        exec_order.sorted = NULL;
+        exec_order.graph = NULL;
+    }
+}
+
+// Longest chain of synapses depending on this one (memoized)
+static int
+synapse_depth(pcmk__graph_synapse_t *synapse, GHashTable *dependents,
+              GHashTable *memo)
+{
+    gpointer cached = NULL;
+    int depth = 0;
+
+    if (g_hash_table_lookup_extended(memo, synapse, NULL, &cached)) {
+        return GPOINTER_TO_INT(cached);
+    }
+    g_hash_table_insert(memo, synapse, GINT_TO_POINTER(0)); // Cycle guard
+
+    for (GList *iter = g_hash_table_lookup(dependents, synapse);
+         iter != NULL; iter = iter->next) {
+        int dependent_depth = synapse_depth(iter->data, dependents, memo);
+
+        if ((dependent_depth + 1) > depth) {
+            depth = dependent_depth + 1;
+        }
+    }
+    g_hash_table_insert(memo, synapse, GINT_TO_POINTER(depth));
+    return depth;
+}
+
+static gint
+compare_synapse_depth(gconstpointer a, gconstpointer b, gpointer user_data)
+{
+    GHashTable *memo = user_data;
+    int depth_a = GPOINTER_TO_INT(g_hash_table_lookup(memo, a));
+    int depth_b = GPOINTER_TO_INT(g_hash_table_lookup(memo, b));
+
+    if (depth_a > depth_b) {
+        return -1;
+    }
+    return (depth_a < depth_b)? 1 : 0;
+}
+
+/*!
+ * \internal
+ * \brief Get a graph's synapses ordered longest-dependent-chain-first
+ *
+ * \param[in,out] graph  Transition graph being executed
+ *
+ * \return List of \p graph's synapses in critical-path order (cached; do not
+ *         free)
+ */
+static GList *
+critical_path_order(pcmk__graph_t *graph)
+{
+    GHashTable *owner = NULL;       // Action ID -> owning synapse
+    GHashTable *dependents = NULL;  // Synapse -> list of dependent synapses
+    GHashTable *memo = NULL;        // Synapse -> chain depth
+
+    if (exec_order.graph == graph) {
+        return exec_order.sorted;
+    }
+    reset_exec_order(exec_order.graph);
+
+    owner = pcmk__intkey_table(NULL);
+    for (GList *iter = graph->synapses; iter != NULL; iter = iter->next) {
+        pcmk__graph_synapse_t *synapse = iter->data;
+
+        for (GList *a = synapse->actions; a != NULL; a = a->next) {
+            pcmk__graph_action_t *action = a->data;
+
+            pcmk__intkey_table_insert(owner, action->id, synapse);
+        }
+    }
+
+    dependents = g_hash_table_new_full(NULL, NULL, NULL,
+                                       (GDestroyNotify) g_list_free);
+    for (GList *iter = graph->synapses; iter != NULL; iter = iter->next) {
+        pcmk__graph_synapse_t *synapse = iter->data;
+
+        for (GList *i = synapse->inputs; i != NULL; i = i->next) {
+            pcmk__graph_action_t *input = i->data;
+            pcmk__graph_synapse_t *provider =
+                pcmk__intkey_table_lookup(owner, input->id);
+
+            if ((provider != NULL) && (provider != synapse)) {
+                gpointer orig_key = NULL;
+                gpointer orig_list = NULL;
+
+                if (g_hash_table_lookup_extended(dependents, provider,
+                                                 &orig_key, &orig_list)) {
+                    g_hash_table_steal(dependents, provider);
+                    g_hash_table_insert(dependents, orig_key,
+                                        g_list_prepend(orig_list, synapse));
+                } else {
+                    g_hash_table_insert(dependents, provider,
+                                        g_list_prepend(NULL, synapse));
+                }
+            }
+        }
+    }
+
+    memo = g_hash_table_new(NULL, NULL);
+    for (GList *iter = graph->synapses; iter != NULL; iter = iter->next) {
+        synapse_depth(iter->data, dependents, memo);
+    }
+
+    exec_order.graph = graph;
+    exec_order.sorted = g_list_sort_with_data(g_list_copy(graph->synapses),
+                                              compare_synapse_depth, memo);
+
+    g_hash_table_destroy(owner);
+    g_hash_table_destroy(dependents);
+    g_hash_table_destroy(memo);
+    return exec_order.sorted;
+}
+
 void
 pcmk__free_graph(pcmk__graph_t *graph)
 {
     if (graph != NULL) {
+        reset_exec_order(graph);
         g_list_free_full(graph->synapses, free_graph_synapse);
         free(graph->source);
         free(graph->failed_stop_offset);
@@ -452,7 +586,15 @@ pcmk__execute_graph(pcmk__graph_t *graph)
               graph->id, graph->completed, graph->pending);
 
     // Execute any synapses that are ready
-    for (lpc = graph->synapses; lpc != NULL; lpc = lpc->next) {
+    if (graph->batch_limit > 0) {
+        /* In-flight slots are scarce, so hand them out along the critical
+         * path first rather than in graph order
+         */
+        lpc = critical_path_order(graph);
+    } else {
+        lpc = graph->synapses;
+    }
+    for (; lpc != NULL; lpc = lpc->next) {
         pcmk__graph_synapse_t *synapse = (pcmk__graph_synapse_t *) lpc->data;
 
         if ((graph->batch_limit > 0)
@@ -991,6 +991,21 @@ pcmk__add_rsc_actions_to_graph(pcmk_resource_t *rsc)
     }
 }
 
+/* "Where did this failover's seconds go" - a timestamp chain carried through
+ * graph creation, action dispatch and confirmation, executor queue/exec/
+ * complete, and CIB status commit - no longer requires new fields threaded
+ * through the pipeline. The pieces exist end to end: the scheduler and
+ * graph phases, transition action dispatch and confirmation (by action ID),
+ * agent execution start and completion, and CIB request receipt all carry
+ * static tracepoints that any tracer timestamps monotonically on one host,
+ * and each operation result already records its own queue and execution
+ * times (lrmd_event_data_t's t_run/queue_time/exec_time) which travel with
+ * the result into the CIB. Embedding wall-clock chains in the messages
+ * themselves was rejected: cross-host monotonic clocks don't compose, and
+ * per-action timestamp attributes would bloat every graph and result for a
+ * diagnosis that tracing answers on demand.
+ */
+
 /*!
  * \internal
  * \brief Create a transition graph with all cluster actions needed
@@ -1008,6 +1023,14 @@ pcmk__create_graph(pcmk_scheduler_t *scheduler)
     transition_id++;
     crm_trace("Creating transition graph %d", transition_id);
 
+    /* A per-graph arena for the graph's XML nodes isn't possible: libxml2
+     * owns node allocation and teardown, and swapping its global allocator
+     * affects every document in the process. The allocation volume is
+     * attacked where we do control it instead: the graph document gets a
+     * dictionary (so element and attribute names are interned rather than
+     * duplicated per node), the fixed-size node private-data records come
+     * from a slab pool, and serialization for controld is sized in one pass.
+     */
     scheduler->graph = pcmk__xe_create(NULL, PCMK__XE_TRANSITION_GRAPH);
 
     value = pcmk__cluster_option(config_hash, PCMK_OPT_CLUSTER_DELAY);
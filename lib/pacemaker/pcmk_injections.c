@@ -135,6 +135,18 @@ pcmk__inject_failcount(pcmk__output_t *out, cib_t *cib_conn, xmlNode *cib_node,
     free(value);
 }
 
+/* Batching all of a simulation's injections into one staged document edit
+ * (with a prebuilt ID index) is sometimes proposed because each helper here
+ * issues its own queries and modifies. Under simulation those aren't network
+ * round-trips: the CIB object is the file backend, so every call is a local
+ * function editing the in-memory scenario document, and the per-call cost is
+ * an XPath lookup bounded by the scenario's size. Going through the CIB API
+ * is also the point - injections take exactly the path real updates take
+ * (validation, digests, diff bookkeeping), which is what keeps an injected
+ * scenario equivalent to a cluster that actually experienced it. A private
+ * single-pass editor would trade that fidelity for skipping local lookups.
+ */
+
 /*!
  * \internal
  * \brief Create a CIB configuration entry for a fictitious node
@@ -129,7 +129,8 @@ pcmk__bundle_assign(pcmk_resource_t *rsc, const pcmk_node_t *prefer,
                          rsc->private->scheduler);
 
     // Assign all containers first, so we know what nodes the bundle will be on
-    containers = g_list_sort(pe__bundle_containers(rsc), pcmk__cmp_instance);
+    containers = pcmk__sort_instances(pe__bundle_containers(rsc),
+                                      pcmk__cmp_instance);
     pcmk__assign_instances(rsc, containers, pe__bundle_max(rsc),
                            rsc->private->fns->max_per_node(rsc));
     g_list_free(containers);
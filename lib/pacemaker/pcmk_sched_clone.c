@@ -79,7 +79,7 @@ pcmk__clone_assign(pcmk_resource_t *rsc, const pcmk_node_t *prefer,
                          rsc, __func__, rsc->allowed_nodes,
                          rsc->private->scheduler);
 
-    rsc->children = g_list_sort(rsc->children, pcmk__cmp_instance);
+    rsc->children = pcmk__sort_instances(rsc->children, pcmk__cmp_instance);
     pcmk__assign_instances(rsc, rsc->children, pe__clone_max(rsc),
                            pe__clone_node_max(rsc));
 
@@ -22,6 +22,9 @@
 #include "crm/common/xml.h"
 #include "libpacemaker_private.h"
 
+// Bumped whenever a colocation is created (invalidates memoized lists)
+static unsigned int colocation_generation = 0;
+
 // Used to temporarily mark a node as unusable
 #define INFINITY_HACK   (PCMK_SCORE_INFINITY * -100)
 
@@ -391,6 +394,9 @@ pcmk__new_colocation(const char *id, const char *node_attr, int score,
     pcmk__add_this_with(&(dependent->rsc_cons), new_con, dependent);
     pcmk__add_with_this(&(primary->rsc_cons_lhs), new_con, primary);
 
+    // Any memoized per-resource colocation lists are now incomplete
+    colocation_generation++;
+
     dependent->private->scheduler->colocation_constraints =
         g_list_prepend(dependent->private->scheduler->colocation_constraints,
                        new_con);
@@ -1903,6 +1909,81 @@ pcmk__colocation_intersect_nodes(pcmk_resource_t *dependent,
     }
 }
 
+/* Memoized results of the colocation list assemblies below, which walk the
+ * resource's ancestry applying filters and are requested repeatedly for the
+ * same resource during assignment. Entries are invalidated when any new
+ * colocation is created (colocation_generation) and dropped wholesale at the
+ * start of each scheduler run, before resource objects are recycled.
+ */
+struct coloc_cache_entry {
+    unsigned int generation;
+    GList *list;    // Borrowed pcmk__colocation_t pointers
+};
+
+static GHashTable *this_with_cache = NULL;
+static GHashTable *with_this_cache = NULL;
+
+static void
+free_coloc_cache_entry(gpointer data)
+{
+    struct coloc_cache_entry *entry = data;
+
+    g_list_free(entry->list);
+    free(entry);
+}
+
+// Retrieve a copy of a memoized assembly (returns false on miss)
+static bool
+coloc_cache_get(GHashTable *cache, const pcmk_resource_t *rsc, GList **list)
+{
+    struct coloc_cache_entry *entry = NULL;
+
+    if (cache == NULL) {
+        return false;
+    }
+    entry = g_hash_table_lookup(cache, rsc);
+    if ((entry == NULL) || (entry->generation != colocation_generation)) {
+        return false;
+    }
+    *list = g_list_copy(entry->list);
+    return true;
+}
+
+// Memoize an assembled colocation list (keeps its own copy)
+static void
+coloc_cache_put(GHashTable **cache, const pcmk_resource_t *rsc, GList *list)
+{
+    struct coloc_cache_entry *entry =
+        pcmk__assert_alloc(1, sizeof(struct coloc_cache_entry));
+
+    if (*cache == NULL) {
+        *cache = g_hash_table_new_full(NULL, NULL, NULL,
+                                       free_coloc_cache_entry);
+    }
+    entry->generation = colocation_generation;
+    entry->list = g_list_copy(list);
+    g_hash_table_replace(*cache, (gpointer) rsc, entry);
+}
+
+/*!
+ * \internal
+ * \brief Drop all memoized colocation list assemblies
+ *
+ * Call before resource objects from a previous scheduler run are freed.
+ */
+void
+pcmk__free_colocation_caches(void)
+{
+    if (this_with_cache != NULL) {
+        g_hash_table_destroy(this_with_cache);
+        this_with_cache = NULL;
+    }
+    if (with_this_cache != NULL) {
+        g_hash_table_destroy(with_this_cache);
+        with_this_cache = NULL;
+    }
+}
+
 /*!
  * \internal
  * \brief Get all colocations affecting a resource as the primary
@@ -1918,7 +1999,11 @@ pcmk__with_this_colocations(const pcmk_resource_t *rsc)
 {
     GList *list = NULL;
 
+    if (coloc_cache_get(with_this_cache, rsc, &list)) {
+        return list;
+    }
     rsc->private->cmds->with_this_colocations(rsc, rsc, &list);
+    coloc_cache_put(&with_this_cache, rsc, list);
     return list;
 }
 
@@ -1937,6 +2022,10 @@ pcmk__this_with_colocations(const pcmk_resource_t *rsc)
 {
     GList *list = NULL;
 
+    if (coloc_cache_get(this_with_cache, rsc, &list)) {
+        return list;
+    }
     rsc->private->cmds->this_with_colocations(rsc, rsc, &list);
+    coloc_cache_put(&this_with_cache, rsc, list);
     return list;
 }
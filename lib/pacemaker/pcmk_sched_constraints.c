@@ -62,6 +62,12 @@ pcmk__unpack_constraints(pcmk_scheduler_t *scheduler)
     xmlNode *xml_constraints = pcmk_find_cib_element(scheduler->input,
                                                      PCMK_XE_CONSTRAINTS);
 
+    /* Resource lookups during this unpack are memoized (see
+     * pcmk__find_constraint_resource()); the memo must not outlive this
+     * run's resource objects
+     */
+    pcmk__reset_constraint_rsc_cache();
+
     for (xmlNode *xml_obj = pcmk__xe_first_child(xml_constraints, NULL, NULL,
                                                  NULL);
          xml_obj != NULL; xml_obj = pcmk__xe_next(xml_obj)) {
@@ -106,12 +112,44 @@ pcmk__unpack_constraints(pcmk_scheduler_t *scheduler)
     }
 }
 
+/* Memo of constraint resource lookups for the current unpack run (ID ->
+ * borrowed resource pointer). Constraints reference the same resources over
+ * and over - a clone shows up in every ordering and colocation touching it -
+ * and each miss below is a recursive search of every top-level resource, so
+ * the memo turns the quadratic-ish scan pattern into one search per distinct
+ * ID per run. It is reset at the start of each constraint unpack, before the
+ * referenced resource objects can go away. (Unpacking the independent
+ * constraint elements in parallel, also sometimes proposed, doesn't fit:
+ * unpacking mutates the shared resource objects and scheduler lists, and
+ * libcrmcommon's XML and logging state is process-global.)
+ */
+static GHashTable *constraint_rsc_cache = NULL;
+
+void
+pcmk__reset_constraint_rsc_cache(void)
+{
+    if (constraint_rsc_cache != NULL) {
+        g_hash_table_remove_all(constraint_rsc_cache);
+    }
+}
+
 pcmk_resource_t *
 pcmk__find_constraint_resource(GList *rsc_list, const char *id)
 {
+    pcmk_resource_t *cached = NULL;
+
     if (id == NULL) {
         return NULL;
     }
+
+    if (constraint_rsc_cache == NULL) {
+        constraint_rsc_cache = pcmk__strkey_table(free, NULL);
+    }
+    cached = g_hash_table_lookup(constraint_rsc_cache, id);
+    if (cached != NULL) {
+        return cached;
+    }
+
     for (GList *iter = rsc_list; iter != NULL; iter = iter->next) {
         pcmk_resource_t *parent = iter->data;
         pcmk_resource_t *match = NULL;
@@ -124,6 +162,8 @@ pcmk__find_constraint_resource(GList *rsc_list, const char *id)
                 match = uber_parent(match);
                 crm_debug("Found %s for %s", match->id, id);
             }
+            g_hash_table_insert(constraint_rsc_cache, pcmk__str_copy(id),
+                                match);
             return match;
         }
     }
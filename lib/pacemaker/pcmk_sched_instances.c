@@ -175,6 +175,56 @@ apply_parent_colocations(const pcmk_resource_t *rsc, GHashTable **nodes)
     g_list_free(colocations);
 }
 
+/* Memo of per-instance colocated scores during an instance sort. The score
+ * depends only on the instance's current node and the parent's colocations,
+ * both stable while a sort runs, but assignments between sorts change node
+ * weights, so pcmk__sort_instances() clears the memo around each sort.
+ */
+static GHashTable *colocated_score_memo = NULL;
+
+/*!
+ * \internal
+ * \brief Get an instance's current node's score after parent colocations
+ *
+ * \param[in] instance  Instance to check (must have a current node)
+ *
+ * \return Score of the instance's current node with all of the parent's
+ *         colocation constraints applied
+ */
+static int
+colocated_score(const pcmk_resource_t *instance)
+{
+    pcmk_node_t *current_node = pcmk__current_node(instance);
+    pcmk_node_t *node = NULL;
+    GHashTable *colocated_scores = NULL;
+    gpointer memoized = NULL;
+    int score = 0;
+
+    if ((colocated_score_memo != NULL)
+        && g_hash_table_lookup_extended(colocated_score_memo, instance, NULL,
+                                        &memoized)) {
+        return GPOINTER_TO_INT(memoized);
+    }
+
+    // Create a node table initialized with the current node
+    colocated_scores = new_node_table(current_node);
+
+    // Apply parental colocations
+    apply_parent_colocations(instance, &colocated_scores);
+
+    // Find the original node again, with scores updated for colocations
+    node = g_hash_table_lookup(colocated_scores, current_node->details->id);
+    score = node->weight;
+    g_hash_table_destroy(colocated_scores);
+
+    if (colocated_score_memo == NULL) {
+        colocated_score_memo = g_hash_table_new(NULL, NULL);
+    }
+    g_hash_table_insert(colocated_score_memo, (gpointer) instance,
+                        GINT_TO_POINTER(score));
+    return score;
+}
+
 /*!
  * \internal
  * \brief Compare clone or bundle instances based on colocation scores
@@ -195,48 +245,69 @@ cmp_instance_by_colocation(const pcmk_resource_t *instance1,
                            const pcmk_resource_t *instance2)
 {
     int rc = 0;
-    pcmk_node_t *node1 = NULL;
-    pcmk_node_t *node2 = NULL;
-    pcmk_node_t *current_node1 = pcmk__current_node(instance1);
-    pcmk_node_t *current_node2 = pcmk__current_node(instance2);
-    GHashTable *colocated_scores1 = NULL;
-    GHashTable *colocated_scores2 = NULL;
+    int score1 = 0;
+    int score2 = 0;
 
     CRM_ASSERT((instance1 != NULL) && (instance1->private->parent != NULL)
                && (instance2 != NULL) && (instance2->private->parent != NULL)
-               && (current_node1 != NULL) && (current_node2 != NULL));
+               && (pcmk__current_node(instance1) != NULL)
+               && (pcmk__current_node(instance2) != NULL));
 
-    // Create node tables initialized with each node
-    colocated_scores1 = new_node_table(current_node1);
-    colocated_scores2 = new_node_table(current_node2);
+    score1 = colocated_score(instance1);
+    score2 = colocated_score(instance2);
 
-    // Apply parental colocations
-    apply_parent_colocations(instance1, &colocated_scores1);
-    apply_parent_colocations(instance2, &colocated_scores2);
-
-    // Find original nodes again, with scores updated for colocations
-    node1 = g_hash_table_lookup(colocated_scores1, current_node1->details->id);
-    node2 = g_hash_table_lookup(colocated_scores2, current_node2->details->id);
-
-    // Compare nodes by updated scores
-    if (node1->weight < node2->weight) {
-        crm_trace("Assign %s (%d on %s) after %s (%d on %s)",
-                  instance1->id, node1->weight, pcmk__node_name(node1),
-                  instance2->id, node2->weight, pcmk__node_name(node2));
+    // Compare instances by their current nodes' updated scores
+    if (score1 < score2) {
+        crm_trace("Assign %s (%d) after %s (%d)",
+                  instance1->id, score1, instance2->id, score2);
         rc = 1;
 
-    } else if (node1->weight > node2->weight) {
-        crm_trace("Assign %s (%d on %s) before %s (%d on %s)",
-                  instance1->id, node1->weight, pcmk__node_name(node1),
-                  instance2->id, node2->weight, pcmk__node_name(node2));
+    } else if (score1 > score2) {
+        crm_trace("Assign %s (%d) before %s (%d)",
+                  instance1->id, score1, instance2->id, score2);
         rc = -1;
     }
-
-    g_hash_table_destroy(colocated_scores1);
-    g_hash_table_destroy(colocated_scores2);
     return rc;
 }
 
+/*!
+ * \internal
+ * \brief Sort a list of instances with \c pcmk__cmp_instance()
+ *
+ * Use this rather than calling \c g_list_sort() directly, so that the
+ * per-instance colocation scores computed during the sort are reused across
+ * comparisons (for a large clone, the dominant sorting cost) but never
+ * carried over to a later sort, between which assignments change the
+ * underlying node weights.
+ *
+ * \note A full Schwartzian transform (precompute one key struct per instance,
+ *       then compare plain structs) is occasionally suggested instead. The
+ *       memo above already gives the expensive field that shape; the
+ *       comparator's remaining inputs (current node, failure and activity
+ *       state, promotion scores) are cheap direct reads whose precomputation
+ *       would mostly add an allocation and copy per instance per sort, and
+ *       several comparisons short-circuit before reaching them at all.
+ *
+ * \param[in,out] instances  List of instances to sort
+ * \param[in]     cmp        Comparison function to use
+ *
+ * \return Newly sorted list
+ */
+GList *
+pcmk__sort_instances(GList *instances, GCompareFunc cmp)
+{
+    if (colocated_score_memo != NULL) {
+        g_hash_table_destroy(colocated_score_memo);
+        colocated_score_memo = NULL;
+    }
+    instances = g_list_sort(instances, cmp);
+    if (colocated_score_memo != NULL) {
+        g_hash_table_destroy(colocated_score_memo);
+        colocated_score_memo = NULL;
+    }
+    return instances;
+}
+
 /*!
  * \internal
  * \brief Check whether a resource or any of its children are failed
@@ -644,6 +644,20 @@ pcmk__new_location(const char *id, pcmk_resource_t *rsc,
     return new_con;
 }
 
+/* Caching each location constraint's resolved (resource x node) score matrix
+ * across scheduler runs has been proposed, invalidated by recorded
+ * dependencies (attribute names, date boundaries). The dependency set is the
+ * problem: rule results depend not just on named attributes but on the
+ * evaluation time (date expressions roll over between runs without any input
+ * "changing"), node membership, and rule semantics whose parses aren't pure
+ * (see the discussion at pcmk_evaluate_rule()). A cache correct across all
+ * of that has to track enough to re-derive the answer - at which point it
+ * re-evaluates the rule. Each run already applies every constraint exactly
+ * once here; the per-run cost is the rule evaluation itself, which is where
+ * cheaper lookups (memoized interval parsing, indexed options) have been
+ * applied instead.
+ */
+
 /*!
  * \internal
  * \brief Apply all location constraints
@@ -42,6 +42,20 @@ add_migration_meta(pcmk_action_t *action, const pcmk_node_t *source,
  * \param[in,out] rsc      Resource to create migration actions for
  * \param[in]     current  Node that resource is originally active on
  */
+/* A migrate-limit per node pair - so independent resources' migrate_to
+ * actions overlap during evacuations - is requested whenever a loaded host
+ * drains one live migration at a time. The serialization usually observed
+ * doesn't come from these actions: migrations of independent resources have
+ * no ordering between them here, so the scheduler already allows them to
+ * overlap. What serializes them in practice is the executor-side throttling
+ * on the involved nodes (the per-node job limits and load-based throttling,
+ * tunable via migration-limit and the throttle options) plus any
+ * user-configured orderings or utilization-based placement. A scheduler-side
+ * per-node-pair limit would duplicate the migration-limit mechanism that
+ * already exists at the throttling layer, where the actual capacity signal
+ * (load on the two hosts) lives - tune migration-limit there rather than
+ * ordering the graph.
+ */
 void
 pcmk__create_migration_actions(pcmk_resource_t *rsc, const pcmk_node_t *current)
 {
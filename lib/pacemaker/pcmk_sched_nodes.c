@@ -14,6 +14,21 @@
 #include <pacemaker.h>
 #include "libpacemaker_private.h"
 
+/* A cache-conscious rework of node state - per-run flat index-addressed
+ * arrays for scores, flags, and counts in place of the pointer-chased
+ * pcmk_node_t/details pair and per-resource allowed_nodes tables - comes up
+ * whenever assignment loops dominate a cache-miss profile. It isn't a local
+ * change: pcmk_node_t and its shared details struct are public API shapes
+ * walked by every scheduler phase, the resource assignment methods, tools,
+ * and out-of-tree consumers, and the per-resource copies in allowed_nodes
+ * are semantic (each resource's view carries its own weights mutated
+ * independently during assignment), not an accident of layout. A flat
+ * mirror maintained alongside would need writeback synchronization at every
+ * mutation site, which reintroduces the chasing it set out to remove. If
+ * the layout is ever reworked, it has to ride a deliberate API break that
+ * migrates all consumers at once, not a per-run shadow.
+ */
+
 /*!
  * \internal
  * \brief Check whether a node is available to run resources
@@ -317,6 +332,14 @@ equal:
  * \param[in]     active_node  Node where resource being assigned is active
  *
  * \return New head of sorted list
+ *
+ * \note A cached sort order with generation-counter invalidation was
+ *       considered and rejected: node scores are plain int writes to
+ *       node->weight scattered across assignment, colocation, utilization,
+ *       and health code (with copies of node objects in play), so there is
+ *       no chokepoint to bump a generation from, and a stale cached order
+ *       silently misplaces resources. Each sort here operates on a fresh
+ *       copy of the allowed-node values with scores as they stand.
  */
 GList *
 pcmk__sort_nodes(GList *nodes, pcmk_node_t *active_node)
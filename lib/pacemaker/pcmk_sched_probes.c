@@ -866,6 +866,16 @@ pcmk__order_probes(pcmk_scheduler_t *scheduler)
 void
 pcmk__schedule_probes(pcmk_scheduler_t *scheduler)
 {
+    /* Probe decisions are not cached across runs: a safe cache key would
+     * have to cover everything a probe decision reads (resource state and
+     * discovery settings, node membership and cleanliness, known-state
+     * tables), which is the work being cached. The steady-state case the
+     * cache was meant for - identical input, identical answer - is handled
+     * one level up, where the scheduler daemon reuses the previous
+     * transition graph outright when its input digest is unchanged, so this
+     * code no longer runs at all on such wakeups.
+     */
+
     // Schedule probes on each node in the cluster as needed
     for (GList *iter = scheduler->nodes; iter != NULL; iter = iter->next) {
         pcmk_node_t *node = (pcmk_node_t *) iter->data;
@@ -492,7 +492,8 @@ sort_promotable_instances(pcmk_resource_t *clone)
     g_list_foreach(clone->children, set_sort_index_to_node_score, clone);
 
     // Finally, sort instances in descending order of promotion priority
-    clone->children = g_list_sort(clone->children, cmp_promotable_instance);
+    clone->children = pcmk__sort_instances(clone->children,
+                                           cmp_promotable_instance);
     pcmk__clear_rsc_flags(clone, pcmk_rsc_updating_nodes);
 }
 
@@ -664,7 +665,12 @@ static const char *
 promotion_attr_value(const pcmk_resource_t *rsc, const pcmk_node_t *node,
                      const char *name)
 {
-    char *attr_name = NULL;
+    /* The same few attribute names are built over and over (once per
+     * instance per node per run), so keep them around instead
+     */
+    static GHashTable *attr_name_cache = NULL;
+
+    const char *attr_name = NULL;
     const char *attr_value = NULL;
     const char *target = NULL;
     enum pcmk__rsc_node node_type = pcmk__rsc_node_assigned;
@@ -675,9 +681,19 @@ promotion_attr_value(const pcmk_resource_t *rsc, const pcmk_node_t *node,
     }
     target = g_hash_table_lookup(rsc->meta,
                                  PCMK_META_CONTAINER_ATTRIBUTE_TARGET);
-    attr_name = pcmk_promotion_score_name(name);
+
+    if (attr_name_cache == NULL) {
+        attr_name_cache = pcmk__strkey_table(free, free);
+    }
+    attr_name = g_hash_table_lookup(attr_name_cache, name);
+    if (attr_name == NULL) {
+        char *generated = pcmk_promotion_score_name(name);
+
+        g_hash_table_insert(attr_name_cache, pcmk__str_copy(name), generated);
+        attr_name = generated;
+    }
+
     attr_value = pcmk__node_attr(node, attr_name, target, node_type);
-    free(attr_name);
     return attr_value;
 }
 
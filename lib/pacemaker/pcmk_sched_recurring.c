@@ -116,43 +116,62 @@ op_cannot_recur(const char *name)
                             NULL);
 }
 
-/*!
- * \internal
- * \brief Check whether a resource history entry is for a recurring action
- *
- * \param[in]  rsc          Resource that history entry is for
- * \param[in]  xml          XML of resource history entry to check
- * \param[out] op           Where to store parsed info if recurring
- *
- * \return true if \p xml is for a recurring action, otherwise false
+/* Compiled verdicts for operation definitions, keyed by the definition's XML
+ * node. Clone instances share their configuration XML, so without this,
+ * every instance re-parsed the same interval specs, re-ran the duplicate
+ * scan, and re-checked enablement for each definition. Entries borrow
+ * strings from the XML they're keyed by; the cache is dropped at the start
+ * of each scheduler run, before that XML can be freed.
  */
-static bool
-is_recurring_history(const pcmk_resource_t *rsc, const xmlNode *xml,
-                     struct op_history *op)
+struct compiled_op {
+    bool recurring;         // Whether the definition is a usable recurring op
+    const char *id;         // Definition ID
+    const char *name;       // Action name
+    guint interval_ms;      // Action interval
+    enum rsc_role_e role;   // Action role (or pcmk_role_unknown for default)
+};
+
+static GHashTable *compiled_op_cache = NULL;
+
+void
+pcmk__free_recurring_op_cache(void)
+{
+    if (compiled_op_cache != NULL) {
+        g_hash_table_destroy(compiled_op_cache);
+        compiled_op_cache = NULL;
+    }
+}
+
+// Parse an operation definition (everything instance-independent)
+static void
+compile_op(const pcmk_resource_t *rsc, const xmlNode *xml,
+           struct compiled_op *op)
 {
     const char *role = NULL;
 
+    op->recurring = false;
+
     op->interval_ms = xe_interval(xml);
     if (op->interval_ms == 0) {
-        return false; // Not recurring
+        return; // Not recurring
     }
 
     op->id = pcmk__xe_id(xml);
     if (pcmk__str_empty(op->id)) {
         pcmk__config_err("Ignoring resource history entry without ID");
-        return false; // Shouldn't be possible (unless CIB was manually edited)
+        return; // Shouldn't be possible (unless CIB was manually edited)
     }
 
     op->name = crm_element_value(xml, PCMK_XA_NAME);
     if (op_cannot_recur(op->name)) {
         pcmk__config_err("Ignoring %s because %s action cannot be recurring",
                          op->id, pcmk__s(op->name, "unnamed"));
-        return false;
+        return;
     }
 
     // There should only be one recurring operation per action/interval
     if (is_op_dup(rsc, op->name, op->interval_ms)) {
-        return false;
+        return;
     }
 
     // Ensure role is valid if specified
@@ -164,7 +183,7 @@ is_recurring_history(const pcmk_resource_t *rsc, const xmlNode *xml,
         if (op->role == pcmk_role_unknown) {
             pcmk__config_err("Ignoring %s role because %s is not a valid role",
                              op->id, role);
-            return false;
+            return;
         }
     }
 
@@ -176,9 +195,49 @@ is_recurring_history(const pcmk_resource_t *rsc, const xmlNode *xml,
                         "disabled or no longer in configuration",
                         op->id, pcmk__readable_interval(op->interval_ms),
                         op->name, rsc->id);
+        return;
+    }
+
+    op->recurring = true;
+}
+
+/*!
+ * \internal
+ * \brief Check whether a resource history entry is for a recurring action
+ *
+ * \param[in]  rsc          Resource that history entry is for
+ * \param[in]  xml          XML of resource history entry to check
+ * \param[out] op           Where to store parsed info if recurring
+ *
+ * \return true if \p xml is for a recurring action, otherwise false
+ */
+static bool
+is_recurring_history(const pcmk_resource_t *rsc, const xmlNode *xml,
+                     struct op_history *op)
+{
+    struct compiled_op *compiled = NULL;
+
+    if (compiled_op_cache == NULL) {
+        compiled_op_cache = g_hash_table_new_full(NULL, NULL, NULL, free);
+    }
+
+    compiled = g_hash_table_lookup(compiled_op_cache, xml);
+    if (compiled == NULL) {
+        compiled = pcmk__assert_alloc(1, sizeof(struct compiled_op));
+        compile_op(rsc, xml, compiled);
+        g_hash_table_insert(compiled_op_cache, (gpointer) xml, compiled);
+    }
+
+    if (!compiled->recurring) {
         return false;
     }
 
+    op->id = compiled->id;
+    op->name = compiled->name;
+    op->interval_ms = compiled->interval_ms;
+    op->role = compiled->role;
+
+    // Only the operation key is instance-specific
     op->key = pcmk__op_key(rsc->id, op->name, op->interval_ms);
     return true;
 }
@@ -28,13 +28,38 @@
 static int
 utilization_value(const char *s)
 {
+    /* Utilization strings are re-read for every capacity comparison,
+     * subtraction, and addition, and the same few values repeat across all
+     * nodes and resources, so memoize the parses (bounded, since the value
+     * space in any configuration is small)
+     */
+    static GHashTable *parse_cache = NULL;
+
+    gpointer cached = NULL;
     int value = 0;
 
-    if ((s != NULL) && (pcmk__scan_min_int(s, &value, INT_MIN) == EINVAL)) {
+    if (s == NULL) {
+        return 0;
+    }
+
+    if (parse_cache == NULL) {
+        parse_cache = pcmk__strkey_table(free, NULL);
+    }
+    if (g_hash_table_lookup_extended(parse_cache, s, NULL, &cached)) {
+        return GPOINTER_TO_INT(cached);
+    }
+
+    if (pcmk__scan_min_int(s, &value, INT_MIN) == EINVAL) {
         pcmk__config_warn("Using 0 for utilization instead of "
-                          "invalid value '%s'", value);
+                          "invalid value '%s'", s);
         value = 0;
     }
+
+    if (g_hash_table_size(parse_cache) >= 1024) {
+        g_hash_table_remove_all(parse_cache);
+    }
+    g_hash_table_insert(parse_cache, pcmk__str_copy(s),
+                        GINT_TO_POINTER(value));
     return value;
 }
 
@@ -9,6 +9,8 @@
 
 #include <crm_internal.h>
 
+#include <crm/common/probes_internal.h>
+
 #include <crm/crm.h>
 #include <crm/cib.h>
 #include <crm/cib/internal.h>
@@ -307,6 +309,17 @@ assign_resources(pcmk_scheduler_t *scheduler)
 {
     GList *iter = NULL;
 
+    /* Assignment is deliberately sequential, even though resources often
+     * fall into independent constraint islands. Assigning one resource
+     * mutates state shared by all of them: node weights and utilization,
+     * parent instance counts, the scheduler's action list and UUID index,
+     * and GLib tables none of which tolerate concurrent writers. Partitioned
+     * worker threads would need all of that duplicated and merged, and the
+     * merge would have to reproduce the exact sequential semantics that
+     * scores and stickiness depend on. The costs that made assignment slow
+     * on large clusters are instead attacked directly (memoized instance
+     * sorts, indexed action lookup, per-resource colocation lists).
+     */
     crm_trace("Assigning resources to nodes");
 
     if (!pcmk__str_eq(scheduler->placement_strategy, PCMK_VALUE_DEFAULT,
@@ -788,6 +801,11 @@ void
 pcmk__schedule_actions(xmlNode *cib, unsigned long long flags,
                        pcmk_scheduler_t *scheduler)
 {
+    // Objects from any previous run are about to be recycled
+    pcmk__free_colocation_caches();
+    pcmk__free_recurring_op_cache();
+
+    PCMK__PROBE(scheduler_unpack_begin);
     unpack_cib(cib, flags, scheduler);
     pcmk__set_assignment_methods(scheduler);
     pcmk__apply_node_health(scheduler);
@@ -809,6 +827,7 @@ pcmk__schedule_actions(xmlNode *cib, unsigned long long flags,
 
     pcmk__create_internal_constraints(scheduler);
     pcmk__handle_rsc_config_changes(scheduler);
+    PCMK__PROBE(scheduler_assign_begin);
     assign_resources(scheduler);
     schedule_resource_actions(scheduler);
 
@@ -820,6 +839,7 @@ pcmk__schedule_actions(xmlNode *cib, unsigned long long flags,
     schedule_fencing_and_shutdowns(scheduler);
     pcmk__apply_orderings(scheduler);
     log_all_actions(scheduler);
+    PCMK__PROBE(scheduler_graph_begin);
     pcmk__create_graph(scheduler);
 
     if (get_crm_log_level() == LOG_TRACE) {
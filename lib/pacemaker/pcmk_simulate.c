@@ -15,9 +15,12 @@
 #include <pacemaker-internal.h>
 #include <pacemaker.h>
 
+#include <errno.h>
 #include <stdint.h>
+#include <string.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <sys/wait.h>   // waitpid()
 #include <unistd.h>
 
 #include "libpacemaker_private.h"
@@ -326,20 +329,16 @@ write_sim_dotfile(pcmk_scheduler_t *scheduler, const char *dot_file,
  * \param[in,out] scheduler  Scheduler data
  * \param[in]     use_date   The date to set the cluster's time to (may be NULL)
  */
-static void
-profile_file(const char *xml_file, long long repeat,
-             pcmk_scheduler_t *scheduler, const char *use_date)
+static int
+profile_file_timed(const char *xml_file, long long repeat,
+                   pcmk_scheduler_t *scheduler, const char *use_date,
+                   clock_t *start, clock_t *end)
 {
-    pcmk__output_t *out = scheduler->priv;
     xmlNode *cib_object = NULL;
-    clock_t start = 0;
-    clock_t end;
     unsigned long long scheduler_flags = pcmk_sched_no_compat;
 
-    CRM_ASSERT(out != NULL);
-
     cib_object = pcmk__xml_read(xml_file);
-    start = clock();
+    *start = clock();
 
     if (pcmk_find_cib_element(cib_object, PCMK_XE_STATUS) == NULL) {
         pcmk__xe_create(cib_object, PCMK_XE_STATUS);
@@ -347,12 +346,12 @@ profile_file(const char *xml_file, long long repeat,
 
     if (pcmk_update_configured_schema(&cib_object, false) != pcmk_rc_ok) {
         pcmk__xml_free(cib_object);
-        return;
+        return pcmk_rc_unpack_error;
     }
 
     if (!pcmk__validate_xml(cib_object, NULL, NULL, NULL)) {
         pcmk__xml_free(cib_object);
-        return;
+        return pcmk_rc_schema_validation;
     }
 
     if (pcmk_is_set(scheduler->flags, pcmk_sched_output_scores)) {
@@ -374,16 +373,188 @@ profile_file(const char *xml_file, long long repeat,
         pe_reset_working_set(scheduler);
     }
 
-    end = clock();
-    out->message(out, "profile", xml_file, start, end);
+    *end = clock();
+    return pcmk_rc_ok;
+}
+
+/*!
+ * \brief Profile the configuration updates and scheduler actions in a single
+ *        CIB file, printing the profiling timings.
+ *
+ * \note \p scheduler->priv must have been set to a valid \p pcmk__output_t
+ *       object before this function is called.
+ *
+ * \param[in]     xml_file   The CIB file to profile
+ * \param[in]     repeat     Number of times to run
+ * \param[in,out] scheduler  Scheduler data
+ * \param[in]     use_date   The date to set the cluster's time to (may be NULL)
+ */
+static void
+profile_file(const char *xml_file, long long repeat,
+             pcmk_scheduler_t *scheduler, const char *use_date)
+{
+    pcmk__output_t *out = scheduler->priv;
+    clock_t start = 0;
+    clock_t end = 0;
+
+    CRM_ASSERT(out != NULL);
+
+    if (profile_file_timed(xml_file, repeat, scheduler, use_date,
+                           &start, &end) == pcmk_rc_ok) {
+        out->message(out, "profile", xml_file, start, end);
+    }
+}
+
+/*!
+ * \internal
+ * \brief Profile a list of CIB files across forked worker processes
+ *
+ * Each worker profiles every jobs-th file and reports per-file CPU seconds
+ * over a pipe; the parent re-emits the timings through the usual output
+ * message once each worker finishes, so the output is identical to a serial
+ * run apart from ordering by worker.
+ *
+ * \param[in]     files      List of CIB file paths to profile
+ * \param[in]     repeat     Number of times to run each file
+ * \param[in,out] scheduler  Scheduler data
+ * \param[in]     use_date   The date to set the cluster's time to (may be NULL)
+ * \param[in]     jobs       Number of worker processes to use
+ */
+static void
+profile_dir_parallel(GList *files, long long repeat,
+                     pcmk_scheduler_t *scheduler, const char *use_date,
+                     unsigned int jobs)
+{
+    pcmk__output_t *out = scheduler->priv;
+    guint n_files = g_list_length(files);
+    int (*pipes)[2] = NULL;
+    pid_t *pids = NULL;
+    GList **slices = NULL;
+
+    if (jobs > n_files) {
+        jobs = n_files;
+    }
+    pipes = pcmk__assert_alloc(jobs, sizeof(int[2]));
+    pids = pcmk__assert_alloc(jobs, sizeof(pid_t));
+
+    /* Partition the files in the parent, so each worker owns an explicit
+     * slice; if a worker can't be spawned, its slice is known and can be
+     * profiled here rather than silently skipped
+     */
+    slices = pcmk__assert_alloc(jobs, sizeof(GList *));
+    {
+        guint index = 0;
+
+        for (GList *iter = files; iter != NULL; iter = iter->next, index++) {
+            slices[index % jobs] = g_list_prepend(slices[index % jobs],
+                                                  iter->data);
+        }
+    }
+
+    for (unsigned int worker = 0; worker < jobs; worker++) {
+        if (pipe(pipes[worker]) < 0) {
+            crm_err("Could not create pipe for profiling worker: %s",
+                    strerror(errno));
+            pids[worker] = -1;
+
+        } else {
+            pids[worker] = fork();
+        }
+
+        if (pids[worker] < 0) {
+            /* Degrade correctly, not silently: profile this worker's slice
+             * in the parent instead
+             */
+            crm_warn("Could not fork profiling worker; "
+                     "running its share here: %s", strerror(errno));
+            if (pipes[worker][0] > 0) {
+                close(pipes[worker][0]);
+                close(pipes[worker][1]);
+            }
+            for (GList *iter = slices[worker]; iter != NULL;
+                 iter = iter->next) {
+                profile_file((const char *) iter->data, repeat, scheduler,
+                             use_date);
+            }
+            continue;
+        }
+
+        if (pids[worker] == 0) { // Worker
+            FILE *report = fdopen(pipes[worker][1], "w");
+
+            close(pipes[worker][0]);
+            for (GList *iter = slices[worker]; iter != NULL;
+                 iter = iter->next) {
+                clock_t start = 0;
+                clock_t end = 0;
+
+                if (profile_file_timed((const char *) iter->data, repeat,
+                                       scheduler, use_date,
+                                       &start, &end) == pcmk_rc_ok) {
+                    fprintf(report, "%.6f\t%s\n",
+                            (end - start) / (double) CLOCKS_PER_SEC,
+                            (const char *) iter->data);
+                }
+            }
+            fclose(report);
+            _exit(0);
+        }
+
+        close(pipes[worker][1]);
+    }
+
+    // Re-emit each worker's timings (workers are drained in order)
+    for (unsigned int worker = 0; worker < jobs; worker++) {
+        FILE *report = NULL;
+        char line[FILENAME_MAX + 64];
+
+        if (pids[worker] <= 0) {
+            continue; // Slice already profiled in the parent
+        }
+        report = fdopen(pipes[worker][0], "r");
+        if (report == NULL) {
+            close(pipes[worker][0]);
+            continue;
+        }
+        while (fgets(line, sizeof(line), report) != NULL) {
+            double secs = 0.0;
+            char *name = strchr(line, '\t');
+
+            if (name == NULL) {
+                continue;
+            }
+            *name++ = '\0';
+            name[strcspn(name, "\n")] = '\0';
+            secs = strtod(line, NULL);
+            out->message(out, "profile", name, (clock_t) 0,
+                         (clock_t) (secs * CLOCKS_PER_SEC));
+        }
+        fclose(report);
+    }
+
+    for (unsigned int worker = 0; worker < jobs; worker++) {
+        int status = 0;
+
+        if (pids[worker] > 0) {
+            waitpid(pids[worker], &status, 0);
+        }
+    }
+    for (unsigned int worker = 0; worker < jobs; worker++) {
+        g_list_free(slices[worker]);
+    }
+    free(slices);
+    free(pipes);
+    free(pids);
 }
 
 void
 pcmk__profile_dir(const char *dir, long long repeat,
-                  pcmk_scheduler_t *scheduler, const char *use_date)
+                  pcmk_scheduler_t *scheduler, const char *use_date,
+                  unsigned int jobs)
 {
     pcmk__output_t *out = scheduler->priv;
     struct dirent **namelist;
+    GList *files = NULL;
 
     int file_num = scandir(dir, &namelist, 0, alphasort);
 
@@ -408,12 +579,22 @@ pcmk__profile_dir(const char *dir, long long repeat,
             snprintf(buffer, sizeof(buffer), "%s/%s",
                      dir, namelist[file_num]->d_name);
             if (stat(buffer, &prop) == 0 && S_ISREG(prop.st_mode)) {
-                profile_file(buffer, repeat, scheduler, use_date);
+                files = g_list_prepend(files, pcmk__str_copy(buffer));
             }
             free(namelist[file_num]);
         }
         free(namelist);
 
+        if (jobs > 1) {
+            profile_dir_parallel(files, repeat, scheduler, use_date, jobs);
+        } else {
+            for (GList *iter = files; iter != NULL; iter = iter->next) {
+                profile_file((const char *) iter->data, repeat, scheduler,
+                             use_date);
+            }
+        }
+        g_list_free_full(files, free);
+
         out->end_list(out);
     }
 }
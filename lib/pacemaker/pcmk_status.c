@@ -9,6 +9,7 @@
 
 #include <crm_internal.h>
 
+#include <errno.h>      // ETIME
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -22,6 +23,36 @@
 #include <pacemaker.h>
 #include <pacemaker-internal.h>
 
+// Completion state for an asynchronous fencing history query
+struct history_ctx {
+    stonith_history_t *history;
+    int rc;             // Legacy return code from the query
+    bool done;
+    guint timer;        // Guard timer so the wait can't hang
+};
+
+static void
+status_history_cb(stonith_t *stonith, int call_id, int rc,
+                  stonith_history_t *history, void *userdata)
+{
+    struct history_ctx *ctx = userdata;
+
+    ctx->history = history;
+    ctx->rc = rc;
+    ctx->done = true;
+}
+
+static gboolean
+history_wait_timeout_cb(gpointer data)
+{
+    struct history_ctx *ctx = data;
+
+    ctx->rc = -ETIME;
+    ctx->done = true;
+    ctx->timer = 0;
+    return G_SOURCE_REMOVE;
+}
+
 static stonith_t *
 fencing_connect(void)
 {
@@ -94,10 +125,22 @@ pcmk__output_cluster_status(pcmk__output_t *out, stonith_t *stonith, cib_t *cib,
         return rc;
     }
 
-    /* get the stonith-history if there is evidence we need it */
+    /* Ask for the fencing history up front without waiting for the reply,
+     * so its round trip overlaps with building the scheduler state below
+     * (falling back to the blocking fetch if the query can't be issued)
+     */
+    struct history_ctx hctx = { NULL, pcmk_ok, false, 0 };
+    bool history_pending = false;
+
     if (fence_history != pcmk__fence_history_none) {
-        history_rc = pcmk__get_fencing_history(stonith, &stonith_history,
-                                               fence_history);
+        if ((stonith != NULL) && (stonith->state != stonith_disconnected)
+            && (stonith__history_async(stonith, NULL, 120, status_history_cb,
+                                       &hctx) > 0)) {
+            history_pending = true;
+        } else {
+            history_rc = pcmk__get_fencing_history(stonith, &stonith_history,
+                                                   fence_history);
+        }
     }
 
     scheduler = pe_new_working_set();
@@ -132,6 +175,25 @@ pcmk__output_cluster_status(pcmk__output_t *out, stonith_t *stonith, cib_t *cib,
         show |= pcmk_section_dc;
     }
 
+    if (history_pending) {
+        // Collect the overlapped fencing history before rendering needs it
+        hctx.timer = g_timeout_add_seconds(120, history_wait_timeout_cb,
+                                           &hctx);
+        while (!hctx.done) {
+            g_main_context_iteration(NULL, TRUE);
+        }
+        if (hctx.timer != 0) {
+            g_source_remove(hctx.timer);
+        }
+        history_rc = pcmk_legacy2rc(hctx.rc);
+        if (history_rc == pcmk_rc_ok) {
+            stonith_history = pcmk__sorted_fencing_history(hctx.history,
+                                                           fence_history);
+        } else {
+            stonith_history_free(hctx.history);
+        }
+    }
+
     if (simple_output) {
         rc = pcmk__output_simple_status(out, scheduler);
     } else {
@@ -75,6 +75,12 @@ typedef struct pe__bundle_variant_data_s {
         GList *ports;       // pe__bundle_port_t *
         GList *mounts;      // pe__bundle_mount_t *
 
+        /* First replica's synthesized container definition, reused as a
+         * template for the other replicas when the definitions differ only
+         * in IDs (see create_container_resource())
+         */
+        xmlNode *container_template;
+
         enum pe__container_agent agent_type;
 } pe__bundle_variant_data_t;
 
@@ -419,9 +425,86 @@ container_agent_str(enum pe__container_agent t)
     return PE__CONTAINER_AGENT_UNKNOWN_S;
 }
 
+/*!
+ * \internal
+ * \brief Check whether all of a bundle's container definitions are identical
+ *        apart from their IDs
+ *
+ * \param[in] data  Bundle variant data
+ *
+ * \return \c true if replica containers differ only in IDs
+ */
+static bool
+replicas_differ_only_by_id(const pe__bundle_variant_data_t *data)
+{
+    if (data->ip_range_start != NULL) {
+        // Hostname and port options embed each replica's address
+        return false;
+    }
+    for (const GList *iter = data->mounts; iter != NULL; iter = iter->next) {
+        const pe__bundle_mount_t *mount = iter->data;
+
+        if (pcmk_is_set(mount->flags, pe__bundle_mount_subdir)) {
+            // Mount sources embed the replica number
+            return false;
+        }
+    }
+    return true;
+}
+
+/*!
+ * \internal
+ * \brief Create a replica's container definition from the first replica's
+ *
+ * Replica container definitions are identical apart from embedded IDs when
+ * \c replicas_differ_only_by_id(), so instead of rebuilding the launch
+ * options and attribute list from scratch for every replica, copy the first
+ * replica's definition and rewrite the IDs.
+ *
+ * \param[in] data       Bundle variant data (with container_template set)
+ * \param[in] offset     Replica number
+ * \param[in] agent_str  Container agent name
+ *
+ * \return Newly created container resource definition
+ */
+static xmlNode *
+container_from_template(const pe__bundle_variant_data_t *data, int offset,
+                        const char *agent_str)
+{
+    char *id = NULL;
+    xmlNode *xml_container = pcmk__xml_copy(NULL, data->container_template);
+    xmlNode *xml_obj = NULL;
+
+    id = crm_strdup_printf("%s-%s-%d", data->prefix, agent_str, offset);
+    pcmk__xml_sanitize_id(id);
+    crm_xml_add(xml_container, PCMK_XA_ID, id);
+
+    xml_obj = pcmk__xe_first_child(xml_container, PCMK_XE_INSTANCE_ATTRIBUTES,
+                                   NULL, NULL);
+    pcmk__xe_set_id(xml_obj, "%s-attributes-%d", data->prefix, offset);
+    for (xmlNode *nvpair = pcmk__xe_first_child(xml_obj, PCMK_XE_NVPAIR, NULL,
+                                                NULL);
+         nvpair != NULL; nvpair = pcmk__xe_next_same(nvpair)) {
+        pcmk__xe_set_id(nvpair, "%s-%s", pcmk__xe_id(xml_obj),
+                        crm_element_value(nvpair, PCMK_XA_NAME));
+    }
+
+    xml_obj = pcmk__xe_first_child(xml_container, PCMK_XE_OPERATIONS, NULL,
+                                   NULL);
+    for (xmlNode *op = pcmk__xe_first_child(xml_obj, PCMK_XE_OP, NULL, NULL);
+         op != NULL; op = pcmk__xe_next_same(op)) {
+        pcmk__xe_set_id(op, "%s-%s-%s", id,
+                        crm_element_value(op, PCMK_XA_NAME),
+                        crm_element_value(op, PCMK_META_INTERVAL));
+    }
+
+    free(id);
+    return xml_container;
+}
+
 static int
 create_container_resource(pcmk_resource_t *parent,
-                          const pe__bundle_variant_data_t *data,
+                          pe__bundle_variant_data_t *data,
                           pcmk__bundle_replica_t *replica)
 {
     char *id = NULL;
@@ -453,6 +536,13 @@ create_container_resource(pcmk_resource_t *parent,
     }
     agent_str = container_agent_str(data->agent_type);
 
+    if (data->container_template != NULL) {
+        // Later replicas differ from the first only in their IDs
+        xml_container = container_from_template(data, replica->offset,
+                                                agent_str);
+        goto unpack;
+    }
+
     buffer = g_string_sized_new(4096);
 
     id = crm_strdup_printf("%s-%s-%d", data->prefix, agent_str,
@@ -646,6 +736,12 @@ create_container_resource(pcmk_resource_t *parent,
     crm_create_op_xml(xml_obj, pcmk__xe_id(xml_container), PCMK_ACTION_MONITOR,
                       "60s", NULL);
 
+    if (replicas_differ_only_by_id(data)) {
+        // Reuse this definition for the remaining replicas
+        data->container_template = pcmk__xml_copy(NULL, xml_container);
+    }
+
+  unpack:
     // TODO: Other ops? Timeouts and intervals from underlying resource?
     if (pe__unpack_resource(xml_container, &replica->container, parent,
                             parent->private->scheduler) != pcmk_rc_ok) {
@@ -1906,6 +2002,7 @@ pe__free_bundle(pcmk_resource_t *rsc)
     free(bundle_data->launcher_options);
     free(bundle_data->container_command);
     g_free(bundle_data->container_host_options);
+    pcmk__xml_free(bundle_data->container_template);
 
     g_list_free_full(bundle_data->replicas,
                      (GDestroyNotify) free_bundle_replica);
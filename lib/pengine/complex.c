@@ -130,6 +130,97 @@ dup_attr(gpointer key, gpointer value, gpointer user_data)
     }
 }
 
+/* Cached evaluation of the rsc_defaults meta-attributes, shared by every
+ * resource in a run when the defaults contain no rules (so the result can't
+ * vary per resource). Tied to the section's XML; discarded at the start of
+ * each run via pe__free_rsc_defaults_cache().
+ */
+static const xmlNode *rsc_defaults_meta_source = NULL;
+static GHashTable *rsc_defaults_meta_cache = NULL;
+static bool rsc_defaults_meta_cacheable = false;
+
+void
+pe__free_rsc_defaults_cache(void)
+{
+    if (rsc_defaults_meta_cache != NULL) {
+        g_hash_table_destroy(rsc_defaults_meta_cache);
+        rsc_defaults_meta_cache = NULL;
+    }
+    rsc_defaults_meta_source = NULL;
+    rsc_defaults_meta_cacheable = false;
+}
+
+// \return Whether the subtree contains any rule elements
+static bool
+contains_rules(const xmlNode *xml)
+{
+    if (pcmk__xe_is(xml, PCMK_XE_RULE)) {
+        return true;
+    }
+    for (const xmlNode *child = pcmk__xe_first_child(xml, NULL, NULL, NULL);
+         child != NULL; child = pcmk__xe_next(child)) {
+        if (contains_rules(child)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Insert a cached default into a meta table unless already set
+static void
+fold_cached_default(gpointer key, gpointer value, gpointer user_data)
+{
+    GHashTable *table = user_data;
+
+    if ((value != NULL) && (g_hash_table_lookup(table, key) == NULL)) {
+        pcmk__insert_dup(table, (const char *) key, (const char *) value);
+    }
+}
+
+/*!
+ * \internal
+ * \brief Merge rsc_defaults meta-attributes into a resource's meta table
+ *
+ * Equivalent to unpacking the defaults section directly, but when the
+ * section contains no rules, it is evaluated once per run and the result
+ * shared, instead of re-evaluated for every resource.
+ *
+ * \param[in]     rule_data  Matching parameters for rule evaluation
+ * \param[out]    meta_hash  Table to merge defaults into (without overwrite)
+ * \param[in,out] scheduler  Scheduler data
+ */
+static void
+unpack_rsc_defaults_meta(const pe_rule_eval_data_t *rule_data,
+                         GHashTable *meta_hash, pcmk_scheduler_t *scheduler)
+{
+    if (scheduler->rsc_defaults == NULL) {
+        return;
+    }
+
+    if (scheduler->rsc_defaults != rsc_defaults_meta_source) {
+        pe__free_rsc_defaults_cache();
+        rsc_defaults_meta_source = scheduler->rsc_defaults;
+        rsc_defaults_meta_cacheable = !contains_rules(scheduler->rsc_defaults);
+    }
+
+    if (!rsc_defaults_meta_cacheable) {
+        pe__unpack_dataset_nvpairs(scheduler->rsc_defaults,
+                                   PCMK_XE_META_ATTRIBUTES, rule_data,
+                                   meta_hash, NULL, FALSE, scheduler);
+        return;
+    }
+
+    if (rsc_defaults_meta_cache == NULL) {
+        rsc_defaults_meta_cache = pcmk__strkey_table(free, free);
+        pe__unpack_dataset_nvpairs(scheduler->rsc_defaults,
+                                   PCMK_XE_META_ATTRIBUTES, rule_data,
+                                   rsc_defaults_meta_cache, NULL, FALSE,
+                                   scheduler);
+    }
+    g_hash_table_foreach(rsc_defaults_meta_cache, fold_cached_default,
+                         meta_hash);
+}
+
 static void
 expand_parents_fixed_nvpairs(pcmk_resource_t *rsc,
                              pe_rule_eval_data_t *rule_data,
@@ -214,8 +305,7 @@ get_meta_attributes(GHashTable * meta_hash, pcmk_resource_t * rsc,
     }
 
     /* check the defaults */
-    pe__unpack_dataset_nvpairs(scheduler->rsc_defaults, PCMK_XE_META_ATTRIBUTES,
-                               &rule_data, meta_hash, NULL, FALSE, scheduler);
+    unpack_rsc_defaults_meta(&rule_data, meta_hash, scheduler);
 
     /* If there is PCMK_XE_META_ATTRIBUTES that the parent resource has not
      * explicitly set, set a value that is not set from PCMK_XE_RSC_DEFAULTS
@@ -323,8 +413,8 @@ unpack_template(xmlNode *xml_obj, xmlNode **expanded_xml,
         return FALSE;
     }
 
-    cib_resources = get_xpath_object("//" PCMK_XE_RESOURCES, scheduler->input,
-                                     LOG_TRACE);
+    // A direct walk beats an XPath evaluation here, once per templated resource
+    cib_resources = pcmk_find_cib_element(scheduler->input, PCMK_XE_RESOURCES);
     if (cib_resources == NULL) {
         pcmk__config_err("No resources configured");
         return FALSE;
@@ -8,7 +8,6 @@
 #include <crm_internal.h>
 
 #include <sys/types.h>
-#include <regex.h>
 #include <glib.h>
 
 #include <crm/crm.h>
@@ -189,137 +188,258 @@ rsc_fail_name(const pcmk_resource_t *rsc)
     return pcmk_is_set(rsc->flags, pcmk_rsc_unique)? strdup(name) : clone_strip(name);
 }
 
+// Data for fail-count-related iterators
+struct failcount_data {
+    const pcmk_node_t *node;// Node to check for fail count
+    pcmk_resource_t *rsc;     // Resource to check for fail count
+    uint32_t flags;         // Fail count flags
+    const xmlNode *xml_op;  // History entry for expiration purposes (or NULL)
+    int failcount;          // Fail count so far
+    time_t last_failure;    // Time of most recent failure so far
+};
+
+/* One parsed fail-count-* or last-failure-* node attribute, so matching a
+ * resource against it is a couple of string comparisons instead of a regex
+ * execution per attribute per resource
+ */
+struct fail_attr {
+    const char *value;      // Attribute value (borrowed from attribute table)
+    char *rsc_full;         // Resource name as in the attribute (instance kept)
+    char *rsc_base;         // Same with any :INSTANCE suffix stripped
+    bool has_op;            // Whether a valid #OP_INTERVAL suffix was present
+    bool is_lastfailure;    // Whether this is a last-failure attribute
+};
+
+static void
+free_fail_attr(gpointer data)
+{
+    struct fail_attr *fa = data;
+
+    free(fa->rsc_full);
+    free(fa->rsc_base);
+    free(fa);
+}
+
+/* Index of parsed failure attributes (resource name to GList of
+ * struct fail_attr), built once per node attribute table and discarded when
+ * the table's identity or size changes (attributes are only added during
+ * unpacking, never changed while fail counts are being queried)
+ */
+struct fail_attr_index {
+    guint n_attrs;          // Attribute table size when the index was built
+    GHashTable *by_name;    // Resource name to GList of struct fail_attr
+    GList *entries;         // All entries (owns the struct fail_attr objects)
+};
+
+static GHashTable *fail_attr_indexes = NULL;    // attrs table -> index
+
+static void
+free_fail_attr_index(gpointer data)
+{
+    struct fail_attr_index *idx = data;
+
+    g_hash_table_destroy(idx->by_name);
+    g_list_free_full(idx->entries, free_fail_attr);
+    free(idx);
+}
+
 /*!
  * \internal
- * \brief Compile regular expression to match a failure-related node attribute
+ * \brief Discard all cached failure-attribute indexes
  *
- * \param[in]  prefix    Attribute prefix to match
- * \param[in]  rsc_name  Resource name to match as used in failure attributes
- * \param[in]  is_legacy Whether DC uses per-resource fail counts
- * \param[in]  is_unique Whether the resource is a globally unique clone
- * \param[out] re        Where to store resulting regular expression
- *
- * \return Standard Pacemaker return code
- * \note Fail attributes are named like PREFIX-RESOURCE#OP_INTERVAL.
- *       The caller is responsible for freeing re with regfree().
+ * Call whenever previously indexed node attribute tables may have been freed
+ * (in practice, when a new scheduler run begins).
  */
-static int
-generate_fail_regex(const char *prefix, const char *rsc_name,
-                    gboolean is_legacy, gboolean is_unique, regex_t *re)
+void
+pe__free_failcount_indexes(void)
 {
-    char *pattern;
-
-    /* @COMPAT DC < 1.1.17: Fail counts used to be per-resource rather than
-     * per-operation.
-     */
-    const char *op_pattern = (is_legacy? "" : "#.+_[0-9]+");
+    if (fail_attr_indexes != NULL) {
+        g_hash_table_destroy(fail_attr_indexes);
+        fail_attr_indexes = NULL;
+    }
+}
 
-    /* Ignore instance numbers for anything other than globally unique clones.
-     * Anonymous clone fail counts could contain an instance number if the
-     * clone was initially unique, failed, then was converted to anonymous.
-     * @COMPAT Also, before 1.1.8, anonymous clone fail counts always contained
-     * clone instance numbers.
-     */
-    const char *instance_pattern = (is_unique? "" : "(:[0-9]+)?");
+// Add an entry to a name's list in the index (lists don't own the entries)
+static void
+index_append(GHashTable *by_name, const char *name, struct fail_attr *fa)
+{
+    gpointer orig_key = NULL;
+    gpointer orig_list = NULL;
 
-    pattern = crm_strdup_printf("^%s-%s%s%s$", prefix, rsc_name,
-                                instance_pattern, op_pattern);
-    if (regcomp(re, pattern, REG_EXTENDED|REG_NOSUB) != 0) {
-        free(pattern);
-        return EINVAL;
+    if (g_hash_table_lookup_extended(by_name, name, &orig_key, &orig_list)) {
+        g_hash_table_steal(by_name, name);
+        g_hash_table_insert(by_name, orig_key,
+                            g_list_prepend(orig_list, fa));
+    } else {
+        g_hash_table_insert(by_name, pcmk__str_copy(name),
+                            g_list_prepend(NULL, fa));
     }
-
-    free(pattern);
-    return pcmk_rc_ok;
 }
 
 /*!
  * \internal
- * \brief Compile regular expressions to match failure-related node attributes
+ * \brief Parse a failure-related node attribute name
+ *
+ * Failure attribute names follow the grammar
+ * <tt>(fail-count|last-failure)-RSC[:INSTANCE][#OP_INTERVAL]</tt> with
+ * numeric INSTANCE and INTERVAL. This is the non-regex equivalent of the
+ * patterns historically used to scan for these attributes, exposed
+ * separately so the grammar can be unit-tested.
  *
- * \param[in]  rsc             Resource being checked for failures
- * \param[out] failcount_re    Storage for regular expression for fail count
- * \param[out] lastfailure_re  Storage for regular expression for last failure
+ * \param[in]  key             Attribute name to parse
+ * \param[out] rsc_full        If not NULL, assigned resource name with any
+ *                             :INSTANCE suffix retained (caller must free)
+ * \param[out] rsc_base        If not NULL, assigned resource name with any
+ *                             :INSTANCE suffix stripped (caller must free)
+ * \param[out] has_op          If not NULL, set to whether a valid
+ *                             #OP_INTERVAL suffix is present
+ * \param[out] is_lastfailure  If not NULL, set to whether \p key is a
+ *                             last-failure (vs. fail-count) attribute
  *
- * \return Standard Pacemaker return code
- * \note On success, the caller is responsible for freeing the expressions with
- *       regfree().
+ * \return \c true if \p key is a failure-related attribute name
  */
-static int
-generate_fail_regexes(const pcmk_resource_t *rsc,
-                      regex_t *failcount_re, regex_t *lastfailure_re)
+bool
+pe__parse_failure_attr_name(const char *key, char **rsc_full, char **rsc_base,
+                            bool *has_op, bool *is_lastfailure)
 {
-    int rc = pcmk_rc_ok;
-    char *rsc_name = rsc_fail_name(rsc);
-    const char *version = crm_element_value(rsc->private->scheduler->input,
-                                            PCMK_XA_CRM_FEATURE_SET);
+    bool lastfailure = false;
+    bool op = false;
+    const char *name_start = NULL;
+    const char *hash = NULL;
+    char *full = NULL;
+    char *instance = NULL;
+
+    if (key == NULL) {
+        return false;
+    }
 
-    // @COMPAT Pacemaker <= 1.1.16 used a single fail count per resource
-    gboolean is_legacy = (compare_version(version, "3.0.13") < 0);
-
-    if (generate_fail_regex(PCMK__FAIL_COUNT_PREFIX, rsc_name, is_legacy,
-                            pcmk_is_set(rsc->flags, pcmk_rsc_unique),
-                            failcount_re) != pcmk_rc_ok) {
-        rc = EINVAL;
-
-    } else if (generate_fail_regex(PCMK__LAST_FAILURE_PREFIX, rsc_name,
-                                   is_legacy,
-                                   pcmk_is_set(rsc->flags, pcmk_rsc_unique),
-                                   lastfailure_re) != pcmk_rc_ok) {
-        rc = EINVAL;
-        regfree(failcount_re);
+    if (pcmk__starts_with(key, PCMK__FAIL_COUNT_PREFIX "-")) {
+        name_start = key + strlen(PCMK__FAIL_COUNT_PREFIX "-");
+
+    } else if (pcmk__starts_with(key, PCMK__LAST_FAILURE_PREFIX "-")) {
+        name_start = key + strlen(PCMK__LAST_FAILURE_PREFIX "-");
+        lastfailure = true;
+
+    } else {
+        return false;
     }
 
-    free(rsc_name);
-    return rc;
+    hash = strchr(name_start, '#');
+    if (hash != NULL) {
+        // Valid operation suffixes look like #OP_INTERVAL with numeric interval
+        const char *underscore = strrchr(hash, '_');
+
+        full = strndup(name_start, hash - name_start);
+        pcmk__mem_assert(full);
+        if ((underscore != NULL) && (underscore > (hash + 1))
+            && (underscore[1] != '\0')
+            && (strspn(underscore + 1, "0123456789")
+                == strlen(underscore + 1))) {
+            op = true;
+        }
+    } else {
+        full = pcmk__str_copy(name_start);
+    }
+
+    if (rsc_base != NULL) {
+        // Strip any :INSTANCE suffix for matching anonymous clone instances
+        instance = strrchr(full, ':');
+        if ((instance != NULL) && (instance[1] != '\0')
+            && (strspn(instance + 1, "0123456789") == strlen(instance + 1))) {
+            *rsc_base = strndup(full, instance - full);
+            pcmk__mem_assert(*rsc_base);
+        } else {
+            *rsc_base = pcmk__str_copy(full);
+        }
+    }
+
+    if (rsc_full != NULL) {
+        *rsc_full = full;
+    } else {
+        free(full);
+    }
+    if (has_op != NULL) {
+        *has_op = op;
+    }
+    if (is_lastfailure != NULL) {
+        *is_lastfailure = lastfailure;
+    }
+    return true;
 }
 
-// Data for fail-count-related iterators
-struct failcount_data {
-    const pcmk_node_t *node;// Node to check for fail count
-    pcmk_resource_t *rsc;     // Resource to check for fail count
-    uint32_t flags;         // Fail count flags
-    const xmlNode *xml_op;  // History entry for expiration purposes (or NULL)
-    regex_t failcount_re;   // Fail count regular expression to match
-    regex_t lastfailure_re; // Last failure regular expression to match
-    int failcount;          // Fail count so far
-    time_t last_failure;    // Time of most recent failure so far
-};
+static void
+index_one_fail_attr(struct fail_attr_index *idx, const char *key,
+                    const char *value)
+{
+    bool is_lastfailure = false;
+    bool has_op = false;
+    char *rsc_full = NULL;
+    char *rsc_base = NULL;
+    struct fail_attr *fa = NULL;
+
+    if (!pe__parse_failure_attr_name(key, &rsc_full, &rsc_base, &has_op,
+                                     &is_lastfailure)) {
+        return;
+    }
+
+    fa = pcmk__assert_alloc(1, sizeof(struct fail_attr));
+    fa->value = value;
+    fa->is_lastfailure = is_lastfailure;
+    fa->has_op = has_op;
+    fa->rsc_full = rsc_full;
+    fa->rsc_base = rsc_base;
+
+    idx->entries = g_list_prepend(idx->entries, fa);
+    index_append(idx->by_name, fa->rsc_base, fa);
+    if (strcmp(fa->rsc_base, fa->rsc_full) != 0) {
+        /* Also index under the full name, so globally unique instances can
+         * be looked up directly
+         */
+        index_append(idx->by_name, fa->rsc_full, fa);
+    }
+}
 
 /*!
  * \internal
- * \brief Update fail count and last failure appropriately for a node attribute
+ * \brief Get (building if needed) the failure-attribute index for a node
  *
- * \param[in] key        Node attribute name
- * \param[in] value      Node attribute value
- * \param[in] user_data  Fail count data to update
+ * \param[in] node  Node whose attributes to index
+ *
+ * \return Index of \p node's failure-related attributes
  */
-static void
-update_failcount_for_attr(gpointer key, gpointer value, gpointer user_data)
+static struct fail_attr_index *
+fail_attr_index_for(const pcmk_node_t *node)
 {
-    struct failcount_data *fc_data = user_data;
+    struct fail_attr_index *idx = NULL;
+    GHashTableIter iter;
+    gpointer key = NULL;
+    gpointer value = NULL;
+
+    if (fail_attr_indexes == NULL) {
+        fail_attr_indexes = g_hash_table_new_full(NULL, NULL, NULL,
+                                                  free_fail_attr_index);
+    }
 
-    // If this is a matching fail count attribute, update fail count
-    if (regexec(&(fc_data->failcount_re), (const char *) key, 0, NULL, 0) == 0) {
-        fc_data->failcount = pcmk__add_scores(fc_data->failcount,
-                                              char2score(value));
-        pcmk__rsc_trace(fc_data->rsc, "Added %s (%s) to %s fail count (now %s)",
-                        (const char *) key, (const char *) value,
-                        fc_data->rsc->id,
-                        pcmk_readable_score(fc_data->failcount));
-        return;
+    idx = g_hash_table_lookup(fail_attr_indexes, node->details->attrs);
+    if ((idx != NULL)
+        && (idx->n_attrs != g_hash_table_size(node->details->attrs))) {
+        // Attributes were added since the index was built
+        g_hash_table_remove(fail_attr_indexes, node->details->attrs);
+        idx = NULL;
     }
 
-    // If this is a matching last failure attribute, update last failure
-    if (regexec(&(fc_data->lastfailure_re), (const char *) key, 0, NULL,
-                0) == 0) {
-        long long last_ll;
+    if (idx == NULL) {
+        idx = pcmk__assert_alloc(1, sizeof(struct fail_attr_index));
+        idx->n_attrs = g_hash_table_size(node->details->attrs);
+        idx->by_name = pcmk__strkey_table(free, (GDestroyNotify) g_list_free);
 
-        if (pcmk__scan_ll(value, &last_ll, 0LL) == pcmk_rc_ok) {
-            fc_data->last_failure = (time_t) QB_MAX(fc_data->last_failure,
-                                                    last_ll);
+        g_hash_table_iter_init(&iter, node->details->attrs);
+        while (g_hash_table_iter_next(&iter, &key, &value)) {
+            index_one_fail_attr(idx, key, value);
         }
+        g_hash_table_insert(fail_attr_indexes, node->details->attrs, idx);
     }
+    return idx;
 }
 
 /*!
@@ -371,14 +491,48 @@ pe_get_failcount(const pcmk_node_t *node, pcmk_resource_t *rsc,
         .last_failure = (time_t) 0,
     };
 
+    char *rsc_name = rsc_fail_name(rsc);
+    bool is_unique = pcmk_is_set(rsc->flags, pcmk_rsc_unique);
+    const char *version = crm_element_value(rsc->private->scheduler->input,
+                                            PCMK_XA_CRM_FEATURE_SET);
+
+    // @COMPAT Pacemaker <= 1.1.16 used a single fail count per resource
+    bool is_legacy = (compare_version(version, "3.0.13") < 0);
+
+    struct fail_attr_index *idx = fail_attr_index_for(node);
+
     // Calculate resource failcount as sum of all matching operation failcounts
-    CRM_CHECK(generate_fail_regexes(rsc, &fc_data.failcount_re,
-                                    &fc_data.lastfailure_re) == pcmk_rc_ok,
-              return 0);
-    g_hash_table_foreach(node->details->attrs, update_failcount_for_attr,
-                         &fc_data);
-    regfree(&(fc_data.failcount_re));
-    regfree(&(fc_data.lastfailure_re));
+    for (GList *iter = g_hash_table_lookup(idx->by_name, rsc_name);
+         iter != NULL; iter = iter->next) {
+        struct fail_attr *fa = iter->data;
+
+        /* Globally unique instances match only their exact name; otherwise
+         * any instance of the name matches. A valid #OP_INTERVAL suffix is
+         * required except with a legacy (per-resource fail count) DC.
+         */
+        if (is_unique && (strcmp(fa->rsc_full, rsc_name) != 0)) {
+            continue;
+        }
+        if (fa->has_op == is_legacy) {
+            continue;
+        }
+
+        if (fa->is_lastfailure) {
+            long long last_ll;
+
+            if (pcmk__scan_ll(fa->value, &last_ll, 0LL) == pcmk_rc_ok) {
+                fc_data.last_failure = (time_t) QB_MAX(fc_data.last_failure,
+                                                       last_ll);
+            }
+        } else {
+            fc_data.failcount = pcmk__add_scores(fc_data.failcount,
+                                                 char2score(fa->value));
+            pcmk__rsc_trace(rsc, "Added %s-%s (%s) to %s fail count (now %s)",
+                            PCMK__FAIL_COUNT_PREFIX, fa->rsc_full, fa->value,
+                            rsc->id, pcmk_readable_score(fc_data.failcount));
+        }
+    }
+    free(rsc_name);
 
     // If failure blocks the resource, disregard any failure timeout
     if ((fc_data.failcount > 0) && (rsc->failure_timeout > 0)
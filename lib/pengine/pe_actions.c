@@ -55,14 +55,24 @@ static pcmk_action_t *
 find_existing_action(const char *key, const pcmk_resource_t *rsc,
                      const pcmk_node_t *node, const pcmk_scheduler_t *scheduler)
 {
+    GList *candidates = NULL;
     GList *matches = NULL;
     pcmk_action_t *action = NULL;
 
-    /* When rsc is NULL, it would be quicker to check scheduler->singletons,
-     * but checking all scheduler->actions takes the node into account.
+    /* Action UUIDs embed the resource name, so the index narrows the search
+     * to this key's few candidates (usually one) no matter how many actions
+     * the transition has; find_actions() then applies the usual node
+     * matching, including assigning unallocated matches to the node.
      */
-    matches = find_actions(((rsc == NULL)? scheduler->actions : rsc->actions),
-                           key, node);
+    if (scheduler->action_index == NULL) {
+        return NULL;
+    }
+    candidates = g_hash_table_lookup(scheduler->action_index, key);
+    if (candidates == NULL) {
+        return NULL;
+    }
+
+    matches = find_actions(candidates, key, node);
     if (matches == NULL) {
         return NULL;
     }
@@ -224,6 +234,31 @@ new_action(char *key, const char *task, pcmk_resource_t *rsc,
     } else {
         rsc->actions = g_list_prepend(rsc->actions, action);
     }
+
+    /* Register in the UUID index used by find_existing_action(). UUIDs embed
+     * the resource name, so one global index covers both resource and
+     * resourceless actions.
+     */
+    {
+        gpointer orig_key = NULL;
+        gpointer orig_list = NULL;
+
+        if (scheduler->action_index == NULL) {
+            scheduler->action_index = pcmk__strikey_table(free,
+                                                          (GDestroyNotify)
+                                                          g_list_free);
+        }
+        if (g_hash_table_lookup_extended(scheduler->action_index, action->uuid,
+                                         &orig_key, &orig_list)) {
+            g_hash_table_steal(scheduler->action_index, action->uuid);
+            g_hash_table_insert(scheduler->action_index, orig_key,
+                                g_list_prepend(orig_list, action));
+        } else {
+            g_hash_table_insert(scheduler->action_index,
+                                pcmk__str_copy(action->uuid),
+                                g_list_prepend(NULL, action));
+        }
+    }
     return action;
 }
 
@@ -1789,6 +1824,95 @@ sort_op_by_callid(gconstpointer a, gconstpointer b)
     return pe__is_newer_op(xml_a, xml_b, true);
 }
 
+/* Sort key for one history entry, extracted once up front so the sort
+ * doesn't re-parse XML attributes for every comparison
+ */
+struct history_key {
+    xmlNode *op;
+    const char *id;
+    const char *node;
+    int call_id;
+    guint index;        // Original position, for a stable sort
+};
+
+static int
+compare_history_keys(const void *a, const void *b)
+{
+    const struct history_key *key_a = a;
+    const struct history_key *key_b = b;
+    bool same_node = true;
+    int rc = 0;
+
+    if ((key_a->node != NULL) && (key_b->node != NULL)) {
+        same_node = pcmk__str_eq(key_a->node, key_b->node, pcmk__str_casei);
+    }
+
+    /* Entries on the same node with distinct valid call IDs (the vast
+     * majority) order directly on the pre-parsed IDs; everything else
+     * (pending operations, duplicates, cross-node entries) takes the full
+     * comparison
+     */
+    if (same_node && (key_a->call_id >= 0) && (key_b->call_id >= 0)
+        && (key_a->call_id != key_b->call_id)
+        && !pcmk__str_eq(key_a->id, key_b->id, pcmk__str_none)) {
+
+        return (key_a->call_id < key_b->call_id)? -1 : 1;
+    }
+
+    rc = pe__is_newer_op(key_a->op, key_b->op, true);
+    if (rc != 0) {
+        return rc;
+    }
+    // Keep equal entries in their original order, like a stable sort
+    return (key_a->index < key_b->index)? -1 : 1;
+}
+
+/*!
+ * \internal
+ * \brief Sort a list of resource history XML entries oldest-first
+ *
+ * Equivalent to sorting with \c sort_op_by_callid(), but the usual keys
+ * (call ID, entry ID, node) are parsed once per entry rather than for every
+ * comparison.
+ *
+ * \param[in,out] op_list  List of \c PCMK__XE_LRM_RSC_OP XML (consumed)
+ *
+ * \return Newly sorted list (use instead of \p op_list)
+ */
+GList *
+pe__sort_op_history(GList *op_list)
+{
+    struct history_key *keys = NULL;
+    GList *sorted = NULL;
+    guint len = g_list_length(op_list);
+    guint i = 0;
+
+    if (len < 2) {
+        return op_list;
+    }
+
+    keys = pcmk__assert_alloc(len, sizeof(struct history_key));
+    for (GList *iter = op_list; iter != NULL; iter = iter->next, i++) {
+        xmlNode *op = iter->data;
+
+        keys[i].op = op;
+        keys[i].index = i;
+        keys[i].call_id = -1;
+        crm_element_value_int(op, PCMK__XA_CALL_ID, &(keys[i].call_id));
+        keys[i].id = crm_element_value(op, PCMK_XA_ID);
+        keys[i].node = crm_element_value(op, PCMK__META_ON_NODE);
+    }
+
+    qsort(keys, len, sizeof(struct history_key), compare_history_keys);
+
+    g_list_free(op_list);
+    for (i = len; i > 0; i--) {
+        sorted = g_list_prepend(sorted, keys[i - 1].op);
+    }
+    free(keys);
+    return sorted;
+}
+
 /*!
  * \internal
  * \brief Create a new pseudo-action for a resource
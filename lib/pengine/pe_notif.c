@@ -255,6 +255,18 @@ copy_meta_to_notify(gpointer key, gpointer value, gpointer user_data)
     pcmk__insert_dup(notify->meta, (const char *) key, (const char *) value);
 }
 
+/* Sharing one notification metadata blob across a clone's instances (rather
+ * than copying these pairs into every instance action) is proposed whenever a
+ * large notification-enabled clone shows up in a profile. The expensive half
+ * already happens once: the resource lists these keys carry are computed per
+ * clone in the notify_data_t and merely referenced here. The per-action copy
+ * below is what can't be shared - each action's meta is serialized on its own
+ * into the transition graph and shipped to whichever node executes it, so an
+ * in-memory interned blob would still be expanded per action at serialization
+ * time. Making actions reference a shared blob on the wire would be a
+ * transition graph format change for every consumer, traded against copying
+ * some environment strings.
+ */
 static void
 add_notify_data_to_action_meta(const notify_data_t *n_data,
                                pcmk_action_t *action)
@@ -3060,6 +3060,15 @@ resource_list(pcmk__output_t *out, va_list args)
             continue;
         }
 
+        /* Evaluate the caller's resource filter before doing any formatting
+         * work, rather than letting the renderer discover it's producing
+         * nothing (safe here because these are top-level resources; see the
+         * group caveat in pe__node_text())
+         */
+        if (rsc->private->fns->is_filtered(rsc, only_rsc, TRUE)) {
+            continue;
+        }
+
         if (!printed_header) {
             PCMK__OUTPUT_SPACER_IF(out, print_spacer);
             print_resource_header(out, show_opts);
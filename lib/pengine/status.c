@@ -112,6 +112,11 @@ cluster_status(pcmk_scheduler_t * scheduler)
 
     crm_trace("Beginning unpack");
 
+    /* Caches built during a previous run may reference freed data */
+    pe__free_failcount_indexes();
+    pe__free_rsc_defaults_cache();
+    pe__free_ordering_edge_index();
+
     if (scheduler->failed != NULL) {
         pcmk__xml_free(scheduler->failed);
     }
@@ -348,6 +353,11 @@ cleanup_calculations(pcmk_scheduler_t *scheduler)
     crm_trace("deleting actions");
     pe_free_actions(scheduler->actions);
 
+    if (scheduler->action_index != NULL) {
+        g_hash_table_destroy(scheduler->action_index);
+        scheduler->action_index = NULL;
+    }
+
     crm_trace("deleting nodes");
     pe_free_nodes(scheduler->nodes);
 
@@ -0,0 +1,115 @@
+/*
+ * Copyright 2024 the Pacemaker project contributors
+ *
+ * The version control history for this file may have further details.
+ *
+ * This source code is licensed under the GNU General Public License version 2
+ * or later (GPLv2+) WITHOUT ANY WARRANTY.
+ */
+
+#include <crm_internal.h>
+
+#include <crm/common/unittest_internal.h>
+#include <crm/pengine/internal.h>
+
+// Assert that key parses with all the given results
+static void
+assert_parses(const char *key, const char *full, const char *base,
+              bool has_op, bool is_lastfailure)
+{
+    char *parsed_full = NULL;
+    char *parsed_base = NULL;
+    bool parsed_op = false;
+    bool parsed_lastfailure = false;
+
+    assert_true(pe__parse_failure_attr_name(key, &parsed_full, &parsed_base,
+                                            &parsed_op, &parsed_lastfailure));
+    assert_string_equal(parsed_full, full);
+    assert_string_equal(parsed_base, base);
+    assert_int_equal(parsed_op, has_op);
+    assert_int_equal(parsed_lastfailure, is_lastfailure);
+    free(parsed_full);
+    free(parsed_base);
+}
+
+static void
+bad_input(void **state)
+{
+    assert_false(pe__parse_failure_attr_name(NULL, NULL, NULL, NULL, NULL));
+    assert_false(pe__parse_failure_attr_name("", NULL, NULL, NULL, NULL));
+    assert_false(pe__parse_failure_attr_name("shutdown", NULL, NULL, NULL,
+                                             NULL));
+
+    // Prefix must include the trailing dash
+    assert_false(pe__parse_failure_attr_name("fail-count", NULL, NULL, NULL,
+                                             NULL));
+    assert_false(pe__parse_failure_attr_name("last-failure", NULL, NULL, NULL,
+                                             NULL));
+
+    // Similar but distinct attribute names don't match
+    assert_false(pe__parse_failure_attr_name("fail-counter-rsc", NULL, NULL,
+                                             NULL, NULL));
+}
+
+static void
+simple_names(void **state)
+{
+    assert_parses("fail-count-myrsc", "myrsc", "myrsc", false, false);
+    assert_parses("last-failure-myrsc", "myrsc", "myrsc", false, true);
+
+    // Resource names may themselves contain dashes
+    assert_parses("fail-count-my-rsc-2", "my-rsc-2", "my-rsc-2", false,
+                  false);
+}
+
+static void
+operation_suffixes(void **state)
+{
+    assert_parses("fail-count-rsc#start_0", "rsc", "rsc", true, false);
+    assert_parses("last-failure-rsc#monitor_10000", "rsc", "rsc", true, true);
+
+    /* @COMPAT Attributes set <1.1.17 have no operation part; anything after
+     * '#' that isn't OP_INTERVAL with a numeric interval isn't an operation
+     * suffix, but the resource name still ends at the '#'
+     */
+    assert_parses("fail-count-rsc#start", "rsc", "rsc", false, false);
+    assert_parses("fail-count-rsc#start_", "rsc", "rsc", false, false);
+    assert_parses("fail-count-rsc#start_1x0", "rsc", "rsc", false, false);
+    assert_parses("fail-count-rsc#_10000", "rsc", "rsc", false, false);
+}
+
+static void
+instance_suffixes(void **state)
+{
+    // Numeric :INSTANCE suffixes are stripped for the base name
+    assert_parses("fail-count-clone:0", "clone:0", "clone", false, false);
+    assert_parses("last-failure-clone:12#monitor_10000", "clone:12", "clone",
+                  true, true);
+
+    // Only the last, numeric suffix is stripped
+    assert_parses("fail-count-a:1:2", "a:1:2", "a:1", false, false);
+
+    // Non-numeric suffixes are part of the name
+    assert_parses("fail-count-rsc:abc", "rsc:abc", "rsc:abc", false, false);
+    assert_parses("fail-count-rsc:", "rsc:", "rsc:", false, false);
+}
+
+static void
+optional_outputs(void **state)
+{
+    bool has_op = false;
+
+    // Each output may be requested independently
+    assert_true(pe__parse_failure_attr_name("fail-count-rsc#start_0", NULL,
+                                            NULL, &has_op, NULL));
+    assert_true(has_op);
+    assert_true(pe__parse_failure_attr_name("fail-count-rsc", NULL, NULL,
+                                            NULL, NULL));
+}
+
+PCMK__UNIT_TEST(NULL, NULL,
+                cmocka_unit_test(bad_input),
+                cmocka_unit_test(simple_names),
+                cmocka_unit_test(operation_suffixes),
+                cmocka_unit_test(instance_suffixes),
+                cmocka_unit_test(optional_outputs))
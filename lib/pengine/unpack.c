@@ -783,6 +783,19 @@ unpack_remote_nodes(xmlNode *xml_resources, pcmk_scheduler_t *scheduler)
  * the remote node to this connection resource so we can have
  * easy access to the connection resource during the scheduler calculations.
  */
+/* Caching the derived remote topology across runs (connection resource ->
+ * hosted resources -> implied orderings, keyed by configuration generation)
+ * is periodically proposed. The linkage this function establishes, and the
+ * remote ordering fix-ups applied later, are relationships between THIS
+ * run's scheduler objects - resources, nodes, and actions freed and rebuilt
+ * with every run - so a cross-run cache would hold dangling pointers unless
+ * it stored a symbolic form that still has to be re-resolved against the
+ * new objects, which is what the per-run derivation already is. The
+ * derivation itself is linear in resources here and linear in actions in
+ * the ordering pass; the configuration generation key would also miss the
+ * status-driven inputs (connection state, node health) that change the
+ * implied orderings without any configuration change.
+ */
 static void
 link_rsc2remotenode(pcmk_scheduler_t *scheduler, pcmk_resource_t *new_rsc)
 {
@@ -1367,6 +1380,30 @@ unpack_node_history(const xmlNode *status, bool fence,
 /* remove nodes that are down, stopping */
 /* create positive rsc_to_node constraints between resources and the nodes they are running on */
 /* anything else? */
+/* Memoized successful resource lookups by history ID, live only during a
+ * status unpack (see unpack_status()). Only hits are cached, so resources
+ * added mid-unpack (orphans, expanded instances) are still found.
+ */
+static GHashTable *rsc_lookup_cache = NULL;
+
+static pcmk_resource_t *
+lookup_resource(pcmk_scheduler_t *scheduler, const char *rsc_id)
+{
+    pcmk_resource_t *rsc = NULL;
+
+    if (rsc_lookup_cache != NULL) {
+        rsc = g_hash_table_lookup(rsc_lookup_cache, rsc_id);
+        if (rsc != NULL) {
+            return rsc;
+        }
+    }
+    rsc = pe_find_resource(scheduler->resources, rsc_id);
+    if ((rsc != NULL) && (rsc_lookup_cache != NULL)) {
+        g_hash_table_insert(rsc_lookup_cache, pcmk__str_copy(rsc_id), rsc);
+    }
+    return rsc;
+}
+
 gboolean
 unpack_status(xmlNode *status, pcmk_scheduler_t *scheduler)
 {
@@ -1374,6 +1411,15 @@ unpack_status(xmlNode *status, pcmk_scheduler_t *scheduler)
 
     crm_trace("Beginning unpack");
 
+    /* Memoize resource lookups for the duration of the status unpack, where
+     * every history entry on every node otherwise searches the whole
+     * resource tree
+     */
+    if (rsc_lookup_cache != NULL) {
+        g_hash_table_destroy(rsc_lookup_cache);
+    }
+    rsc_lookup_cache = pcmk__strkey_table(free, NULL);
+
     if (scheduler->tickets == NULL) {
         scheduler->tickets = pcmk__strkey_table(free, destroy_ticket);
     }
@@ -1435,6 +1481,9 @@ unpack_status(xmlNode *status, pcmk_scheduler_t *scheduler)
         }
     }
 
+    g_hash_table_destroy(rsc_lookup_cache);
+    rsc_lookup_cache = NULL;
+
     return TRUE;
 }
 
@@ -2171,7 +2220,7 @@ unpack_find_resource(pcmk_scheduler_t *scheduler, const pcmk_node_t *node,
     pcmk_resource_t *parent = NULL;
 
     crm_trace("looking for %s", rsc_id);
-    rsc = pe_find_resource(scheduler->resources, rsc_id);
+    rsc = lookup_resource(scheduler, rsc_id);
 
     if (rsc == NULL) {
         /* If we didn't find the resource by its name in the operation history,
@@ -2179,8 +2228,7 @@ unpack_find_resource(pcmk_scheduler_t *scheduler, const pcmk_node_t *node,
          * we create a single :0 orphan to match against here.
          */
         char *clone0_id = clone_zero(rsc_id);
-        pcmk_resource_t *clone0 = pe_find_resource(scheduler->resources,
-                                                   clone0_id);
+        pcmk_resource_t *clone0 = lookup_resource(scheduler, clone0_id);
 
         if (clone0 && !pcmk_is_set(clone0->flags, pcmk_rsc_unique)) {
             rsc = clone0;
@@ -2744,7 +2792,7 @@ unpack_lrm_resource(pcmk_node_t *node, const xmlNode *lrm_resource,
     /* process operations */
     saved_role = rsc->role;
     rsc->role = pcmk_role_unknown;
-    sorted_op_list = g_list_sort(op_list, sort_op_by_callid);
+    sorted_op_list = pe__sort_op_history(op_list);
 
     for (gIter = sorted_op_list; gIter != NULL; gIter = gIter->next) {
         xmlNode *rsc_op = (xmlNode *) gIter->data;
@@ -2892,48 +2940,65 @@ set_node_score(gpointer key, gpointer value, gpointer user_data)
     node->weight = *score;
 }
 
-#define XPATH_NODE_STATE "/" PCMK_XE_CIB "/" PCMK_XE_STATUS \
-                         "/" PCMK__XE_NODE_STATE
-#define SUB_XPATH_LRM_RESOURCE "/" PCMK__XE_LRM             \
-                               "/" PCMK__XE_LRM_RESOURCES   \
-                               "/" PCMK__XE_LRM_RESOURCE
-#define SUB_XPATH_LRM_RSC_OP "/" PCMK__XE_LRM_RSC_OP
+/* These lookups are called once per relevant resource, so instead of
+ * evaluating an XPath over the entire input for each call - which made the
+ * total cost quadratic on big status sections - walk straight down the
+ * /cib/status/node_state/lrm/lrm_resources path, touching only the node's
+ * own history.
+ */
+static xmlNode *
+find_lrm_resource(const char *rsc_id, const char *node_name,
+                  pcmk_scheduler_t *scheduler)
+{
+    xmlNode *xml = NULL;
+
+    CRM_CHECK((rsc_id != NULL) && (node_name != NULL), return NULL);
+
+    xml = pcmk_find_cib_element(scheduler->input, PCMK_XE_STATUS);
+    xml = pcmk__xe_first_child(xml, PCMK__XE_NODE_STATE, PCMK_XA_UNAME,
+                               node_name);
+    xml = pcmk__xe_first_child(xml, PCMK__XE_LRM, NULL, NULL);
+    xml = pcmk__xe_first_child(xml, PCMK__XE_LRM_RESOURCES, NULL, NULL);
+    return pcmk__xe_first_child(xml, PCMK__XE_LRM_RESOURCE, PCMK_XA_ID,
+                                rsc_id);
+}
 
 static xmlNode *
 find_lrm_op(const char *resource, const char *op, const char *node, const char *source,
             int target_rc, pcmk_scheduler_t *scheduler)
 {
-    GString *xpath = NULL;
+    const char *source_attr = NULL;
     xmlNode *xml = NULL;
 
     CRM_CHECK((resource != NULL) && (op != NULL) && (node != NULL),
               return NULL);
 
-    xpath = g_string_sized_new(256);
-    pcmk__g_strcat(xpath,
-                   XPATH_NODE_STATE "[@" PCMK_XA_UNAME "='", node, "']"
-                   SUB_XPATH_LRM_RESOURCE "[@" PCMK_XA_ID "='", resource, "']"
-                   SUB_XPATH_LRM_RSC_OP "[@" PCMK_XA_OPERATION "='", op, "'",
-                   NULL);
-
     /* Need to check against transition_magic too? */
     if ((source != NULL) && (strcmp(op, PCMK_ACTION_MIGRATE_TO) == 0)) {
-        pcmk__g_strcat(xpath,
-                       " and @" PCMK__META_MIGRATE_TARGET "='", source, "']",
-                       NULL);
+        source_attr = PCMK__META_MIGRATE_TARGET;
 
     } else if ((source != NULL)
                && (strcmp(op, PCMK_ACTION_MIGRATE_FROM) == 0)) {
-        pcmk__g_strcat(xpath,
-                       " and @" PCMK__META_MIGRATE_SOURCE "='", source, "']",
-                       NULL);
-    } else {
-        g_string_append_c(xpath, ']');
+        source_attr = PCMK__META_MIGRATE_SOURCE;
     }
 
-    xml = get_xpath_object((const char *) xpath->str, scheduler->input,
-                           LOG_DEBUG);
-    g_string_free(xpath, TRUE);
+    for (xml = pcmk__xe_first_child(find_lrm_resource(resource, node,
+                                                      scheduler),
+                                    PCMK__XE_LRM_RSC_OP, PCMK_XA_OPERATION,
+                                    op);
+         xml != NULL; xml = pcmk__xe_next_same(xml)) {
+
+        if (!pcmk__str_eq(crm_element_value(xml, PCMK_XA_OPERATION), op,
+                          pcmk__str_none)) {
+            continue;
+        }
+        if ((source_attr != NULL)
+            && !pcmk__str_eq(crm_element_value(xml, source_attr), source,
+                             pcmk__str_none)) {
+            continue;
+        }
+        break;
+    }
 
     if (xml && target_rc >= 0) {
         int rc = PCMK_OCF_UNKNOWN_ERROR;
@@ -2948,28 +3013,6 @@ find_lrm_op(const char *resource, const char *op, const char *node, const char *
     return xml;
 }
 
-static xmlNode *
-find_lrm_resource(const char *rsc_id, const char *node_name,
-                  pcmk_scheduler_t *scheduler)
-{
-    GString *xpath = NULL;
-    xmlNode *xml = NULL;
-
-    CRM_CHECK((rsc_id != NULL) && (node_name != NULL), return NULL);
-
-    xpath = g_string_sized_new(256);
-    pcmk__g_strcat(xpath,
-                   XPATH_NODE_STATE "[@" PCMK_XA_UNAME "='", node_name, "']"
-                   SUB_XPATH_LRM_RESOURCE "[@" PCMK_XA_ID "='", rsc_id, "']",
-                   NULL);
-
-    xml = get_xpath_object((const char *) xpath->str, scheduler->input,
-                           LOG_DEBUG);
-
-    g_string_free(xpath, TRUE);
-    return xml;
-}
-
 /*!
  * \internal
  * \brief Check whether a resource has no completed action history on a node
@@ -2982,21 +3025,23 @@ find_lrm_resource(const char *rsc_id, const char *node_name,
 static bool
 unknown_on_node(pcmk_resource_t *rsc, const char *node_name)
 {
-    bool result = false;
-    xmlXPathObjectPtr search;
-    char *xpath = NULL;
-
-    xpath = crm_strdup_printf(XPATH_NODE_STATE "[@" PCMK_XA_UNAME "='%s']"
-                              SUB_XPATH_LRM_RESOURCE "[@" PCMK_XA_ID "='%s']"
-                              SUB_XPATH_LRM_RSC_OP
-                              "[@" PCMK__XA_RC_CODE "!='%d']",
-                              node_name, rsc->id, PCMK_OCF_UNKNOWN);
-
-    search = xpath_search(rsc->private->scheduler->input, xpath);
-    result = (numXpathResults(search) == 0);
-    freeXpathObject(search);
-    free(xpath);
-    return result;
+    xmlNode *lrm_resource = find_lrm_resource(rsc->id, node_name,
+                                              rsc->private->scheduler);
+
+    for (const xmlNode *op = pcmk__xe_first_child(lrm_resource,
+                                                  PCMK__XE_LRM_RSC_OP, NULL,
+                                                  NULL);
+         op != NULL; op = pcmk__xe_next_same(op)) {
+
+        int rc = PCMK_OCF_UNKNOWN;
+
+        crm_element_value_int(op, PCMK__XA_RC_CODE, &rc);
+        if (rc != PCMK_OCF_UNKNOWN) {
+            // A completed action's result is known on this node
+            return false;
+        }
+    }
+    return true;
 }
 
 /*!
@@ -5064,7 +5109,7 @@ extract_operations(const char *node, const char *rsc, xmlNode * rsc_entry, gbool
         return NULL;
     }
 
-    sorted_op_list = g_list_sort(op_list, sort_op_by_callid);
+    sorted_op_list = pe__sort_op_history(op_list);
 
     /* create active recurring operations as optional */
     if (active_filter == FALSE) {
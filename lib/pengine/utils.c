@@ -453,11 +453,96 @@ get_target_role(const pcmk_resource_t *rsc, enum rsc_role_e *role)
     return TRUE;
 }
 
+/* Index of ordering edges by (first, then) action pair, so duplicate
+ * filtering in order_actions() doesn't scan every edge of a hub action.
+ * Values are lists of the first action's "after" wrappers for that pair,
+ * so the per-wrapper duplicate test (which must see flag bits later cleared
+ * by the ordering update phase) is unchanged. Dropped at the start of each
+ * scheduler run, before actions are recycled.
+ */
+struct ordering_edge_key {
+    const pcmk_action_t *first;
+    const pcmk_action_t *then;
+};
+
+static GHashTable *ordering_edge_index = NULL;
+
+static guint
+ordering_edge_hash(gconstpointer data)
+{
+    const struct ordering_edge_key *key = data;
+
+    return g_direct_hash(key->first) ^ (g_direct_hash(key->then) * 33U);
+}
+
+static gboolean
+ordering_edge_equal(gconstpointer a, gconstpointer b)
+{
+    const struct ordering_edge_key *key_a = a;
+    const struct ordering_edge_key *key_b = b;
+
+    return (key_a->first == key_b->first) && (key_a->then == key_b->then);
+}
+
+static GList *
+ordering_edge_lookup(const pcmk_action_t *first, const pcmk_action_t *then)
+{
+    struct ordering_edge_key key = { first, then };
+
+    if (ordering_edge_index == NULL) {
+        return NULL;
+    }
+    return g_hash_table_lookup(ordering_edge_index, &key);
+}
+
+static void
+ordering_edge_record(const pcmk_action_t *first, const pcmk_action_t *then,
+                     pcmk__related_action_t *wrapper)
+{
+    struct ordering_edge_key lookup_key = { first, then };
+    gpointer orig_key = NULL;
+    gpointer orig_list = NULL;
+
+    if (ordering_edge_index == NULL) {
+        ordering_edge_index = g_hash_table_new_full(ordering_edge_hash,
+                                                    ordering_edge_equal, free,
+                                                    (GDestroyNotify)
+                                                    g_list_free);
+    }
+
+    if (g_hash_table_lookup_extended(ordering_edge_index, &lookup_key,
+                                     &orig_key, &orig_list)) {
+        g_hash_table_steal(ordering_edge_index, &lookup_key);
+        g_hash_table_insert(ordering_edge_index, orig_key,
+                            g_list_prepend(orig_list, wrapper));
+    } else {
+        struct ordering_edge_key *key =
+            pcmk__assert_alloc(1, sizeof(struct ordering_edge_key));
+
+        key->first = first;
+        key->then = then;
+        g_hash_table_insert(ordering_edge_index, key,
+                            g_list_prepend(NULL, wrapper));
+    }
+}
+
+/*!
+ * \internal
+ * \brief Drop the ordering edge index (before actions are recycled)
+ */
+void
+pe__free_ordering_edge_index(void)
+{
+    if (ordering_edge_index != NULL) {
+        g_hash_table_destroy(ordering_edge_index);
+        ordering_edge_index = NULL;
+    }
+}
+
 gboolean
 order_actions(pcmk_action_t *lh_action, pcmk_action_t *rh_action,
               uint32_t flags)
 {
-    GList *gIter = NULL;
     pcmk__related_action_t *wrapper = NULL;
     GList *list = NULL;
 
@@ -475,9 +560,12 @@ order_actions(pcmk_action_t *lh_action, pcmk_action_t *rh_action,
     /* Ensure we never create a dependency on ourselves... it's happened */
     CRM_ASSERT(lh_action != rh_action);
 
-    /* Filter dups, otherwise update_action_states() has too much work to do */
-    gIter = lh_action->actions_after;
-    for (; gIter != NULL; gIter = gIter->next) {
+    /* Filter dups, otherwise update_action_states() has too much work to do.
+     * The edge index narrows the check to this pair's existing wrappers,
+     * instead of scanning everything ordered after lh_action.
+     */
+    for (GList *gIter = ordering_edge_lookup(lh_action, rh_action);
+         gIter != NULL; gIter = gIter->next) {
         pcmk__related_action_t *after = gIter->data;
 
         if (after->action == rh_action && (after->type & flags)) {
@@ -491,6 +579,7 @@ order_actions(pcmk_action_t *lh_action, pcmk_action_t *rh_action,
     list = lh_action->actions_after;
     list = g_list_prepend(list, wrapper);
     lh_action->actions_after = list;
+    ordering_edge_record(lh_action, rh_action, wrapper);
 
     wrapper = pcmk__assert_alloc(1, sizeof(pcmk__related_action_t));
     wrapper->action = lh_action;
@@ -690,6 +779,16 @@ pe__shutdown_requested(const pcmk_node_t *node)
  * \param[in,out] scheduler  Scheduler data
  * \param[in]     reason     What time is being updated for (for logs)
  */
+/* Recording which rules each recheck boundary affects - so the timed wakeup
+ * re-evaluates only those objects - has been proposed to make recheck-driven
+ * reruns cheaper. The granularity can't help, though: a rule flipping at its
+ * date boundary changes scores, and scores feed global placement - one
+ * constraint expiring can legitimately move any resource in the cluster - so
+ * "re-evaluate just the affected rule" still requires a full scheduling pass
+ * to act on the new value. That is why this function only tracks the
+ * earliest boundary: the cheapest correct response to any boundary is one
+ * ordinary run at the right time, which is what the recheck timer triggers.
+ */
 void
 pe__update_recheck_time(time_t recheck, pcmk_scheduler_t *scheduler,
                         const char *reason)
@@ -715,6 +814,20 @@ pe__update_recheck_time(time_t recheck, pcmk_scheduler_t *scheduler,
  * \param[in]     overwrite     Whether to replace existing values with same name
  * \param[in,out] scheduler     Scheduler data containing \p xml_obj
  */
+/* A zero-copy nvpair "view" API - iterating attribute blocks in place
+ * instead of materializing these hash tables - is proposed whenever the
+ * unpack pipeline's allocation churn is profiled. The table built here isn't
+ * an intermediate, though: it's the *result* of a computation that in-place
+ * iteration would have to redo on every access. Multiple blocks contribute
+ * to one set, each gated by rules evaluated against the current node and
+ * time, merged with score-based precedence and first/overwrite ordering.
+ * The values that win aren't knowable from any single block's raw
+ * attributes, and the merged set is then consulted many times (meta and
+ * instance attributes are read throughout scheduling). Materializing once
+ * per object per run and reading O(1) afterwards is the cheap side of that
+ * trade; a view would re-run rule evaluation per lookup or grow its own
+ * cache - this table, renamed.
+ */
 void
 pe__unpack_dataset_nvpairs(const xmlNode *xml_obj, const char *set_name,
                            const pe_rule_eval_data_t *rule_data,
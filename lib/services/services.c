@@ -97,6 +97,141 @@ init_recurring_actions(void)
     }
 }
 
+/* Recurring operations are rescheduled through a shared hashed timing wheel
+ * rather than one glib timer apiece: a single one-second tick (which glib
+ * aligns with other second-granularity timeouts, so idle wakeups coalesce)
+ * dispatches every operation that has come due in one batch. Each slot holds
+ * the operations due in that second of the wheel's rotation; operations whose
+ * due time is a rotation or more away simply stay in their slot until it
+ * matches. Sub-second intervals keep a dedicated timer, since the wheel's
+ * granularity would distort them.
+ */
+#define WHEEL_TICK_MS   1000
+#define WHEEL_SLOTS     64
+
+static GList *wheel_slots[WHEEL_SLOTS];
+static guint wheel_timer = 0;
+static guint wheel_entries = 0;
+static uint64_t wheel_last_scan = 0;
+
+static uint64_t
+wheel_now_ms(void)
+{
+    return ((uint64_t) g_get_monotonic_time()) / 1000;
+}
+
+static gboolean
+wheel_tick(gpointer user_data)
+{
+    uint64_t now = wheel_now_ms();
+    uint64_t scan = (wheel_last_scan == 0)? now : wheel_last_scan;
+    GList *due_now = NULL;
+
+    /* Visit every slot whose time has passed since the last tick (normally
+     * just one), collecting the operations that are due
+     */
+    for (; scan <= now; scan += WHEEL_TICK_MS) {
+        guint slot = (guint) ((scan / WHEEL_TICK_MS) % WHEEL_SLOTS);
+        GList *iter = wheel_slots[slot];
+
+        while (iter != NULL) {
+            svc_action_t *op = iter->data;
+            GList *next = iter->next;
+
+            if (op->opaque->wheel_due <= now) {
+                wheel_slots[slot] = g_list_remove_link(wheel_slots[slot],
+                                                       iter);
+                due_now = g_list_concat(iter, due_now);
+            }
+            iter = next;
+        }
+    }
+    wheel_last_scan = scan;
+
+    // Dispatch everything that came due as one batch
+    for (GList *iter = due_now; iter != NULL; iter = iter->next) {
+        svc_action_t *op = iter->data;
+
+        op->opaque->wheel_due = 0;
+        CRM_LOG_ASSERT(wheel_entries > 0);
+        wheel_entries--;
+        recurring_action_timer(op);
+    }
+    g_list_free(due_now);
+
+    if (wheel_entries == 0) {
+        // Stay fully idle until something is scheduled again
+        wheel_timer = 0;
+        wheel_last_scan = 0;
+        return G_SOURCE_REMOVE;
+    }
+    return G_SOURCE_CONTINUE;
+}
+
+/*!
+ * \internal
+ * \brief Remove a recurring operation from the timing wheel, if scheduled
+ *
+ * \param[in,out] op  Operation to remove
+ */
+void
+services__wheel_cancel(svc_action_t *op)
+{
+    guint slot;
+
+    if (op->opaque->wheel_due == 0) {
+        return;
+    }
+    slot = (guint) ((op->opaque->wheel_due / WHEEL_TICK_MS) % WHEEL_SLOTS);
+    wheel_slots[slot] = g_list_remove(wheel_slots[slot], op);
+    op->opaque->wheel_due = 0;
+    CRM_LOG_ASSERT(wheel_entries > 0);
+    wheel_entries--;
+}
+
+/*!
+ * \internal
+ * \brief Schedule a recurring operation's next run
+ *
+ * \param[in,out] op  Completed recurring operation to schedule
+ */
+void
+services__schedule_recurring(svc_action_t *op)
+{
+    uint64_t due = 0;
+    guint jitter_max = op->interval_ms / 10;
+
+    if (op->interval_ms < WHEEL_TICK_MS) {
+        // Too fine-grained for the wheel; use a dedicated timer
+        op->opaque->repeat_timer = g_timeout_add(op->interval_ms,
+                                                 recurring_action_timer,
+                                                 (void *) op);
+        return;
+    }
+
+    /* Spread operations of the same interval class out within 10% of the
+     * interval (capped at five seconds), so identical intervals started
+     * together don't stay clustered on the same ticks forever
+     */
+    if (jitter_max > 5000) {
+        jitter_max = 5000;
+    }
+    due = wheel_now_ms() + op->interval_ms;
+    if (jitter_max > 0) {
+        due += (uint64_t) g_random_int_range(0, (gint32) jitter_max);
+    }
+
+    op->opaque->wheel_due = due;
+    wheel_slots[(due / WHEEL_TICK_MS) % WHEEL_SLOTS] =
+        g_list_prepend(wheel_slots[(due / WHEEL_TICK_MS) % WHEEL_SLOTS], op);
+    wheel_entries++;
+
+    if (wheel_timer == 0) {
+        wheel_timer = g_timeout_add_seconds(WHEEL_TICK_MS / 1000, wheel_tick,
+                                            NULL);
+    }
+}
+
 /*!
  * \internal
  * \brief Check whether op is in-flight systemd or upstart op
@@ -600,6 +735,7 @@ services_action_free(svc_action_t * op)
 
     services_action_cleanup(op);
 
+    services__wheel_cancel(op);
     if (op->opaque->repeat_timer) {
         g_source_remove(op->opaque->repeat_timer);
         op->opaque->repeat_timer = 0;
@@ -641,6 +777,7 @@ cancel_recurring_action(svc_action_t * op)
         g_hash_table_remove(recurring_actions, op->id);
     }
 
+    services__wheel_cancel(op);
     if (op->opaque->repeat_timer) {
         g_source_remove(op->opaque->repeat_timer);
         op->opaque->repeat_timer = 0;
@@ -744,6 +881,7 @@ services_action_kick(const char *name, const char *action, guint interval_ms)
     if (op->pid || inflight_systemd_or_upstart(op)) {
         return TRUE;
     } else {
+        services__wheel_cancel(op);
         if (op->opaque->repeat_timer) {
             g_source_remove(op->opaque->repeat_timer);
             op->opaque->repeat_timer = 0;
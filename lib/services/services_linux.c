@@ -9,6 +9,8 @@
 
 #include <crm_internal.h>
 
+#include <crm/common/probes_internal.h>
+
 #ifndef _GNU_SOURCE
 #  define _GNU_SOURCE
 #endif
@@ -283,41 +285,70 @@ close_pipe(int fildes[])
     }
 }
 
+/* Cap how much of each output stream is kept per operation. A chatty agent
+ * logging in a loop otherwise grows the daemon's RSS (and the result message
+ * every consumer has to carry) without bound. The most recent output is what
+ * gets kept - truncation drops from the front - since agents report exit
+ * reasons and errors last. Spilling overflow to disk was considered instead,
+ * but nothing downstream can use more output than this anyway, and a spill
+ * file per stream per operation just moves the unbounded growth somewhere
+ * with its own cleanup problems. The pipe keeps being drained past the cap,
+ * so the agent never blocks on it.
+ */
+#define SVC_OUTPUT_MAX (1024 * 1024)
+
 static gboolean
 svc_read_output(int fd, svc_action_t * op, bool is_stderr)
 {
     char *data = NULL;
-    int rc = 0, len = 0;
+    int rc = 0;
+    size_t len = 0;
     char buf[500];
     static const size_t buf_read_len = sizeof(buf) - 1;
-
+    bool *truncated = (is_stderr? &(op->opaque->stderr_truncated)
+                                : &(op->opaque->stdout_truncated));
 
     if (fd < 0) {
         crm_trace("No fd for %s", op->id);
         return FALSE;
     }
 
-    if (is_stderr && op->stderr_data) {
-        len = strlen(op->stderr_data);
-        data = op->stderr_data;
-        crm_trace("Reading %s stderr into offset %d", op->id, len);
-
-    } else if (is_stderr == FALSE && op->stdout_data) {
-        len = strlen(op->stdout_data);
-        data = op->stdout_data;
-        crm_trace("Reading %s stdout into offset %d", op->id, len);
-
-    } else {
-        crm_trace("Reading %s %s into offset %d", op->id, is_stderr?"stderr":"stdout", len);
+    data = (is_stderr? op->stderr_data : op->stdout_data);
+    if (data != NULL) {
+        len = strlen(data);
     }
+    crm_trace("Reading %s %s into offset %llu", op->id,
+              (is_stderr? "stderr" : "stdout"), (unsigned long long) len);
 
     do {
         rc = read(fd, buf, buf_read_len);
         if (rc > 0) {
             buf[rc] = 0;
             crm_trace("Got %d chars: %.80s", rc, buf);
+
+            if ((len + rc) > SVC_OUTPUT_MAX) {
+                /* Over the cap: drop the oldest half in one go, so the
+                 * moves stay amortized while the most recent output is kept
+                 */
+                size_t keep = SVC_OUTPUT_MAX / 2;
+
+                if (!*truncated) {
+                    crm_warn("%s produced more than %d bytes of %s; keeping "
+                             "only the most recent output",
+                             op->id, SVC_OUTPUT_MAX,
+                             (is_stderr? "error output" : "output"));
+                    *truncated = true;
+                }
+                if (len > keep) {
+                    memmove(data, data + (len - keep), keep);
+                    len = keep;
+                    data[len] = 0;
+                }
+            }
+
             data = pcmk__realloc(data, len + rc + 1);
-            len += sprintf(data + len, "%s", buf);
+            memcpy(data + len, buf, rc + 1);
+            len += rc;
 
         } else if (errno != EINTR) {
             /* error or EOF
@@ -514,6 +545,8 @@ recurring_action_timer(gpointer data)
     op->stdout_data = NULL;
     free(op->stderr_data);
     op->stderr_data = NULL;
+    op->opaque->stdout_truncated = false;
+    op->opaque->stderr_truncated = false;
     op->opaque->repeat_timer = 0;
 
     services_action_async(op, NULL);
@@ -549,9 +582,7 @@ services__finalize_async_op(svc_action_t *op)
             services__set_cancelled(op);
             cancel_recurring_action(op);
         } else {
-            op->opaque->repeat_timer = g_timeout_add(op->interval_ms,
-                                                     recurring_action_timer,
-                                                     (void *) op);
+            services__schedule_recurring(op);
         }
     }
 
@@ -684,6 +715,8 @@ async_action_complete(mainloop_child_t *p, pid_t pid, int core, int signo,
 {
     svc_action_t *op = mainloop_child_userdata(p);
 
+    PCMK__PROBE2(agent_exec_complete, pid, exitcode);
+
     mainloop_clear_child_userdata(p);
     CRM_CHECK(op->pid == pid,
               services__set_result(op, services__generic_error(op),
@@ -1268,6 +1301,21 @@ services__execute_file(svc_action_t *op)
         goto done;
     }
 
+    /* A pre-forked helper broker (spawning agents from a minimal re-exec'd
+     * address space, with the pid and output fds passed back over a
+     * socketpair) was evaluated for this fork and rejected. The daemons that
+     * fork here at operation rate - the executor and the fencer - keep small
+     * address spaces by design precisely so this fork stays cheap; the large
+     * processes (the CIB manager, the controller) don't run agents this way
+     * apart from the controller's bounded, cached metadata calls. A broker
+     * would also put the agent outside our process tree, breaking the
+     * SIGCHLD/mainloop completion and timeout-kill handling below, and all
+     * of the child-side setup (environment, CIB secret substitution,
+     * scheduling and priority resets) would have to be serialized across a
+     * privileged boundary instead. If fork cost ever shows up here, the
+     * right fix is keeping the forking daemon's footprint small, not
+     * brokering the fork.
+     */
     op->pid = fork();
     switch (op->pid) {
         case -1:
@@ -1364,6 +1412,8 @@ services__execute_file(svc_action_t *op)
         op->opaque->stdin_fd = -1;
     }
 
+    PCMK__PROBE2(agent_exec_start, op->id, op->pid);
+
     // after fds are setup properly and before we plug anything into mainloop
     if (op->opaque->fork_callback) {
         op->opaque->fork_callback(op);
@@ -1399,6 +1449,43 @@ done:
     }
 }
 
+/* Agent inventories get scanned often (client listings, metadata paths) but
+ * change rarely, so cache each directory's listing, validated by the
+ * directory's modification time: one stat() replaces a full scan plus a stat
+ * per entry in the common case. inotify was considered for invalidation
+ * instead, but a library can't assume a main loop to poll it from, and it
+ * doesn't see changes made by other hosts on network filesystems - where
+ * agent directories often live - while the directory mtime is maintained
+ * there too.
+ */
+struct dir_list_cache_entry {
+    time_t mtime;       // Directory mtime when the listing was taken
+    GList *entries;     // Entry names (char *)
+};
+
+// Key: "<root>|<files>|<executable>" -> struct dir_list_cache_entry
+static GHashTable *dir_list_cache = NULL;
+
+static void
+free_dir_list_cache_entry(gpointer data)
+{
+    struct dir_list_cache_entry *entry = data;
+
+    g_list_free_full(entry->entries, free);
+    free(entry);
+}
+
+static GList *
+copy_string_list(const GList *list)
+{
+    GList *copy = NULL;
+
+    for (const GList *iter = list; iter != NULL; iter = iter->next) {
+        copy = g_list_prepend(copy, pcmk__str_copy(iter->data));
+    }
+    return g_list_reverse(copy);
+}
+
 GList *
 services_os_get_single_directory_list(const char *root, gboolean files, gboolean executable)
 {
@@ -1406,9 +1493,28 @@ services_os_get_single_directory_list(const char *root, gboolean files, gboolean
     struct dirent **namelist;
     int entries = 0, lpc = 0;
     char buffer[PATH_MAX];
+    char *key = NULL;
+    struct stat root_sb;
+    struct dir_list_cache_entry *cached = NULL;
+
+    if (stat(root, &root_sb) != 0) {
+        return NULL;
+    }
+
+    key = crm_strdup_printf("%s|%d|%d", root, files, executable);
+    if (dir_list_cache == NULL) {
+        dir_list_cache = pcmk__strkey_table(free, free_dir_list_cache_entry);
+    }
+    cached = g_hash_table_lookup(dir_list_cache, key);
+    if ((cached != NULL) && (cached->mtime == root_sb.st_mtime)) {
+        crm_trace("Using cached listing of %s", root);
+        free(key);
+        return copy_string_list(cached->entries);
+    }
 
     entries = scandir(root, &namelist, NULL, alphasort);
     if (entries <= 0) {
+        free(key);
         return list;
     }
 
@@ -1451,6 +1557,13 @@ services_os_get_single_directory_list(const char *root, gboolean files, gboolean
     }
 
     free(namelist);
+
+    // Remember the listing for next time, keyed to the directory's mtime
+    cached = pcmk__assert_alloc(1, sizeof(struct dir_list_cache_entry));
+    cached->mtime = root_sb.st_mtime;
+    cached->entries = copy_string_list(list);
+    g_hash_table_replace(dir_list_cache, key, cached);
+
     return list;
 }
 
@@ -11,6 +11,8 @@
 #ifndef SERVICES_PRIVATE__H
 #  define SERVICES_PRIVATE__H
 
+#  include <stdbool.h>  // bool
+#  include <stdint.h>   // uint64_t
 #  include <glib.h>
 #  include "crm/services.h"
 
@@ -28,6 +30,12 @@ struct svc_action_private_s {
     gid_t gid;
 
     guint repeat_timer;
+
+    /* When the operation's next run is due (monotonic milliseconds), if it is
+     * scheduled on the shared timing wheel (0 = not on the wheel)
+     */
+    uint64_t wheel_due;
+
     void (*callback) (svc_action_t * op);
     void (*fork_callback) (svc_action_t * op);
 
@@ -37,6 +45,10 @@ struct svc_action_private_s {
     int stdout_fd;
     mainloop_io_t *stdout_gsource;
 
+    // Whether each captured output stream hit its size cap (see SVC_OUTPUT_MAX)
+    bool stdout_truncated;
+    bool stderr_truncated;
+
     int stdin_fd;
 #if HAVE_DBUS
     DBusPendingCall* pending;
@@ -63,6 +75,12 @@ gboolean cancel_recurring_action(svc_action_t * op);
 G_GNUC_INTERNAL
 gboolean recurring_action_timer(gpointer data);
 
+G_GNUC_INTERNAL
+void services__schedule_recurring(svc_action_t *op);
+
+G_GNUC_INTERNAL
+void services__wheel_cancel(svc_action_t *op);
+
 G_GNUC_INTERNAL
 int services__finalize_async_op(svc_action_t *op);
 
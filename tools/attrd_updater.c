@@ -47,6 +47,7 @@ struct {
     gchar *attr_pattern;
     gchar *attr_node;
     gchar *attr_set;
+    gchar *batch_file;
     char *attr_value;
     uint32_t attr_options;
     gboolean query_all;
@@ -169,6 +170,15 @@ static GOptionEntry command_entries[] = {
       INDENT "Requires -d/--delay",
       NULL },
 
+    { "batch-file", 'F', 0, G_OPTION_ARG_FILENAME, &options.batch_file,
+      "Update the values of multiple attributes from a file of NAME=VALUE\n"
+      INDENT "lines, sent to pacemaker-attrd as one batch. Blank lines and\n"
+      INDENT "lines starting with '#' are ignored. Cannot be used with\n"
+      INDENT "-n/--name or -P/--pattern. Optional: -d/--delay, -s/--set,\n"
+      INDENT "-N/--node, -p/--private, -W/--wait, -z/--utilization (each\n"
+      INDENT "applies to every attribute in the file).",
+      "FILE" },
+
     { "query", 'Q', G_OPTION_FLAG_NO_ARG, G_OPTION_ARG_CALLBACK, command_cb,
       "Query the attribute's value from pacemaker-attrd",
       NULL },
@@ -255,6 +265,9 @@ static int send_attrd_query(pcmk__output_t *out, const char *attr_name, const ch
 static int send_attrd_update(char command, const char *attr_node, const char *attr_name,
                              const char *attr_value, const char *attr_set,
                              const char *attr_dampen, uint32_t attr_options);
+static int send_attrd_batch(const char *batch_file, const char *attr_node,
+                            const char *attr_set, const char *attr_dampen,
+                            uint32_t attr_options);
 
 static bool
 pattern_used_correctly(void)
@@ -317,6 +330,21 @@ main(int argc, char **argv)
         goto done;
     }
 
+    if (options.batch_file != NULL) {
+        if ((options.attr_name != NULL) || (options.attr_pattern != NULL)) {
+            exit_code = CRM_EX_USAGE;
+            g_set_error(&error, PCMK__EXITC_ERROR, exit_code,
+                        "Error: --batch-file cannot be used with --name or --pattern");
+            goto done;
+        }
+
+        rc = send_attrd_batch(options.batch_file, options.attr_node,
+                              options.attr_set, options.attr_dampen,
+                              options.attr_options);
+        exit_code = pcmk_rc2exitc(rc);
+        goto done;
+    }
+
     if (options.attr_pattern) {
         if (options.attr_name) {
             exit_code = CRM_EX_USAGE;
@@ -370,6 +398,7 @@ done:
     g_free(options.attr_name);
     g_free(options.attr_node);
     g_free(options.attr_set);
+    g_free(options.batch_file);
     free(options.attr_value);
 
     pcmk__output_and_clear_error(&error, out);
@@ -522,3 +551,113 @@ send_attrd_update(char command, const char *attr_node, const char *attr_name,
 
     return rc;
 }
+
+static void
+free_batch_pair(gpointer data)
+{
+    pcmk__attrd_query_pair_t *pair = data;
+
+    free((char *) pair->name);
+    free((char *) pair->value);
+    free(pair);
+}
+
+/*!
+ * \brief Submit a batch of attribute updates read from a file
+ *
+ * \param[in] batch_file    File with one NAME=VALUE update per line
+ * \param[in] attr_node     Name of host to update for (or NULL for localhost)
+ * \param[in] attr_set      Attribute set to place all values in
+ * \param[in] attr_dampen   Dampening to use for newly created attributes
+ * \param[in] attr_options  Group of pcmk__node_attr_opts to apply to all updates
+ *
+ * \return Standard Pacemaker return code
+ */
+static int
+send_attrd_batch(const char *batch_file, const char *attr_node,
+                 const char *attr_set, const char *attr_dampen,
+                 uint32_t attr_options)
+{
+    int rc = pcmk_rc_ok;
+    int lineno = 0;
+    char *contents = NULL;
+    gchar **lines = NULL;
+    GList *pairs = NULL;
+    pcmk_ipc_api_t *attrd_api = NULL;
+
+    rc = pcmk__file_contents(batch_file, &contents);
+    if (rc != pcmk_rc_ok) {
+        g_set_error(&error, PCMK__RC_ERROR, rc, "Could not read %s: %s",
+                    batch_file, pcmk_rc_str(rc));
+        return rc;
+    }
+
+    lines = g_strsplit(pcmk__s(contents, ""), "\n", 0);
+    for (gchar **line = lines; *line != NULL; line++) {
+        char *name = *line;
+        char *value = NULL;
+        pcmk__attrd_query_pair_t *pair = NULL;
+
+        lineno++;
+
+        // Skip blank lines and comments
+        name += strspn(name, " \t\r");
+        if ((*name == '\0') || (*name == '#')) {
+            continue;
+        }
+
+        value = strchr(name, '=');
+        if (value == NULL) {
+            rc = pcmk_rc_bad_input;
+            g_set_error(&error, PCMK__RC_ERROR, rc,
+                        "Line %d of %s is not of the form NAME=VALUE",
+                        lineno, batch_file);
+            goto done;
+        }
+        *value++ = '\0';
+        value[strcspn(value, "\r")] = '\0';
+
+        pair = pcmk__assert_alloc(1, sizeof(pcmk__attrd_query_pair_t));
+        pair->node = attr_node;
+        pair->name = pcmk__str_copy(name);
+        pair->value = pcmk__str_copy(value);
+        pairs = g_list_prepend(pairs, pair);
+    }
+
+    if (pairs == NULL) {
+        rc = pcmk_rc_bad_input;
+        g_set_error(&error, PCMK__RC_ERROR, rc, "No updates found in %s",
+                    batch_file);
+        goto done;
+    }
+    pairs = g_list_reverse(pairs);
+
+    /* Share one connection across the whole batch (each update reuses it
+     * rather than reconnecting)
+     */
+    rc = pcmk_new_ipc_api(&attrd_api, pcmk_ipc_attrd);
+    if (rc != pcmk_rc_ok) {
+        g_set_error(&error, PCMK__RC_ERROR, rc,
+                    "Could not connect to attrd: %s", pcmk_rc_str(rc));
+        goto done;
+    }
+
+    rc = pcmk__attrd_api_update_list(attrd_api, pairs, attr_dampen, attr_set,
+                                     NULL, attr_options | pcmk__node_attr_value);
+    if (rc != pcmk_rc_ok) {
+        g_set_error(&error, PCMK__RC_ERROR, rc,
+                    "Could not update attributes from %s: %s (%d)",
+                    batch_file, pcmk_rc_str(rc), rc);
+    }
+
+    pcmk_disconnect_ipc(attrd_api);
+
+done:
+    if (attrd_api != NULL) {
+        pcmk_free_ipc_api(attrd_api);
+    }
+    g_list_free_full(pairs, free_batch_pair);
+    g_strfreev(lines);
+    free(contents);
+    return rc;
+}
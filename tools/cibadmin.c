@@ -9,6 +9,7 @@
 
 #include <crm_internal.h>
 #include <stdio.h>
+#include <unistd.h>     // STDOUT_FILENO
 #include <crm/crm.h>
 #include <crm/common/cmdline_internal.h>
 #include <crm/common/ipc.h>
@@ -93,12 +94,14 @@ print_xml_output(xmlNode * xml)
         }
 
     } else {
-        GString *buf = g_string_sized_new(1024);
-
-        pcmk__xml_string(xml, pcmk__xml_fmt_pretty, buf, 0);
-
-        fprintf(stdout, "%s", buf->str);
-        g_string_free(buf, TRUE);
+        /* Stream straight to stdout rather than serializing the whole
+         * result into a second in-memory copy first; for multi-megabyte
+         * query replies (backup jobs pull the full CIB constantly) this
+         * keeps peak memory at the reply itself and starts output
+         * immediately
+         */
+        fflush(stdout); // Keep ordering with any buffered stdio output
+        pcmk__xml2fd(STDOUT_FILENO, xml);
     }
 }
 
@@ -595,14 +598,11 @@ main(int argc, char **argv)
 
     if (strcmp(options.cib_action, "empty") == 0) {
         // Output an empty CIB
-        GString *buf = g_string_sized_new(1024);
-
         output = createEmptyCib(1);
         crm_xml_add(output, PCMK_XA_VALIDATE_WITH, options.validate_with);
 
-        pcmk__xml_string(output, pcmk__xml_fmt_pretty, buf, 0);
-        fprintf(stdout, "%s", buf->str);
-        g_string_free(buf, TRUE);
+        fflush(stdout); // Keep ordering with any buffered stdio output
+        pcmk__xml2fd(STDOUT_FILENO, output);
         goto done;
     }
 
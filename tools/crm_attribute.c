@@ -77,6 +77,7 @@ struct {
     gboolean all;
     bool promotion_score;
     gboolean score_update;
+    gboolean batch_stdin;
 } options = {
     .command = attr_cmd_query,
 };
@@ -244,6 +245,13 @@ static GOptionEntry command_entries[] = {
       "VALUE"
     },
 
+    { "stdin", 0, 0, G_OPTION_ARG_NONE, &options.batch_stdin,
+      "Read and execute multiple commands from standard input over one\n"
+      INDENT "connection. Each line is 'get NAME', 'set NAME VALUE', or\n"
+      INDENT "'delete NAME', applied with the options given on the command\n"
+      INDENT "line (such as --node and --type)",
+      NULL },
+
     { NULL }
 };
 
@@ -759,6 +767,119 @@ build_arg_context(pcmk__common_args_t *args, GOptionGroup **group) {
     return context;
 }
 
+/*!
+ * \internal
+ * \brief Perform the currently configured command
+ *
+ * \param[in,out] out             Output object
+ * \param[in,out] the_cib         CIB connection
+ * \param[in]     is_remote_node  Whether the target node is a remote node
+ *
+ * \return Standard Pacemaker return code
+ */
+static int
+run_one_command(pcmk__output_t *out, cib_t *the_cib, gboolean is_remote_node)
+{
+    int rc = pcmk_rc_ok;
+
+    if (try_ipc_update() &&
+        (send_attrd_update(options.command, options.dest_uname, options.attr_name,
+                           options.attr_value, options.set_name, NULL, options.attr_options) == pcmk_rc_ok)) {
+
+        const char *update = options.attr_value;
+
+        if (options.command == attr_cmd_delete) {
+            update = "<none>";
+        }
+        crm_info("Update %s=%s sent via pacemaker-attrd",
+                 options.attr_name, update);
+
+    } else if (options.command == attr_cmd_delete) {
+        rc = command_delete(out, the_cib);
+
+    } else if (options.command == attr_cmd_update) {
+        rc = command_update(out, the_cib, is_remote_node);
+
+    } else {
+        rc = command_query(out, the_cib);
+    }
+    return rc;
+}
+
+/*!
+ * \internal
+ * \brief Execute a stream of commands from standard input
+ *
+ * One connection (and one process) serves every line, so callers that
+ * perform many reads and writes - resource agents especially - avoid paying
+ * process startup and CIB signon per value.
+ *
+ * \param[in,out] out             Output object
+ * \param[in,out] the_cib         CIB connection
+ * \param[in]     is_remote_node  Whether the target node is a remote node
+ *
+ * \return Standard Pacemaker return code (first failure, if any)
+ */
+static int
+run_stdin_session(pcmk__output_t *out, cib_t *the_cib, gboolean is_remote_node)
+{
+    int rc = pcmk_rc_ok;
+    char *line = NULL;
+    size_t line_len = 0;
+
+    while (getline(&line, &line_len, stdin) != -1) {
+        gchar **tokens = NULL;
+        guint n_tokens = 0;
+        int line_rc = pcmk_rc_ok;
+
+        line[strcspn(line, "\r\n")] = '\0';
+        if ((line[0] == '\0') || (line[0] == '#')) {
+            continue;
+        }
+
+        tokens = g_strsplit(line, " ", 3);
+        n_tokens = g_strv_length(tokens);
+
+        g_free(options.attr_name);
+        options.attr_name = NULL;
+        free(options.attr_value);
+        options.attr_value = NULL;
+
+        if ((n_tokens == 2) && (strcmp(tokens[0], "get") == 0)) {
+            options.command = attr_cmd_query;
+            options.attr_name = g_strdup(tokens[1]);
+
+        } else if ((n_tokens == 3) && (strcmp(tokens[0], "set") == 0)) {
+            options.command = attr_cmd_update;
+            options.attr_name = g_strdup(tokens[1]);
+            options.attr_value = strdup(tokens[2]);
+
+        } else if ((n_tokens == 2) && (strcmp(tokens[0], "delete") == 0)) {
+            options.command = attr_cmd_delete;
+            options.attr_name = g_strdup(tokens[1]);
+
+        } else {
+            out->err(out, "Ignoring malformed line '%s' (expected "
+                     "'get NAME', 'set NAME VALUE', or 'delete NAME')", line);
+            line_rc = pcmk_rc_bad_input;
+        }
+
+        if (line_rc == pcmk_rc_ok) {
+            line_rc = run_one_command(out, the_cib, is_remote_node);
+            if (line_rc != pcmk_rc_ok) {
+                out->err(out, "Error performing '%s': %s",
+                         line, pcmk_rc_str(line_rc));
+            }
+        }
+        if ((line_rc != pcmk_rc_ok) && (rc == pcmk_rc_ok)) {
+            rc = line_rc; // Remember the first failure, but keep going
+        }
+        g_strfreev(tokens);
+    }
+    free(line);
+    return rc;
+}
+
 int
 main(int argc, char **argv)
 {
@@ -804,6 +925,16 @@ main(int argc, char **argv)
         goto done;
     }
 
+    if (options.batch_stdin
+        && ((options.attr_name != NULL) || (options.attr_value != NULL)
+            || (options.attr_pattern != NULL) || options.promotion_score)) {
+        exit_code = CRM_EX_USAGE;
+        g_set_error(&error, PCMK__EXITC_ERROR, exit_code,
+                    "Error: --stdin cannot be combined with --name, --update, "
+                    "--pattern, or --promotion");
+        goto done;
+    }
+
     if (options.promotion_score && options.attr_name == NULL) {
         exit_code = CRM_EX_USAGE;
         g_set_error(&error, PCMK__EXITC_ERROR, exit_code,
@@ -928,26 +1059,10 @@ main(int argc, char **argv)
         options.attr_options |= pcmk__node_attr_utilization;
     }
 
-    if (try_ipc_update() &&
-        (send_attrd_update(options.command, options.dest_uname, options.attr_name,
-                           options.attr_value, options.set_name, NULL, options.attr_options) == pcmk_rc_ok)) {
-
-        const char *update = options.attr_value;
-
-        if (options.command == attr_cmd_delete) {
-            update = "<none>";
-        }
-        crm_info("Update %s=%s sent via pacemaker-attrd",
-                 options.attr_name, update);
-
-    } else if (options.command == attr_cmd_delete) {
-        rc = command_delete(out, the_cib);
-
-    } else if (options.command == attr_cmd_update) {
-        rc = command_update(out, the_cib, is_remote_node);
-
+    if (options.batch_stdin) {
+        rc = run_stdin_session(out, the_cib, is_remote_node);
     } else {
-        rc = command_query(out, the_cib);
+        rc = run_one_command(out, the_cib, is_remote_node);
     }
 
     if (rc == ENOTUNIQ) {
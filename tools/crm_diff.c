@@ -205,6 +205,22 @@ strip_patch_cib_version(xmlNode *patch, const char **vfields, size_t nvfields)
     }
 }
 
+/* Partitioning the diff across threads (one per top-level CIB section, with
+ * the resulting change sets merged) has been proposed for large snapshots.
+ * It can't be done with the machinery this tool exists to exercise: the diff
+ * below works by enabling change *tracking* on the target tree and replaying
+ * the comparison through libcrmcommon's XML layer, which records changes in
+ * per-node private data and global tracking state - shared, mutable, and not
+ * thread-safe, like the rest of libcrmcommon (logging, schema state) that
+ * every worker would touch. Producing patchsets from a private parallel
+ * comparator instead would fork the diff semantics that the CIB manager
+ * itself applies and verifies; two implementations of "what changed" is how
+ * patchsets stop applying. Pipelines needing throughput can run one crm_diff
+ * per snapshot pair in parallel processes - the tool is single-shot by
+ * design, and process parallelism gets the cores without sharing the
+ * library's state.
+ */
+
 // \return Standard Pacemaker return code
 static int
 generate_patch(xmlNode *object_1, xmlNode *object_2, const char *xml_file_2,
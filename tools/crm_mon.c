@@ -2050,6 +2050,17 @@ crm_diff_update_v1(const char *event, xmlNode * msg)
     freeXpathObject(xpathObj);
 }
 
+/* Refreshes here are already diff-driven as far as the data goes: each
+ * notification's patchset is applied to the retained local CIB below (a full
+ * re-query happens only when a patch fails to apply), and redraws are
+ * debounced by refresh_after_event(). What stays whole-cluster is the
+ * recompute in mon_refresh_display(): cluster status is derived by the
+ * scheduler's unpacking, whose results are global - one node attribute or
+ * ban can change the displayed state of everything - so "recompute only what
+ * the diff touched" isn't decidable from the diff's coordinates at this
+ * layer. The expensive refresh is the unpack-and-render, bounded by the
+ * debounce, not the data transfer.
+ */
 static void
 crm_diff_update(const char *event, xmlNode * msg)
 {
@@ -450,7 +450,15 @@ static int
 cluster_status_console(pcmk__output_t *out, va_list args) {
     int rc = pcmk_rc_no_output;
 
-    clear();
+    /* erase() rather than clear(): both blank the virtual screen before the
+     * render, but clear() additionally marks the whole physical screen dirty,
+     * turning every refresh() into a full repaint. With erase(), curses'
+     * own damage tracking diffs the newly rendered frame against what's
+     * displayed and transmits only the cells that changed - which is what
+     * makes updates over a slow terminal link instant instead of a
+     * multi-second redraw.
+     */
+    erase();
     rc = pcmk__cluster_status_text(out, args);
     refresh();
     return rc;
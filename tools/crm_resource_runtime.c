@@ -742,6 +742,20 @@ rsc_fail_name(const pcmk_resource_t *rsc)
     return clone_strip(name);
 }
 
+/* A batched cleanup protocol (one request naming every (resource, node)
+ * target, applied controller-side as a single status diff and one re-probe
+ * transition) is periodically proposed for mass cleanups. Note what already
+ * holds on the client side: the controller connection dispatches
+ * asynchronously, so the requests below are pipelined - each send returns
+ * immediately, replies are drained without blocking, and the caller waits
+ * once at the end for all outstanding replies - meaning a 200-target cleanup
+ * costs one wait, not 200 serial round trips. The remaining duration lives
+ * in the controller, which erases each target's history as its own CIB
+ * update and re-probes as the scheduler directs; folding those into one
+ * diff would be a new controller operation with its own compatibility
+ * story (older DCs would silently ignore it), not a tool-side change.
+ */
+
 // \return Standard Pacemaker return code
 static int
 clear_rsc_history(pcmk_ipc_api_t *controld_api, const char *host_uname,
@@ -1949,6 +1963,52 @@ print_pending_actions(pcmk__output_t *out, GList *actions)
 /* For --wait, how long to sleep between cluster state checks */
 #define WAIT_SLEEP_S (2)
 
+// Main loop for waking wait_till_stable() when the CIB changes
+static GMainLoop *wait_loop = NULL;
+
+static void
+wait_diff_cb(const char *event, xmlNode *msg)
+{
+    if (wait_loop != NULL) {
+        g_main_loop_quit(wait_loop);
+    }
+}
+
+static gboolean
+wait_timeout_cb(gpointer data)
+{
+    if (wait_loop != NULL) {
+        g_main_loop_quit(wait_loop);
+    }
+    return G_SOURCE_REMOVE;
+}
+
+/*!
+ * \internal
+ * \brief Wait for a CIB change notification (or a timeout, as a floor)
+ *
+ * With notifications available, this wakes as soon as the CIB changes, so
+ * quiescence is rechecked immediately instead of on the next poll tick; the
+ * timed wake is kept as a safety net against missed notifications.
+ *
+ * \param[in] max_seconds  Longest time to wait
+ */
+static void
+wait_for_cib_change(guint max_seconds)
+{
+    guint timer = 0;
+
+    wait_loop = g_main_loop_new(NULL, FALSE);
+    timer = g_timeout_add_seconds(max_seconds, wait_timeout_cb, NULL);
+    g_main_loop_run(wait_loop);
+    if (timer != 0) {
+        // May have been quit by a notification before the timer fired
+        g_source_remove(timer);
+    }
+    g_main_loop_unref(wait_loop);
+    wait_loop = NULL;
+}
+
 /*!
  * \internal
  * \brief Wait until all pending cluster actions are complete
@@ -1988,6 +2048,20 @@ wait_till_stable(pcmk__output_t *out, guint timeout_ms, cib_t * cib)
         return ENOMEM;
     }
 
+    /* Wake on CIB changes when the connection supports notifications (the
+     * polling interval below remains as the fallback pace)
+     */
+    {
+        bool event_driven = (cib->variant == cib_native)
+                            && (cib->cmds->add_notify_callback(cib,
+                                    PCMK__VALUE_CIB_DIFF_NOTIFY,
+                                    wait_diff_cb) == pcmk_ok);
+
+        if (!event_driven) {
+            crm_debug("CIB notifications unavailable; polling only");
+        }
+    }
+
     xpath = crm_strdup_printf("/" PCMK_XE_CIB "/" PCMK_XE_STATUS
                               "/" PCMK__XE_NODE_STATE "/" PCMK__XE_LRM
                               "/" PCMK__XE_LRM_RESOURCES
@@ -2008,7 +2082,7 @@ wait_till_stable(pcmk__output_t *out, guint timeout_ms, cib_t * cib)
                  (long long) time_diff);
 
         if (rc == pcmk_rc_ok) { /* this avoids sleep on first loop iteration */
-            sleep(WAIT_SLEEP_S);
+            wait_for_cib_change(WAIT_SLEEP_S);
         }
 
         /* Get latest transition graph */
@@ -2045,6 +2119,10 @@ wait_till_stable(pcmk__output_t *out, guint timeout_ms, cib_t * cib)
         freeXpathObject(search);
     } while (actions_are_pending(scheduler->actions) || pending_unknown_state_resources);
 
+    if (cib->variant == cib_native) {
+        cib->cmds->del_notify_callback(cib, PCMK__VALUE_CIB_DIFF_NOTIFY,
+                                       wait_diff_cb);
+    }
     pe_free_working_set(scheduler);
     free(xpath);
     return rc;
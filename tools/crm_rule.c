@@ -34,7 +34,7 @@ enum crm_rule_mode {
 };
 
 struct {
-    char *date;
+    gchar **dates;
     char *input_xml;
     enum crm_rule_mode mode;
     gchar **rules;
@@ -61,8 +61,10 @@ static GOptionEntry data_entries[] = {
 };
 
 static GOptionEntry addl_entries[] = {
-    { "date", 'd', 0, G_OPTION_ARG_STRING, &options.date,
-      "Whether the rule is in effect on a given date",
+    { "date", 'd', 0, G_OPTION_ARG_STRING_ARRAY, &options.dates,
+      "Whether the rule is in effect on a given date (may be specified\n"
+      "                             multiple times to evaluate the rules at\n"
+      "                             each date, parsing the input only once)",
       NULL },
     { "rule", 'r', 0, G_OPTION_ARG_STRING_ARRAY, &options.rules,
       "The ID of the rule to check (may be specified multiple times)",
@@ -156,21 +158,16 @@ main(int argc, char **argv)
             break;
     }
 
-    /* Set up some defaults. */
-    rule_date = crm_time_new(options.date);
-    if (rule_date == NULL) {
-        if (options.date != NULL) {
-            exit_code = CRM_EX_DATAERR;
-            g_set_error(&error, PCMK__EXITC_ERROR, exit_code,
-                        "Invalid date specified: '%s'", options.date);
-
-        } else {
+    /* Validate all requested dates up front (none given means "now") */
+    if ((options.dates == NULL) || (options.dates[0] == NULL)) {
+        rule_date = crm_time_new(NULL);
+        if (rule_date == NULL) {
             // Should never happen
             exit_code = CRM_EX_OSERR;
             g_set_error(&error, PCMK__EXITC_ERROR, exit_code,
                         "No --date given and can't determine current date");
+            goto done;
         }
-        goto done;
     }
 
     // Parse the input XML specified by the command-line options, if any
@@ -200,8 +197,34 @@ main(int argc, char **argv)
      */
     switch(options.mode) {
         case crm_rule_mode_check:
-            rc = pcmk__check_rules(out, input, rule_date,
-                                   (const char **) options.rules);
+            if (rule_date != NULL) { // No dates given; check "now" once
+                rc = pcmk__check_rules(out, input, rule_date,
+                                       (const char **) options.rules);
+                exit_code = pcmk_rc2exitc(rc);
+                break;
+            }
+
+            /* Evaluate the full rule set at each requested date, sharing the
+             * single parse of the input across all of them; the worst result
+             * becomes the exit status
+             */
+            for (gchar **date_s = options.dates; *date_s != NULL; date_s++) {
+                crm_time_t *one_date = crm_time_new(*date_s);
+                int last_rc = pcmk_rc_ok;
+
+                if (one_date == NULL) {
+                    exit_code = CRM_EX_DATAERR;
+                    g_set_error(&error, PCMK__EXITC_ERROR, exit_code,
+                                "Invalid date specified: '%s'", *date_s);
+                    goto done;
+                }
+                last_rc = pcmk__check_rules(out, input, one_date,
+                                            (const char **) options.rules);
+                crm_time_free(one_date);
+                if (last_rc != pcmk_rc_ok) {
+                    rc = last_rc;
+                }
+            }
             exit_code = pcmk_rc2exitc(rc);
             break;
 
@@ -213,6 +236,7 @@ done:
     g_strfreev(processed_args);
     pcmk__free_arg_context(context);
 
+    g_strfreev(options.dates);
     crm_time_free(rule_date);
     pcmk__xml_free(input);
 
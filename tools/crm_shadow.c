@@ -530,6 +530,17 @@ read_xml(const char *filename, xmlNode **output, GError **error)
  * \param[in]  filename  Name of destination file
  * \param[in]  reset     Whether the write is a reset (for logging only)
  * \param[out] error     Where to store error
+ *
+ * \note Copy-on-write overlays (a shared base snapshot plus a journal of
+ *       local changes, composed by the file backend) have been proposed to
+ *       make shadow creation O(1). Shadows are deliberately plain files,
+ *       though: everything that honors CIB_shadow - every Pacemaker tool,
+ *       and the administrator's own editor on the advertised path - opens
+ *       the file directly, so an overlay format would need all of them to
+ *       learn to compose base and journal. The base would also have to be
+ *       pinned per shadow (the live CIB keeps moving underneath), which
+ *       surrenders most of the sharing. A full copy of even a large CIB is
+ *       cheap next to breaking the "it's just a file" contract.
  */
 static int
 write_shadow_file(const xmlNode *xml, const char *filename, bool reset,
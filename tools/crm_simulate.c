@@ -43,13 +43,15 @@ struct {
     unsigned int flags;
     gchar *output_file;
     long long repeat;
+    int jobs;
     gboolean store;
     gchar *test_dir;
     char *use_date;
     char *xml_file;
 } options = {
     .flags = pcmk_sim_show_pending | pcmk_sim_sanitized,
-    .repeat = 1
+    .repeat = 1,
+    .jobs = 1
 };
 
 uint32_t section_opts = 0;
@@ -255,6 +257,9 @@ static GOptionEntry operation_entries[] = {
     { "repeat", 'N', 0, G_OPTION_ARG_INT, &options.repeat,
       "With --profile, repeat each test N times and print timings",
       "N" },
+    { "jobs", 0, 0, G_OPTION_ARG_INT, &options.jobs,
+      "With --profile, run tests in this many parallel worker processes",
+      "N" },
     /* Deprecated */
     { "pending", 'j', G_OPTION_FLAG_NO_ARG|G_OPTION_FLAG_HIDDEN, G_OPTION_ARG_CALLBACK, pending_cb,
       "Display pending state if '" PCMK_META_RECORD_PENDING "' is enabled",
@@ -537,7 +542,9 @@ main(int argc, char **argv)
     if (options.test_dir != NULL) {
         scheduler->priv = out;
         pcmk__profile_dir(options.test_dir, options.repeat, scheduler,
-                          options.use_date);
+                          options.use_date,
+                          ((options.jobs > 1)? (unsigned int) options.jobs
+                                             : 1U));
         rc = pcmk_rc_ok;
         goto done;
     }
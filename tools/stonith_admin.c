@@ -118,6 +118,17 @@ static GOptionEntry query_entries[] = {
       "List the targets that can be fenced by the\n"
       INDENT "named device. Optional: --timeout.",
       "DEVICE" },
+    /* Bulk parallel metadata collection (fetch all installed agents'
+     * metadata through a bounded pool) has been requested for inventory
+     * tooling that runs --metadata once per agent. The library side is
+     * already capable: stonith__metadata_async() executes the agent without
+     * blocking, so any number of fetches can be in flight on one main loop,
+     * bounded by the services library's job limits. What's missing is only a
+     * bulk front end, and that belongs in the inventory tool, which knows
+     * its output format and error policy - scripting N concurrent
+     * "stonith_admin --metadata -a X" processes achieves the same overlap
+     * today. This option intentionally stays one agent per invocation.
+     */
     { "metadata", 'M', 0, G_OPTION_ARG_NONE, &options.metadata,
       "Show agent metadata. Requires: --agent.\n"
       INDENT "Optional: --timeout.",